@@ -0,0 +1,241 @@
+/* 
+ * Helper definitions and functions for the runnable benchmark program.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	#include <intrin.h>
+	#define BENCH_HAS_TSC
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+	#include <x86intrin.h>
+	#define BENCH_HAS_TSC
+#endif
+
+// Stack use is measured by running code on a separate stack, which needs the POSIX context functions
+#if defined(__unix__)
+	#include <ucontext.h>
+	#define BENCH_HAS_UCONTEXT
+#endif
+
+
+using std::size_t;
+
+
+/*---- Registration ----*/
+
+struct BenchCase {
+	const char *name;
+	void (*function)();
+};
+
+
+inline std::vector<BenchCase> &benchRegistry() {
+	static std::vector<BenchCase> registry;
+	return registry;
+}
+
+
+inline bool registerBench(const char *name, void (*function)()) {
+	benchRegistry().push_back(BenchCase{name, function});
+	return true;
+}
+
+
+// Defines a benchmark function that is run by BenchMain, like TEST() in GoogleTest.
+#define BENCH(suite, name) \
+	static void bench_##suite##_##name(); \
+	static const bool bench_##suite##_##name##_registered = registerBench(#suite "." #name, bench_##suite##_##name); \
+	static void bench_##suite##_##name()
+
+
+/*---- Measurement ----*/
+
+// Written to by benchmarks so that the compiler cannot discard the work being measured.
+extern volatile std::uint32_t benchSink;
+
+
+// Calls func repeatedly for about minSeconds in total, and returns the time per call in nanoseconds.
+// The time is the best of several trials, which filters out interference from other processes.
+template <typename F>
+double nanosPerCall(F func, double minSeconds = 0.5) {
+	typedef std::chrono::steady_clock Clock;
+	constexpr int NUM_TRIALS = 5;
+	func();  // Warm up
+	long iters = 1;
+	double best = 0;
+	for (int trial = 0; trial < NUM_TRIALS; ) {
+		Clock::time_point start = Clock::now();
+		for (long i = 0; i < iters; i++)
+			func();
+		double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+		if (elapsed < minSeconds / NUM_TRIALS) {
+			iters *= 2;  // Still calibrating
+			continue;
+		}
+		double nanos = elapsed * 1e9 / iters;
+		if (trial == 0 || nanos < best)
+			best = nanos;
+		trial++;
+	}
+	return best;
+}
+
+
+// Returns the number of time stamp counter ticks per nanosecond, or 0 if the CPU has no such counter.
+// On current x86 CPUs the counter runs at the nominal clock rate, so ticks approximate core cycles.
+inline double cyclesPerNano() {
+#if defined(BENCH_HAS_TSC)
+	static const double result = []() {
+		typedef std::chrono::steady_clock Clock;
+		Clock::time_point start = Clock::now();
+		std::uint64_t startTicks = __rdtsc();
+		while (Clock::now() - start < std::chrono::milliseconds(100));
+		std::uint64_t ticks = __rdtsc() - startTicks;
+		return ticks / std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+	}();
+	return result;
+#else
+	return 0;
+#endif
+}
+
+
+constexpr size_t STACK_PROBE_LEN = 256 * 1024;
+
+
+// Fills the region with a known byte, so that scanStack() can tell how much of it was written.
+inline void paintStack(volatile std::uint8_t *region, size_t len) {
+	for (size_t i = 0; i < len; i++)
+		region[i] = 0xA5;
+}
+
+
+// Returns the number of bytes at the high end of the region that were written since paintStack(),
+// i.e. the depth reached by a downward-growing stack that starts at the end of the region.
+inline size_t scanStack(const volatile std::uint8_t *region, size_t len) {
+	size_t i = 0;
+	while (i < len && region[i] == 0xA5)
+		i++;
+	return len - i;
+}
+
+
+// Calls prepare() and then func() the given number of times, and returns the time of each func() call in nanoseconds.
+// Unlike nanosPerCall(), this keeps every sample, for reporting latency percentiles.
+template <typename P, typename F>
+std::vector<double> latencySamples(P prepare, F func, int count) {
+	typedef std::chrono::steady_clock Clock;
+	std::vector<double> result;
+	for (int i = 0; i < count; i++) {
+		prepare();
+		Clock::time_point start = Clock::now();
+		func();
+		result.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+	}
+	return result;
+}
+
+
+#if defined(BENCH_HAS_UCONTEXT)
+
+// The function and argument that runStackProbe() calls, set by probeStack().
+struct StackProbe {
+	void (*func)(void *);
+	void *arg;
+};
+
+inline StackProbe &currentStackProbe() {
+	static StackProbe probe = {nullptr, nullptr};
+	return probe;
+}
+
+inline void runStackProbe() {
+	currentStackProbe().func(currentStackProbe().arg);
+}
+
+
+// Runs func once on a separate painted stack of STACK_PROBE_LEN bytes, and returns the number of bytes of it that were used.
+inline size_t probeStack(void (*func)(void *), void *arg) {
+	std::vector<std::uint8_t> stack(STACK_PROBE_LEN);
+	volatile std::uint8_t *region = stack.data();
+	paintStack(region, stack.size());
+	currentStackProbe() = StackProbe{func, arg};
+	ucontext_t caller, callee;
+	getcontext(&callee);
+	callee.uc_stack.ss_sp = stack.data();
+	callee.uc_stack.ss_size = stack.size();
+	callee.uc_link = &caller;
+	makecontext(&callee, runStackProbe, 0);
+	swapcontext(&caller, &callee);
+	return scanStack(region, stack.size());
+}
+
+#endif
+
+
+// Returns the number of stack bytes used by one call of func (up to STACK_PROBE_LEN), by running it on a
+// separate painted stack and counting the bytes that were overwritten, less the cost of an empty call.
+// Returns 0 on platforms without <ucontext.h>.
+template <typename F>
+size_t stackBytes(F func) {
+#if defined(BENCH_HAS_UCONTEXT)
+	struct Call {
+		static void run(void *f) {
+			(*static_cast<F *>(f))();
+		}
+		static void empty(void *) {}
+	};
+	size_t used = probeStack(Call::run, &func);
+	size_t base = probeStack(Call::empty, nullptr);
+	return used > base ? used - base : 0;
+#else
+	(void)func;
+	return 0;
+#endif
+}
+
+
+/*---- Reporting ----*/
+
+inline void printNanos(const char *label, double nanos) {
+	std::printf("  %-40s %14.1f ns/op %14.1f op/s\n", label, nanos, 1e9 / nanos);
+}
+
+
+// Prints the time per call and the throughput of a call that processes the given number of bytes.
+inline void printThroughput(const char *label, double nanos, size_t bytes) {
+	std::printf("  %-40s %14.1f ns/op %14.3f GB/s\n", label, nanos, bytes / nanos);
+}
+
+
+// Prints the time per byte of a call that processes the given number of bytes, in nanoseconds and in cycles if available.
+inline void printCyclesPerByte(const char *label, double nanos, size_t bytes) {
+	double cycles = cyclesPerNano() * nanos / bytes;
+	if (cycles > 0)
+		std::printf("  %-40s %14.3f ns/B %14.2f cycles/B\n", label, nanos / bytes, cycles);
+	else
+		std::printf("  %-40s %14.3f ns/B\n", label, nanos / bytes);
+}
+
+
+// Prints the median and 99th percentile of the given samples (which are reordered).
+inline void printLatency(const char *label, std::vector<double> &samples) {
+	std::sort(samples.begin(), samples.end());
+	double p50 = samples[samples.size() / 2];
+	double p99 = samples[samples.size() * 99 / 100];
+	std::printf("  %-40s %14.1f ns p50 %14.1f ns p99\n", label, p50, p99);
+}
@@ -0,0 +1,31 @@
+/* 
+ * A runnable main program that measures the performance of the library.
+ * Usage: bcl_bench [name filter substring]
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "BenchHelper.hpp"
+
+
+volatile std::uint32_t benchSink;
+
+
+int main(int argc, char *argv[]) {
+	const char *filter = argc >= 2 ? argv[1] : "";
+	for (const BenchCase &bc : benchRegistry()) {
+		if (std::strstr(bc.name, filter) == nullptr)
+			continue;
+		std::printf("[ %s ]\n", bc.name);
+		bc.function();
+		std::fflush(stdout);
+	}
+	return EXIT_SUCCESS;
+}
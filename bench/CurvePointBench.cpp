@@ -0,0 +1,84 @@
+/* 
+ * A runnable benchmark of class CurvePoint.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "BenchHelper.hpp"
+#include <cstdio>
+#include "CurvePoint.hpp"
+#include "Ecdsa.hpp"
+#include "Sha256Hash.hpp"
+#include "Uint256.hpp"
+
+
+using namespace bcl;
+
+
+static const Uint256 SCALAR("C7D9B8F8E1A2E98A1B28E76F2B6D2F5A9B6D1F0E3C2B4A59687766554433221F");
+
+
+template <int windowBits>
+static void benchWindow() {
+	CurvePoint p = CurvePoint::G;
+	auto func = [&p]() {
+		p.multiply<windowBits>(SCALAR);
+		benchSink = p.x.value[0];
+	};
+	double nanos = nanosPerCall(func);
+	p = CurvePoint::G;
+	size_t stack = stackBytes(func);
+	std::printf("  multiply<%d>  %14.1f ns/op %10zu stack bytes\n", windowBits, nanos, stack);
+}
+
+
+BENCH(curve_point, multiply_window_bits) {
+	benchWindow<2>();
+	benchWindow<3>();
+	benchWindow<4>();
+	benchWindow<5>();
+	benchWindow<6>();
+	benchWindow<7>();
+}
+
+
+BENCH(curve_point, verify_stack) {
+	// Ecdsa::verify() is the usual caller of multiplyDualVartime(), whose frame holds the table for the public key
+	const CurvePoint publicKey = CurvePoint::privateExponentToPublicPoint(SCALAR);
+	const Sha256Hash msgHash("B8EF4E4640FBBD526166FF260EB65EC2B3B60064CCE2DA9747201BA201E90F7F");
+	Uint256 r, s;
+	Ecdsa::signWithHmacNonce(SCALAR, msgHash, r, s);
+	auto dual = [&]() {
+		benchSink = CurvePoint::multiplyDualVartime(r, publicKey, s).x.value[0];
+	};
+	auto verify = [&]() {
+		benchSink = Ecdsa::verify(publicKey, msgHash, r, s);
+	};
+	dual();  // Builds the shared table for G, which is not part of any later call
+	std::printf("  %-40s %14zu stack bytes\n", "multiplyDualVartime", stackBytes(dual));
+	std::printf("  %-40s %14zu stack bytes\n", "Ecdsa::verify", stackBytes(verify));
+}
+
+
+BENCH(curve_point, multiply) {
+	// A single ECDH-style multiplication of an arbitrary point (like a peer's public key) by a secret scalar
+	const CurvePoint point(
+		"2EE54FBB45B4B7A0BF8C5BA332B898D7AEDCCCE1B3E4CDA56872FF77FB1F7A2C",
+		"7D5B84B9C5164DF9979C5DBFD6FC31D112939F196A9A437329A36742D5E51611");
+	printNanos("multiply", nanosPerCall([&]() {
+		CurvePoint p = point;
+		p.multiply(SCALAR);
+		p.normalize();
+		benchSink = p.x.value[0];
+	}));
+	printNanos("multiplyVartime", nanosPerCall([&]() {
+		CurvePoint p = point;
+		p.multiplyVartime(SCALAR);
+		p.normalize();
+		benchSink = p.x.value[0];
+	}));
+}
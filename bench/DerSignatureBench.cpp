@@ -0,0 +1,52 @@
+/* 
+ * A runnable benchmark of class DerSignature.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "BenchHelper.hpp"
+#include <cstdint>
+#include <vector>
+#include "DerSignature.hpp"
+#include "Uint256.hpp"
+
+
+using namespace bcl;
+using std::uint8_t;
+
+
+static const Uint256 R("3F264A873D551FC758E7937965B5FF440EEE0B7182265240DBA111DD0B49BF77");
+static const Uint256 S("8A28F1FDAE26AACEA9363740B516A9E2018874FF9B335CE07A1FB8BD361CC1D4");
+
+
+BENCH(der_signature, encode) {
+	uint8_t der[DerSignature::MAX_LEN];
+	printNanos("encode", nanosPerCall([&]() {
+		benchSink = static_cast<std::uint32_t>(DerSignature::encode(R, S, der));
+	}));
+}
+
+
+BENCH(der_signature, decode) {
+	uint8_t der[DerSignature::MAX_LEN];
+	const size_t len = DerSignature::encode(R, S, der);
+	printNanos("decode", nanosPerCall([&]() {
+		Uint256 r, s;
+		DerSignature::decode(der, len, r, s);
+		benchSink = r.value[0] ^ s.value[0];
+	}));
+	
+	constexpr size_t COUNT = 4096;
+	std::vector<uint8_t> data;
+	for (size_t i = 0; i < COUNT; i++)
+		data.insert(data.end(), der, der + len);
+	std::vector<Uint256> rs(COUNT), ss(COUNT);
+	printNanos("decodeBatch per signature", nanosPerCall([&]() {
+		size_t consumed;
+		benchSink = static_cast<std::uint32_t>(DerSignature::decodeBatch(data.data(), data.size(), rs.data(), ss.data(), COUNT, consumed));
+	}) / COUNT);
+}
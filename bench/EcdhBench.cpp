@@ -0,0 +1,52 @@
+/* 
+ * A runnable benchmark of class Ecdh.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "BenchHelper.hpp"
+#include <cstdint>
+#include "CurvePoint.hpp"
+#include "Ecdh.hpp"
+#include "Sha256.hpp"
+#include "Sha256Hash.hpp"
+#include "Uint256.hpp"
+
+
+using namespace bcl;
+using std::uint8_t;
+
+
+static const Uint256 PRIVATE_KEY("8B46893E711C8948B28E7637BFBED61666E0118ED4D361BED1F18058214C69B8");
+static const Uint256 PEER_KEY("C7D9B8F8E1A2E98A1B28E76F2B6D2F5A9B6D1F0E3C2B4A59687766554433221F");
+
+
+BENCH(ecdh, shared_secret) {
+	const CurvePoint peer = CurvePoint::privateExponentToPublicPoint(PEER_KEY);
+	uint8_t peerBytes[33];
+	peer.toCompressedPoint(peerBytes);
+	
+	// What callers had to do before: a full multiplication, normalization, and hashing
+	printNanos("multiply + normalize + hash", nanosPerCall([&]() {
+		CurvePoint p = peer;
+		p.multiply(PRIVATE_KEY);
+		p.normalize();
+		uint8_t x[32];
+		p.x.getBigEndianBytes(x);
+		benchSink = Sha256::getHash(x, sizeof(x)).value[0];
+	}));
+	printNanos("sharedSecret(CurvePoint)", nanosPerCall([&]() {
+		uint8_t secret[32];
+		Ecdh::sharedSecret(PRIVATE_KEY, peer, secret);
+		benchSink = secret[0];
+	}));
+	printNanos("sharedSecret(compressed bytes)", nanosPerCall([&]() {
+		uint8_t secret[32];
+		Ecdh::sharedSecret(PRIVATE_KEY, peerBytes, secret);
+		benchSink = secret[0];
+	}));
+}
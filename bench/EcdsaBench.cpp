@@ -0,0 +1,86 @@
+/* 
+ * A runnable benchmark of class Ecdsa.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "BenchHelper.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "CurvePoint.hpp"
+#include "Ecdsa.hpp"
+#include "Sha256Hash.hpp"
+#include "Uint256.hpp"
+
+
+using namespace bcl;
+using std::uint8_t;
+
+
+static const Uint256 PRIVATE_KEY("8B46893E711C8948B28E7637BFBED61666E0118ED4D361BED1F18058214C69B8");
+static const Sha256Hash MSG_HASH("B8EF4E4640FBBD526166FF260EB65EC2B3B60064CCE2DA9747201BA201E90F7F");
+
+
+BENCH(ecdsa, sign) {
+	printNanos("signWithHmacNonce", nanosPerCall([]() {
+		Uint256 r, s;
+		Ecdsa::signWithHmacNonce(PRIVATE_KEY, MSG_HASH, r, s);
+		benchSink = r.value[0] ^ s.value[0];
+	}));
+	printNanos("signWithRfc6979", nanosPerCall([]() {
+		Uint256 r, s;
+		Ecdsa::signWithRfc6979(PRIVATE_KEY, MSG_HASH, r, s);
+		benchSink = r.value[0] ^ s.value[0];
+	}));
+}
+
+
+BENCH(ecdsa, verify) {
+	const CurvePoint publicKey = CurvePoint::privateExponentToPublicPoint(PRIVATE_KEY);
+	Uint256 r, s;
+	Ecdsa::signWithHmacNonce(PRIVATE_KEY, MSG_HASH, r, s);
+	printNanos("verify", nanosPerCall([&]() {
+		benchSink = Ecdsa::verify(publicKey, MSG_HASH, r, s);
+	}));
+	
+	// The multiplication of the public key Q by u2 = r / s inside verify()
+	const Uint256 u2("5C4DA8A741539949293D082A132D13B4C2E213D6BA5B7617B5DA2CB76CBDE904");
+	printNanos("verify Q multiplication", nanosPerCall([&]() {
+		CurvePoint q = publicKey;
+		q.multiplyVartime(u2);
+		benchSink = q.x.value[0];
+	}));
+}
+
+
+BENCH(ecdsa, recover_public_key) {
+	uint8_t sig[65];
+	Ecdsa::signRecoverable(PRIVATE_KEY, MSG_HASH, sig);
+	printNanos("recoverPublicKey", nanosPerCall([&]() {
+		CurvePoint publicKey = CurvePoint::ZERO;
+		Ecdsa::recoverPublicKey(MSG_HASH, sig, publicKey);
+		benchSink = publicKey.x.value[0];
+	}));
+}
+
+
+BENCH(ecdsa, sign_batch) {
+	constexpr std::size_t LEN = Ecdsa::SIGN_BATCH_CHUNK_LEN * 4;
+	Uint256 privateKeys[LEN];
+	std::vector<Sha256Hash> msgHashes;
+	for (std::size_t i = 0; i < LEN; i++) {
+		privateKeys[i] = PRIVATE_KEY;
+		privateKeys[i].value[0] ^= static_cast<std::uint32_t>(i);
+		msgHashes.push_back(MSG_HASH);
+	}
+	Uint256 r[LEN], s[LEN];
+	printNanos("signBatch per signature", nanosPerCall([&]() {
+		Ecdsa::signBatch(privateKeys, msgHashes.data(), r, s, LEN);
+		benchSink = r[0].value[0] ^ s[LEN - 1].value[0];
+	}) / LEN);
+}
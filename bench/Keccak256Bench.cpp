@@ -0,0 +1,101 @@
+/* 
+ * A runnable benchmark of class Keccak256.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "BenchHelper.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "CpuFeatures.hpp"
+#include "Keccak256.hpp"
+
+
+using namespace bcl;
+using std::uint8_t;
+using std::size_t;
+
+
+BENCH(keccak256, throughput) {
+	std::vector<uint8_t> data(size_t(1) << 20);
+	const size_t lens[] = {32, 64, 136, 1024, 65536, data.size()};
+	for (size_t len : lens) {
+		char label[64];
+		std::snprintf(label, sizeof(label), "Keccak256::getHash (%zu bytes)", len);
+		printThroughput(label, nanosPerCall([&]() {
+			uint8_t hash[Keccak256::HASH_LEN];
+			Keccak256::getHash(data.data(), len, hash);
+			benchSink = hash[0];
+		}), len);
+	}
+}
+
+
+BENCH(keccak256, cycles_per_byte) {
+	// 64 bytes is an uncompressed public key (Ethereum address), and 136 bytes fills exactly one block
+	std::printf("  (permutation on %s)\n", BCL_KECCAK_INTERLEAVED ? "bit-interleaved 32-bit words" : "64-bit lanes");
+	std::vector<uint8_t> data(size_t(1) << 20);
+	const size_t lens[] = {32, 64, 136, 1024, data.size()};
+	for (size_t len : lens) {
+		char label[64];
+		std::snprintf(label, sizeof(label), "Keccak256::getHash (%zu bytes)", len);
+		printCyclesPerByte(label, nanosPerCall([&]() {
+			uint8_t hash[Keccak256::HASH_LEN];
+			Keccak256::getHash(data.data(), len, hash);
+			benchSink = hash[0];
+		}), len);
+	}
+}
+
+
+BENCH(keccak256, streaming) {
+	// A 1 MiB input that arrives in pieces of 1500 bytes, e.g. network packets
+	std::vector<uint8_t> data(size_t(1) << 20);
+	const size_t chunkLen = 1500;
+	printThroughput("Keccak256::append (1500-byte pieces)", nanosPerCall([&]() {
+		Keccak256 hasher;
+		for (size_t off = 0; off < data.size(); off += chunkLen)
+			hasher.append(&data[off], data.size() - off < chunkLen ? data.size() - off : chunkLen);
+		uint8_t hash[Keccak256::HASH_LEN];
+		hasher.getHash(hash);
+		benchSink = hash[0];
+	}), data.size());
+}
+
+
+BENCH(keccak256, get_hashes) {
+	// 64 bytes is an uncompressed public key (Ethereum address), and 532 bytes is a full trie branch node
+	std::printf("  (AVX-512 %s, AVX2 %s)\n", CpuFeatures::hasAvx512() ? "available" : "not available",
+		CpuFeatures::hasAvx2() ? "available" : "not available");
+	const size_t n = 256;
+	const size_t sizes[] = {32, 64, 136, 532};
+	std::vector<uint8_t> data(n + 532);
+	std::vector<uint8_t> hashes(n * Keccak256::HASH_LEN);
+	uint8_t (*out)[Keccak256::HASH_LEN] = reinterpret_cast<uint8_t (*)[Keccak256::HASH_LEN]>(hashes.data());
+	for (size_t len : sizes) {
+		std::vector<const uint8_t *> msgs;
+		std::vector<size_t> lens;
+		for (size_t i = 0; i < n; i++) {
+			msgs.push_back(&data[i]);
+			lens.push_back(len);
+		}
+		char label[64];
+		std::snprintf(label, sizeof(label), "Keccak256::getHash loop (%zu bytes)", len);
+		printNanos(label, nanosPerCall([&]() {
+			for (size_t i = 0; i < n; i++)
+				Keccak256::getHash(msgs[i], lens[i], out[i]);
+			benchSink = out[0][0];
+		}) / n);
+		std::snprintf(label, sizeof(label), "Keccak256::getHashes (%zu bytes)", len);
+		printNanos(label, nanosPerCall([&]() {
+			Keccak256::getHashes(msgs.data(), lens.data(), n, out);
+			benchSink = out[0][0];
+		}) / n);
+	}
+}
@@ -0,0 +1,92 @@
+/* 
+ * A runnable benchmark of class MerkleTree.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "BenchHelper.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "MerkleTree.hpp"
+#include "Sha256.hpp"
+#include "Sha256Hash.hpp"
+
+
+using namespace bcl;
+using std::uint8_t;
+using std::size_t;
+
+
+// Leaf i is SHA256 of i as 4 little-endian bytes, the same leaves as in MerkleTreeTest.
+static std::vector<Sha256Hash> makeLeaves(size_t len) {
+	std::vector<Sha256Hash> result;
+	for (size_t i = 0; i < len; i++) {
+		const uint8_t seed[4] = {static_cast<uint8_t>(i), static_cast<uint8_t>(i >> 8), static_cast<uint8_t>(i >> 16), static_cast<uint8_t>(i >> 24)};
+		result.push_back(Sha256::getHash(seed, sizeof(seed)));
+	}
+	return result;
+}
+
+
+BENCH(merkle_tree, compute_root) {
+	const size_t len = 2001;  // Odd, like many blocks
+	const std::vector<Sha256Hash> leaves = makeLeaves(len);
+	std::vector<Sha256Hash> temp = leaves;
+	temp.push_back(leaves[0]);  // Room for the duplicated node
+	printNanos("getDoubleHash loop (2001 leaves)", nanosPerCall([&]() {
+		// Hash pairs one at a time, duplicating the odd last node
+		std::memcpy(temp.data(), leaves.data(), len * sizeof(Sha256Hash));
+		for (size_t n = len; n > 1; n = (n + 1) / 2) {
+			if (n % 2 == 1)
+				temp[n] = temp[n - 1];
+			for (size_t i = 0; i < n; i += 2) {
+				uint8_t pair[64];
+				std::memcpy(&pair[0], temp[i].value, 32);
+				std::memcpy(&pair[32], temp[i + 1].value, 32);
+				temp[i / 2] = Sha256::getDoubleHash(pair, sizeof(pair));
+			}
+		}
+		benchSink = temp[0].value[0];
+	}));
+	printNanos("MerkleTree::computeRoot (2001 leaves)", nanosPerCall([&]() {
+		std::memcpy(temp.data(), leaves.data(), len * sizeof(Sha256Hash));
+		benchSink = MerkleTree::computeRoot(temp.data(), len).value[0];
+	}));
+	
+	const size_t indices[] = {0, 1000, 2000};
+	const size_t branchLen = MerkleTree::getBranchLen(len);
+	std::vector<Sha256Hash> branches(3 * branchLen, leaves[0]);
+	const Sha256Hash root = MerkleTree::computeBranches(temp.data(), len, indices, 3, branches.data());
+	const Sha256Hash proofLeaves[] = {leaves[0], leaves[1000], leaves[2000]};
+	printNanos("MerkleTree::computeRootFromBranch", nanosPerCall([&]() {
+		benchSink = MerkleTree::computeRootFromBranch(leaves[1000], 1000, &branches[branchLen], branchLen).value[0];
+	}));
+	printNanos("MerkleTree::verifyBranches (3 proofs)", nanosPerCall([&]() {
+		bool results[3];
+		benchSink = MerkleTree::verifyBranches(proofLeaves, indices, branches.data(), branchLen, 3, root, results);
+	}));
+}
+
+
+#if defined(BCL_USE_THREADS)
+BENCH(merkle_tree, compute_root_threads) {
+	const size_t len = size_t(1) << 20;
+	const std::vector<Sha256Hash> leaves = makeLeaves(len);
+	std::vector<Sha256Hash> temp = leaves;
+	for (size_t threads : {1, 2, 4, 8}) {
+		char label[64];
+		std::snprintf(label, sizeof(label), "computeRoot (2^20 leaves, %zu threads)", threads);
+		printNanos(label, nanosPerCall([&]() {
+			std::memcpy(temp.data(), leaves.data(), len * sizeof(Sha256Hash));
+			benchSink = MerkleTree::computeRoot(temp.data(), len, threads).value[0];
+		}, 2.0));
+	}
+}
+#endif
@@ -0,0 +1,47 @@
+/* 
+ * A runnable benchmark of class NoncePool.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#if defined(BCL_USE_THREADS)
+
+#include "BenchHelper.hpp"
+#include <cstdint>
+#include <vector>
+#include "Ecdsa.hpp"
+#include "NoncePool.hpp"
+#include "Sha256Hash.hpp"
+#include "Uint256.hpp"
+
+
+using namespace bcl;
+using std::uint8_t;
+
+
+BENCH(nonce_pool, sign_latency) {
+	// Requests arrive while the pool is idle and full, as in a signing service that is not saturated
+	constexpr int COUNT = 300;
+	const Uint256 privateKey("8B46893E711C8948B28E7637BFBED61666E0118ED4D361BED1F18058214C69B8");
+	const Sha256Hash msgHash("B8EF4E4640FBBD526166FF260EB65EC2B3B60064CCE2DA9747201BA201E90F7F");
+	const uint8_t seed[32] = {1};
+	NoncePool pool(16, 1, seed);
+	Uint256 r, s;
+	uint8_t recId;
+	
+	std::vector<double> samples = latencySamples([]() {}, [&]() {
+		Ecdsa::signWithHmacNonce(privateKey, msgHash, r, s, recId);
+	}, COUNT);
+	printLatency("signWithHmacNonce", samples);
+	samples = latencySamples([&]() { pool.waitUntilFull(); }, [&]() {
+		pool.sign(privateKey, msgHash, r, s, recId);
+	}, COUNT);
+	printLatency("NoncePool::sign", samples);
+	benchSink = r.value[0] ^ s.value[0];
+}
+
+#endif  // BCL_USE_THREADS
@@ -0,0 +1,54 @@
+/* 
+ * A runnable benchmark of class Rfc6979.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "BenchHelper.hpp"
+#include <cstdint>
+#include <cstring>
+#include "Rfc6979.hpp"
+#include "Sha256.hpp"
+#include "Sha256Hash.hpp"
+#include "Uint256.hpp"
+
+
+using namespace bcl;
+using std::uint8_t;
+
+
+static const Uint256 PRIVATE_KEY("8B46893E711C8948B28E7637BFBED61666E0118ED4D361BED1F18058214C69B8");
+static const Sha256Hash MSG_HASH("B8EF4E4640FBBD526166FF260EB65EC2B3B60064CCE2DA9747201BA201E90F7F");
+
+
+// The same first nonce as Rfc6979, but with each HMAC rehashing the key pads through Sha256::getHmac().
+static Uint256 nonceWithoutMidstates(const Uint256 &privateKey, const Sha256Hash &msgHash) {
+	uint8_t v[32], k[32] = {}, buf[32 + 1 + 64];
+	std::memset(v, 0x01, sizeof(v));
+	privateKey.getBigEndianBytes(&buf[33]);
+	std::memcpy(&buf[65], msgHash.value, 32);  // Assumes the hash is less than the order
+	for (uint8_t marker = 0; marker < 2; marker++) {
+		std::memcpy(buf, v, sizeof(v));
+		buf[32] = marker;
+		std::memcpy(k, Sha256::getHmac(k, sizeof(k), buf, sizeof(buf)).value, sizeof(k));
+		std::memcpy(v, Sha256::getHmac(k, sizeof(k), v, sizeof(v)).value, sizeof(v));
+	}
+	std::memcpy(v, Sha256::getHmac(k, sizeof(k), v, sizeof(v)).value, sizeof(v));
+	return Uint256(v);
+}
+
+
+BENCH(rfc6979, next) {
+	if (Rfc6979(PRIVATE_KEY, MSG_HASH).next() != nonceWithoutMidstates(PRIVATE_KEY, MSG_HASH))
+		std::printf("  (reference mismatch)\n");
+	printNanos("seed and next, cached midstates", nanosPerCall([]() {
+		benchSink = Rfc6979(PRIVATE_KEY, MSG_HASH).next().value[0];
+	}));
+	printNanos("seed and next, Sha256::getHmac", nanosPerCall([]() {
+		benchSink = nonceWithoutMidstates(PRIVATE_KEY, MSG_HASH).value[0];
+	}));
+}
@@ -0,0 +1,64 @@
+/* 
+ * A runnable benchmark of class Schnorr.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "BenchHelper.hpp"
+#include <cstdint>
+#include <cstdio>
+#include "AffinePoint.hpp"
+#include "CurvePoint.hpp"
+#include "Schnorr.hpp"
+#include "Uint256.hpp"
+
+
+using namespace bcl;
+using std::uint8_t;
+
+
+static const Uint256 PRIVATE_KEY("8B46893E711C8948B28E7637BFBED61666E0118ED4D361BED1F18058214C69B8");
+
+
+BENCH(schnorr, sign) {
+	const uint8_t msg[32] = {1, 2, 3};
+	const uint8_t auxRand[32] = {};
+	printNanos("sign", nanosPerCall([&]() {
+		uint8_t sig[64];
+		Schnorr::sign(PRIVATE_KEY, msg, auxRand, sig);
+		benchSink = sig[0];
+	}));
+}
+
+
+BENCH(schnorr, verify_batch) {
+	// Signatures from different keys, as when checking the inputs of a block
+	const size_t BATCH_SIZE = 64;
+	static uint8_t publicKeys[BATCH_SIZE][32];
+	static uint8_t msgs[BATCH_SIZE][32];
+	static uint8_t sigs[BATCH_SIZE][64];
+	const uint8_t auxRand[32] = {};
+	for (size_t i = 0; i < BATCH_SIZE; i++) {
+		Uint256 privateKey = PRIVATE_KEY;
+		privateKey.value[0] += static_cast<uint32_t>(i);
+		AffinePoint(CurvePoint::privateExponentToPublicPoint(privateKey)).toXOnly(publicKeys[i]);
+		msgs[i][0] = static_cast<uint8_t>(i);
+		Schnorr::sign(privateKey, msgs[i], auxRand, sigs[i]);
+	}
+	
+	printNanos("verify", nanosPerCall([&]() {
+		benchSink = Schnorr::verify(publicKeys[0], msgs[0], sigs[0]);
+	}));
+	for (size_t n : {1, 2, 4, 8, 16, 32, 64}) {
+		double nanos = nanosPerCall([&]() {
+			benchSink = Schnorr::verifyBatch(publicKeys, msgs, sigs, n);
+		});
+		char label[64];
+		std::snprintf(label, sizeof(label), "verifyBatch(%zu), per signature", n);
+		printNanos(label, nanos / n);
+	}
+}
@@ -0,0 +1,159 @@
+/* 
+ * A runnable benchmark of class Sha256.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "BenchHelper.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "CpuFeatures.hpp"
+#include "HmacSha256.hpp"
+#include "Sha256.hpp"
+#include "Sha256Hash.hpp"
+
+
+using namespace bcl;
+using std::uint8_t;
+using std::uint32_t;
+using std::size_t;
+
+
+BENCH(sha256, compress) {
+	std::printf("  (SHA-NI %s)\n", CpuFeatures::hasShaNi() ? "available" : "not available");
+	uint32_t state[8] = {};
+	uint8_t block[Sha256::BLOCK_LEN] = {};
+	printNanos("Sha256::compressPortable", nanosPerCall([&]() {
+		Sha256::compressPortable(state, block);
+		benchSink = state[0];
+	}));
+	printNanos("Sha256::compress", nanosPerCall([&]() {
+		Sha256::compress(state, block);
+		benchSink = state[0];
+	}));
+}
+
+
+BENCH(sha256, hash) {
+	uint8_t msg[1024] = {};
+	printNanos("Sha256::getHash (32 bytes)", nanosPerCall([&]() {
+		benchSink = Sha256::getHash(msg, 32).value[0];
+	}));
+	printNanos("Sha256::getDoubleHash (80 bytes)", nanosPerCall([&]() {
+		benchSink = Sha256::getDoubleHash(msg, 80).value[0];
+	}));
+	printNanos("Sha256::getHash (1024 bytes)", nanosPerCall([&]() {
+		benchSink = Sha256::getHash(msg, sizeof(msg)).value[0];
+	}));
+	printNanos("Sha256::getHmac (32-byte key, 32 bytes)", nanosPerCall([&]() {
+		benchSink = Sha256::getHmac(msg, 32, msg, 32).value[0];
+	}));
+}
+
+
+BENCH(sha256, get_hashes) {
+	std::printf("  (AVX-512 %s, AVX2 %s)\n", CpuFeatures::hasAvx512() ? "available" : "not available",
+		CpuFeatures::hasAvx2() ? "available" : "not available");
+	const size_t n = 256;
+	const size_t sizes[] = {32, 33, 64, 200};
+	std::vector<uint8_t> data(n + 200);
+	for (size_t len : sizes) {
+		std::vector<const uint8_t *> msgs;
+		std::vector<size_t> lens;
+		std::vector<Sha256Hash> hashes;
+		for (size_t i = 0; i < n; i++) {
+			msgs.push_back(&data[i]);
+			lens.push_back(len);
+			hashes.push_back(Sha256::getHash(nullptr, 0));
+		}
+		char label[64];
+		std::snprintf(label, sizeof(label), "Sha256::getHash loop (%zu bytes)", len);
+		printNanos(label, nanosPerCall([&]() {
+			for (size_t i = 0; i < n; i++)
+				hashes[i] = Sha256::getHash(msgs[i], lens[i]);
+			benchSink = hashes[0].value[0];
+		}) / n);
+		std::snprintf(label, sizeof(label), "Sha256::getHashes (%zu bytes)", len);
+		printNanos(label, nanosPerCall([&]() {
+			Sha256::getHashes(msgs.data(), lens.data(), n, hashes.data());
+			benchSink = hashes[0].value[0];
+		}) / n);
+	}
+}
+
+
+BENCH(sha256, throughput) {
+	std::vector<uint8_t> data(size_t(1) << 24);
+	const size_t lens[] = {32, 256, 4096, 65536, size_t(1) << 20, data.size()};
+	for (size_t len : lens) {
+		char label[64];
+		std::snprintf(label, sizeof(label), "Sha256::getHash (%zu bytes)", len);
+		printThroughput(label, nanosPerCall([&]() {
+			benchSink = Sha256::getHash(data.data(), len).value[0];
+		}), len);
+	}
+}
+
+
+BENCH(sha256, double_hash_64) {
+	const size_t n = 1024;
+	std::vector<uint8_t> data(n * 64);
+	for (size_t i = 0; i < data.size(); i++)
+		data[i] = static_cast<uint8_t>(i);
+	std::vector<Sha256Hash> hashes(n, Sha256::getHash(nullptr, 0));
+	printNanos("Sha256::getDoubleHash (64 bytes)", nanosPerCall([&]() {
+		for (size_t i = 0; i < n; i++)
+			hashes[i] = Sha256::getDoubleHash(&data[i * 64], 64);
+		benchSink = hashes[0].value[0];
+	}) / n);
+	printNanos("Sha256::getDoubleHash64", nanosPerCall([&]() {
+		for (size_t i = 0; i < n; i++)
+			hashes[i] = Sha256::getDoubleHash64(&data[i * 64]);
+		benchSink = hashes[0].value[0];
+	}) / n);
+	printNanos("Sha256::getDoubleHashes64", nanosPerCall([&]() {
+		Sha256::getDoubleHashes64(data.data(), n, hashes.data());
+		benchSink = hashes[0].value[0];
+	}) / n);
+}
+
+
+BENCH(sha256, midstate) {
+	// An 80-byte block header whose first 64 bytes stay the same while the nonce changes
+	uint8_t header[80] = {};
+	Sha256 prefix;
+	prefix.append(header, 64);
+	uint32_t midstate[8];
+	std::uint64_t length;
+	prefix.getMidstate(midstate, length);
+	printNanos("Sha256::getDoubleHash (80-byte header)", nanosPerCall([&]() {
+		header[76]++;
+		benchSink = Sha256::getDoubleHash(header, sizeof(header)).value[0];
+	}));
+	printNanos("Same, resumed from midstate", nanosPerCall([&]() {
+		header[76]++;
+		const Sha256Hash inner = Sha256(midstate, length).append(&header[64], 16).getHash();
+		benchSink = Sha256::getHash32(inner.value).value[0];
+	}));
+}
+
+
+BENCH(sha256, hmac) {
+	uint8_t key[32] = {1};
+	uint8_t msg[37] = {2};
+	printNanos("Sha256::getHmac (37-byte message)", nanosPerCall([&]() {
+		msg[0]++;
+		benchSink = Sha256::getHmac(key, sizeof(key), msg, sizeof(msg)).value[0];
+	}));
+	const HmacSha256 hmac(key, sizeof(key));
+	printNanos("HmacSha256::getHmac (37-byte message)", nanosPerCall([&]() {
+		msg[0]++;
+		benchSink = hmac.getHmac(msg, sizeof(msg)).value[0];
+	}));
+}
@@ -0,0 +1,134 @@
+/* 
+ * A runnable benchmark of class Sha512.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "BenchHelper.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "ExtendedPrivateKey.hpp"
+#include "HmacSha512.hpp"
+#include "Sha512.hpp"
+#include "Uint256.hpp"
+
+
+using namespace bcl;
+using std::uint8_t;
+using std::size_t;
+
+
+BENCH(sha512, throughput) {
+	std::vector<uint8_t> data(size_t(1) << 24);
+	const size_t lens[] = {32, 256, 4096, 65536, size_t(1) << 20, data.size()};
+	for (size_t len : lens) {
+		char label[64];
+		std::snprintf(label, sizeof(label), "Sha512::getHash (%zu bytes)", len);
+		printThroughput(label, nanosPerCall([&]() {
+			uint8_t hash[Sha512::HASH_LEN];
+			Sha512::getHash(data.data(), len, hash);
+			benchSink = hash[0];
+		}), len);
+	}
+}
+
+
+BENCH(sha512, hmac) {
+	// The message of a BIP 32 child key derivation under a fixed chain code
+	uint8_t key[32] = {1};
+	uint8_t msg[37] = {2};
+	uint8_t hash[Sha512::HASH_LEN];
+	printNanos("Sha512::getHmac (37-byte message)", nanosPerCall([&]() {
+		msg[36]++;
+		Sha512::getHmac(key, sizeof(key), msg, sizeof(msg), hash);
+		benchSink = hash[0];
+	}));
+	const HmacSha512 hmac(key, sizeof(key));
+	printNanos("HmacSha512::getHmac (37-byte message)", nanosPerCall([&]() {
+		msg[36]++;
+		hmac.getHmac(msg, sizeof(msg), hash);
+		benchSink = hash[0];
+	}));
+}
+
+
+BENCH(sha512, derivation) {
+	// The HMACs of 64 child key derivations under one chain code, one at a time and batched
+	const size_t n = 64;
+	const uint8_t chainCode[32] = {3};
+	const HmacSha512 hmac(chainCode, sizeof(chainCode));
+	std::vector<const HmacSha512 *> keys(n, &hmac);
+	std::vector<uint8_t> msgData(n * 37);
+	std::vector<const uint8_t *> msgs(n);
+	std::vector<size_t> lens(n, 37);
+	for (size_t i = 0; i < n; i++) {
+		msgData[i * 37 + 36] = static_cast<uint8_t>(i);
+		msgs[i] = &msgData[i * 37];
+	}
+	std::vector<uint8_t> outData(n * Sha512::HASH_LEN);
+	uint8_t (*out)[Sha512::HASH_LEN] = reinterpret_cast<uint8_t (*)[Sha512::HASH_LEN]>(outData.data());
+	printNanos("HmacSha512::getHmac, per child", nanosPerCall([&]() {
+		for (size_t i = 0; i < n; i++)
+			hmac.getHmac(msgs[i], lens[i], out[i]);
+		benchSink = out[n - 1][0];
+	}) / n);
+	printNanos("HmacSha512::getHmacs, per child", nanosPerCall([&]() {
+		HmacSha512::getHmacs(keys.data(), msgs.data(), lens.data(), n, out);
+		benchSink = out[n - 1][0];
+	}) / n);
+
+#if defined(BCL_USE_EXTENDED_PRIVATEKEY)
+	// Whole derivations, including the public key of each child
+	Uint256 priv("000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F");
+	uint8_t ppkh[4] = {};
+	const ExtendedPrivateKey parent(priv, chainCode, 0, 0, ppkh);
+	std::vector<uint32_t> indices(n);
+	for (size_t i = 0; i < n; i++)
+		indices[i] = static_cast<uint32_t>(i);
+	std::vector<ExtendedPrivateKey> children(n);
+	printNanos("ExtendedPrivateKey::getChildKey, per child", nanosPerCall([&]() {
+		for (size_t i = 0; i < n; i++)
+			children[i] = parent.getChildKey(indices[i]);
+		benchSink = children[n - 1].chainCode[0];
+	}) / n);
+	printNanos("ExtendedPrivateKey::getChildKeys, per child", nanosPerCall([&]() {
+		parent.getChildKeys(indices.data(), n, children.data());
+		benchSink = children[n - 1].chainCode[0];
+	}) / n);
+#endif
+}
+
+
+BENCH(sha512, pbkdf2) {
+	// BIP 39 seeds (2048 iterations) of 16 different mnemonics, one at a time and batched
+	const size_t n = 16;
+	std::vector<std::vector<uint8_t> > passwords;
+	std::vector<const uint8_t *> passwordPtrs, saltPtrs;
+	std::vector<size_t> passwordLens, saltLens;
+	const uint8_t salt[] = {'m', 'n', 'e', 'm', 'o', 'n', 'i', 'c'};
+	for (size_t i = 0; i < n; i++)
+		passwords.push_back(std::vector<uint8_t>(96, static_cast<uint8_t>('a' + i)));
+	for (size_t i = 0; i < n; i++) {
+		passwordPtrs.push_back(passwords[i].data());
+		passwordLens.push_back(passwords[i].size());
+		saltPtrs.push_back(salt);
+		saltLens.push_back(sizeof(salt));
+	}
+	std::vector<uint8_t> outData(n * Sha512::HASH_LEN);
+	uint8_t (*out)[Sha512::HASH_LEN] = reinterpret_cast<uint8_t (*)[Sha512::HASH_LEN]>(outData.data());
+	printNanos("HmacSha512::getPbkdf2, per seed", nanosPerCall([&]() {
+		for (size_t i = 0; i < n; i++)
+			HmacSha512::getPbkdf2(passwordPtrs[i], passwordLens[i], salt, sizeof(salt), 2048, out[i]);
+		benchSink = out[n - 1][0];
+	}) / n);
+	printNanos("HmacSha512::getPbkdf2s, per seed", nanosPerCall([&]() {
+		HmacSha512::getPbkdf2s(passwordPtrs.data(), passwordLens.data(), saltPtrs.data(), saltLens.data(), n, 2048, out);
+		benchSink = out[n - 1][0];
+	}) / n);
+}
@@ -0,0 +1,44 @@
+/* 
+ * A runnable benchmark of class SigCache.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "BenchHelper.hpp"
+#include <cstdint>
+#include "CurvePoint.hpp"
+#include "Ecdsa.hpp"
+#include "Sha256Hash.hpp"
+#include "SigCache.hpp"
+#include "Uint256.hpp"
+
+
+using namespace bcl;
+using std::uint8_t;
+
+
+BENCH(sig_cache, verify) {
+	const Uint256 privateKey("8B46893E711C8948B28E7637BFBED61666E0118ED4D361BED1F18058214C69B8");
+	const Sha256Hash msgHash("B8EF4E4640FBBD526166FF260EB65EC2B3B60064CCE2DA9747201BA201E90F7F");
+	const CurvePoint publicKey = CurvePoint::privateExponentToPublicPoint(privateKey);
+	Uint256 r, s;
+	Ecdsa::signWithHmacNonce(privateKey, msgHash, r, s);
+	const uint8_t salt[32] = {1};
+	SigCache cache(1 << 16, salt);
+	
+	printNanos("Ecdsa::verify", nanosPerCall([&]() {
+		benchSink = Ecdsa::verify(publicKey, msgHash, r, s);
+	}));
+	printNanos("verify (hit)", nanosPerCall([&]() {
+		benchSink = cache.verify(publicKey, msgHash, r, s);
+	}));
+	Uint256 badS = s;
+	badS.value[0] ^= 1;
+	printNanos("verify (miss, invalid)", nanosPerCall([&]() {
+		benchSink = cache.verify(publicKey, msgHash, r, badS);
+	}));
+}
@@ -0,0 +1,44 @@
+/* 
+ * A runnable benchmark of class SigningKey.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "BenchHelper.hpp"
+#include <cstdint>
+#include "CurvePoint.hpp"
+#include "Ecdsa.hpp"
+#include "Sha256Hash.hpp"
+#include "SigningKey.hpp"
+#include "Uint256.hpp"
+
+
+using namespace bcl;
+using std::uint8_t;
+
+
+static const Uint256 PRIVATE_KEY("8B46893E711C8948B28E7637BFBED61666E0118ED4D361BED1F18058214C69B8");
+static const Sha256Hash MSG_HASH("B8EF4E4640FBBD526166FF260EB65EC2B3B60064CCE2DA9747201BA201E90F7F");
+
+
+BENCH(signing_key, sign) {
+	const SigningKey key(PRIVATE_KEY);
+	printNanos("Ecdsa::signWithHmacNonce + public key", nanosPerCall([]() {
+		Uint256 r, s;
+		uint8_t recId;
+		Ecdsa::signWithHmacNonce(PRIVATE_KEY, MSG_HASH, r, s, recId);
+		uint8_t compressed[33];
+		CurvePoint::privateExponentToPublicPoint(PRIVATE_KEY).toCompressedPoint(compressed);
+		benchSink = r.value[0] ^ s.value[0] ^ compressed[1];
+	}));
+	printNanos("SigningKey::signWithHmacNonce", nanosPerCall([&]() {
+		Uint256 r, s;
+		uint8_t recId;
+		key.signWithHmacNonce(MSG_HASH, r, s, recId);
+		benchSink = r.value[0] ^ s.value[0] ^ key.getCompressedPublicKey()[1];
+	}));
+}
@@ -0,0 +1,53 @@
+/* 
+ * A runnable benchmark of class VerifyPool.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#if defined(BCL_USE_THREADS)
+
+#include "BenchHelper.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "CurvePoint.hpp"
+#include "Ecdsa.hpp"
+#include "Sha256Hash.hpp"
+#include "Uint256.hpp"
+#include "VerifyPool.hpp"
+
+
+using namespace bcl;
+
+
+BENCH(verify_pool, verify) {
+	constexpr size_t LEN = 256;
+	const Sha256Hash msgHash("B8EF4E4640FBBD526166FF260EB65EC2B3B60064CCE2DA9747201BA201E90F7F");
+	std::vector<Uint256> privateKeys(LEN, Uint256("8B46893E711C8948B28E7637BFBED61666E0118ED4D361BED1F18058214C69B8"));
+	std::vector<Sha256Hash> msgHashes(LEN, msgHash);
+	std::vector<Uint256> r(LEN), s(LEN);
+	for (size_t i = 0; i < LEN; i++)
+		privateKeys[i].value[0] ^= static_cast<std::uint32_t>(i);
+	Ecdsa::signBatch(privateKeys.data(), msgHashes.data(), r.data(), s.data(), LEN);
+	std::vector<VerifyPool::Job> jobs;
+	for (size_t i = 0; i < LEN; i++)
+		jobs.push_back(VerifyPool::Job{CurvePoint::privateExponentToPublicPoint(privateKeys[i]), msgHash, r[i], s[i]});
+	
+	std::printf("  (%u hardware threads)\n", std::thread::hardware_concurrency());
+	bool results[LEN];
+	for (size_t threads = 1; threads <= 64; threads *= 2) {
+		VerifyPool pool(threads);
+		char label[40];
+		std::snprintf(label, sizeof(label), "verify per signature, %u threads", static_cast<unsigned int>(threads));
+		printNanos(label, nanosPerCall([&]() {
+			benchSink = pool.verify(jobs.data(), results, LEN);
+		}) / LEN);
+	}
+}
+
+#endif  // BCL_USE_THREADS
@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/GoogleTest"
+  "CMakeFiles/GoogleTest-complete"
+  "GoogleTest-prefix/src/GoogleTest-stamp/GoogleTest-build"
+  "GoogleTest-prefix/src/GoogleTest-stamp/GoogleTest-configure"
+  "GoogleTest-prefix/src/GoogleTest-stamp/GoogleTest-download"
+  "GoogleTest-prefix/src/GoogleTest-stamp/GoogleTest-install"
+  "GoogleTest-prefix/src/GoogleTest-stamp/GoogleTest-mkdir"
+  "GoogleTest-prefix/src/GoogleTest-stamp/GoogleTest-patch"
+  "GoogleTest-prefix/src/GoogleTest-stamp/GoogleTest-test"
+  "GoogleTest-prefix/src/GoogleTest-stamp/GoogleTest-update"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/GoogleTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
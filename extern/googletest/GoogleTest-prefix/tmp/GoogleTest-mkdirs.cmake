@@ -0,0 +1,22 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+cmake_minimum_required(VERSION 3.5)
+
+file(MAKE_DIRECTORY
+  "/root/repo/extern/googletest/src"
+  "/root/repo/extern/googletest/build"
+  "/root/repo/extern/googletest/GoogleTest-prefix"
+  "/root/repo/extern/googletest/GoogleTest-prefix/tmp"
+  "/root/repo/extern/googletest/GoogleTest-prefix/src/GoogleTest-stamp"
+  "/root/repo/extern/googletest/GoogleTest-prefix/src"
+  "/root/repo/extern/googletest/GoogleTest-prefix/src/GoogleTest-stamp"
+)
+
+set(configSubDirs )
+foreach(subDir IN LISTS configSubDirs)
+    file(MAKE_DIRECTORY "/root/repo/extern/googletest/GoogleTest-prefix/src/GoogleTest-stamp/${subDir}")
+endforeach()
+if(cfgdir)
+  file(MAKE_DIRECTORY "/root/repo/extern/googletest/GoogleTest-prefix/src/GoogleTest-stamp${cfgdir}") # cfgdir has leading slash
+endif()
@@ -0,0 +1,141 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include <cassert>
+#include "AffinePoint.hpp"
+#include "CurvePoint.hpp"
+
+namespace bcl {
+
+using std::uint8_t;
+using std::uint32_t;
+using std::size_t;
+
+
+AffinePoint::AffinePoint() :
+	x(CurvePoint::FI_ZERO), y(CurvePoint::FI_ZERO) {}
+
+
+AffinePoint::AffinePoint(const FieldInt &x_, const FieldInt &y_) :
+	x(x_), y(y_) {}
+
+
+AffinePoint::AffinePoint(const CurvePoint &p) :
+		x(p.x), y(p.y) {
+	assert(p.z == CurvePoint::FI_ONE || p.isZero());
+	y.replace(CurvePoint::FI_ZERO, static_cast<uint32_t>(p.z == CurvePoint::FI_ZERO));
+}
+
+
+CurvePoint AffinePoint::toCurvePoint() const {
+	CurvePoint result(x, y);
+	result.replace(CurvePoint::ZERO, static_cast<uint32_t>(isZero()));
+	return result;
+}
+
+
+void AffinePoint::replace(const AffinePoint &other, uint32_t enable) {
+	assert((enable >> 1) == 0);
+	this->x.replace(other.x, enable);
+	this->y.replace(other.y, enable);
+}
+
+
+bool AffinePoint::isOnCurve() const {
+	FieldInt left = y;
+	left.square();
+	FieldInt right = x;
+	right.square();
+	right.add(CurvePoint::A);
+	right.multiply(x);
+	right.add(CurvePoint::B);
+	return (left == right) & !isZero();
+}
+
+
+bool AffinePoint::isZero() const {
+	return (x == CurvePoint::FI_ZERO) & (y == CurvePoint::FI_ZERO);
+}
+
+
+bool AffinePoint::operator==(const AffinePoint &other) const {
+	return (x == other.x) & (y == other.y);
+}
+
+bool AffinePoint::operator!=(const AffinePoint &other) const {
+	return !(*this == other);
+}
+
+
+void AffinePoint::toCompressedPoint(uint8_t output[33]) const {
+	assert(output != nullptr);
+	output[0] = static_cast<uint8_t>((y.value[0] & 1) + 0x02);
+	x.getBigEndianBytes(&output[1]);
+}
+
+
+void AffinePoint::toXOnly(uint8_t output[32]) const {
+	assert(output != nullptr);
+	x.getBigEndianBytes(output);
+}
+
+
+void AffinePoint::fromCurvePoints(const CurvePoint points[], AffinePoint out[], size_t len) {
+	/* 
+	 * Algorithm pseudocode:
+	 * for (i = 0 .. len-1)
+	 *   prod[i] = z[0] * ... * z[i]  (where zero z values are taken as 1)
+	 * inv = 1 / prod[len-1]
+	 * for (i = len-1 .. 0) {
+	 *   zInv = inv * prod[i-1]  (or just inv if i = 0)
+	 *   inv = inv * z[i]
+	 *   out[i] = (x[i] * zInv, y[i] * zInv), or ZERO if z[i] = 0
+	 * }
+	 */
+	assert((points != nullptr && out != nullptr) || len == 0);
+	if (len == 0)
+		return;
+	
+	// Store the running products in the x coordinates of the output
+	FieldInt prod = CurvePoint::FI_ONE;
+	for (size_t i = 0; i < len; i++) {
+		FieldInt z = points[i].z;
+		z.replace(CurvePoint::FI_ONE, static_cast<uint32_t>(z == CurvePoint::FI_ZERO));
+		prod.multiply(z);
+		out[i].x = prod;
+	}
+	
+	FieldInt inv = prod;
+	inv.reciprocal();
+	for (size_t i = len; i-- > 0; ) {
+		const CurvePoint &p = points[i];
+		bool isZero = p.z == CurvePoint::FI_ZERO;
+		FieldInt zInv = inv;
+		if (i > 0)
+			zInv.multiply(out[i - 1].x);
+		FieldInt z = p.z;
+		z.replace(CurvePoint::FI_ONE, static_cast<uint32_t>(isZero));
+		inv.multiply(z);
+		
+		AffinePoint &q = out[i];
+		q.x = p.x;
+		q.x.multiply(zInv);
+		q.y = p.y;
+		q.y.multiply(zInv);
+		q.replace(ZERO, static_cast<uint32_t>(isZero));
+	}
+}
+
+
+// Static initializers
+const AffinePoint AffinePoint::ZERO(
+	FieldInt("0000000000000000000000000000000000000000000000000000000000000000"),
+	FieldInt("0000000000000000000000000000000000000000000000000000000000000000"));
+
+
+}  // namespace bcl
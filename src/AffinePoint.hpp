@@ -0,0 +1,108 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "FieldInt.hpp"
+
+namespace bcl {
+
+class CurvePoint;  // Forward declaration
+
+
+/* 
+ * A point on the secp256k1 elliptic curve in affine coordinates (x, y). This is the compact form of a
+ * normalized CurvePoint, using 64 bytes instead of 96, for storing public keys and precomputed tables.
+ * The special point at infinity is represented as (0, 0), which is not on the curve.
+ * Instances of this class are mutable.
+ * 
+ * Arithmetic is done on CurvePoint; an AffinePoint can be added directly to a CurvePoint with
+ * CurvePoint::add(const AffinePoint &), which is cheaper than adding two CurvePoints.
+ */
+class AffinePoint final {
+	
+	/*---- Fields ----*/
+	
+	public: FieldInt x;
+	public: FieldInt y;
+	
+	
+	
+	/*---- Constructors ----*/
+	
+	// Constructs the special point at infinity (ZERO). Useful for arrays of points.
+	public: explicit AffinePoint();
+	
+	
+	// Constructs an affine point from the given coordinates. Constant-time with respect to the values.
+	public: explicit AffinePoint(const FieldInt &x_, const FieldInt &y_);
+	
+	
+	// Constructs an affine point from the given curve point, which must be normalized.
+	// CurvePoint::ZERO becomes AffinePoint::ZERO. Constant-time with respect to the value.
+	public: explicit AffinePoint(const CurvePoint &p);
+	
+	
+	
+	/*---- Methods ----*/
+	
+	// Returns this point as a normalized curve point. Constant-time with respect to this value.
+	public: CurvePoint toCurvePoint() const;
+	
+	
+	// Copies the given point into this point if enable is 1, or does nothing if enable is 0.
+	// Constant-time with respect to both values and the enable.
+	public: void replace(const AffinePoint &other, std::uint32_t enable);
+	
+	
+	// Tests whether this point is on the elliptic curve. Zero is considered
+	// to be off the curve. Constant-time with respect to this value.
+	public: bool isOnCurve() const;
+	
+	
+	// Tests whether this point is equal to the special zero point. Constant-time with respect to this value.
+	public: bool isZero() const;
+	
+	
+	// Tests whether this point equals the given point in both coordinates. Constant-time with respect to both values.
+	public: bool operator==(const AffinePoint &other) const;
+	
+	// Tests whether this point mismatches the given point in either coordinate. Constant-time with respect to both values.
+	public: bool operator!=(const AffinePoint &other) const;
+	
+	
+	// Serializes this point in compressed format (header byte, x-coordinate in big-endian).
+	// Constant-time with respect to this value.
+	public: void toCompressedPoint(std::uint8_t output[33]) const;
+	
+	
+	// Serializes the x-coordinate of this point in big-endian, which is the 32-byte x-only
+	// form used by BIP 340 public keys. Constant-time with respect to this value.
+	public: void toXOnly(std::uint8_t output[32]) const;
+	
+	
+	
+	/*---- Static functions ----*/
+	
+	// Converts the given curve points (which need not be normalized) to affine points, using one shared
+	// field inversion for all of them (Montgomery's trick). Zero points become AffinePoint::ZERO.
+	// The arrays must not overlap. Constant-time with respect to the values.
+	public: static void fromCurvePoints(const CurvePoint points[], AffinePoint out[], std::size_t len);
+	
+	
+	
+	/*---- Class constants ----*/
+	
+	public: static const AffinePoint ZERO;  // Dummy point at infinity
+	
+};
+
+
+}  // namespace bcl
@@ -9,6 +9,7 @@
 #include <cassert>
 #include <cstring>
 #include "Base58Check.hpp"
+#include "CurvePoint.hpp"
 #include "Sha256.hpp"
 #include "Sha256Hash.hpp"
 #include "Utils.hpp"
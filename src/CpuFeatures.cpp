@@ -0,0 +1,110 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "CpuFeatures.hpp"
+
+#if defined(BCL_X86)
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#include <cpuid.h>
+	#endif
+#endif
+
+namespace bcl {
+
+using std::uint32_t;
+using std::uint64_t;
+
+
+bool CpuFeatures::hasShaNi() {
+#if defined(BCL_X86)
+	static const bool result = []() {
+		uint32_t leaf1[4], leaf7[4];
+		cpuid(1, 0, leaf1);
+		cpuid(7, 0, leaf7);
+		bool sse41 = ((leaf1[2] >> 19) & 1) != 0;
+		bool sha = ((leaf7[1] >> 29) & 1) != 0;
+		return sse41 && sha;
+	}();
+	return result;
+#else
+	return false;
+#endif
+}
+
+
+bool CpuFeatures::hasAvx2() {
+#if defined(BCL_X86)
+	static const bool result = []() {
+		uint32_t leaf7[4];
+		cpuid(7, 0, leaf7);
+		bool avx2 = ((leaf7[1] >> 5) & 1) != 0;
+		return avx2 && (getXcr0() & 0x06) == 0x06;  // XMM and YMM state
+	}();
+	return result;
+#else
+	return false;
+#endif
+}
+
+
+bool CpuFeatures::hasAvx512() {
+#if defined(BCL_X86)
+	static const bool result = []() {
+		uint32_t leaf7[4];
+		cpuid(7, 0, leaf7);
+		bool avx512f = ((leaf7[1] >> 16) & 1) != 0;
+		return avx512f && (getXcr0() & 0xE6) == 0xE6;  // XMM, YMM, opmask, and ZMM state
+	}();
+	return result;
+#else
+	return false;
+#endif
+}
+
+
+#if defined(BCL_X86)
+void CpuFeatures::cpuid(uint32_t leaf, uint32_t subleaf, uint32_t out[4]) {
+	#if defined(_MSC_VER)
+		int regs[4];
+		__cpuid(regs, 0);
+		if (static_cast<uint32_t>(regs[0]) < leaf) {
+			out[0] = out[1] = out[2] = out[3] = 0;
+			return;
+		}
+		__cpuidex(regs, static_cast<int>(leaf), static_cast<int>(subleaf));
+		for (int i = 0; i < 4; i++)
+			out[i] = static_cast<uint32_t>(regs[i]);
+	#else
+		if (__get_cpuid_max(0, nullptr) < leaf) {
+			out[0] = out[1] = out[2] = out[3] = 0;
+			return;
+		}
+		__cpuid_count(leaf, subleaf, out[0], out[1], out[2], out[3]);
+	#endif
+}
+
+
+uint64_t CpuFeatures::getXcr0() {
+	uint32_t leaf1[4];
+	cpuid(1, 0, leaf1);
+	if (((leaf1[2] >> 27) & 1) == 0)  // OSXSAVE
+		return 0;
+	#if defined(_MSC_VER)
+		return _xgetbv(0);
+	#else
+		uint32_t low, high;
+		__asm__("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+		return static_cast<uint64_t>(high) << 32 | low;
+	#endif
+}
+#endif
+
+
+}  // namespace bcl
@@ -0,0 +1,79 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#pragma once
+
+#include <cstdint>
+
+
+// BCL_X86 is defined iff the code is compiled for x86 or x86-64 by a compiler whose intrinsics are supported.
+// Defining BCL_PORTABLE disables all the instruction set extensions, leaving only the portable code.
+#if !defined(BCL_PORTABLE) && ((defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))) || (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))))
+	#define BCL_X86
+#endif
+
+// Marks a function as allowed to use the given instruction set extensions (e.g. "sha,sse4.1") when the
+// rest of the file is compiled for the baseline architecture. MSVC needs no such marking.
+#if defined(__GNUC__)
+	#define BCL_TARGET(features) __attribute__((target(features)))
+#else
+	#define BCL_TARGET(features)
+#endif
+
+// Enclose the functions that use AVX-512 intrinsics, because some versions of GCC
+// wrongly warn about the undefined pass-through operand inside those intrinsics.
+#if defined(__GNUC__) && !defined(__clang__)
+	#define BCL_AVX512_WARNINGS_BEGIN \
+		_Pragma("GCC diagnostic push") \
+		_Pragma("GCC diagnostic ignored \"-Wuninitialized\"") \
+		_Pragma("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+	#define BCL_AVX512_WARNINGS_END _Pragma("GCC diagnostic pop")
+#else
+	#define BCL_AVX512_WARNINGS_BEGIN
+	#define BCL_AVX512_WARNINGS_END
+#endif
+
+
+namespace bcl {
+
+
+/* 
+ * Detects the instruction set extensions of the running CPU, for choosing an implementation at run time.
+ * Each result is computed once and cached. All functions return false when BCL_X86 is not defined.
+ */
+class CpuFeatures final {
+	
+	// Tests whether the CPU has the SHA extensions (SHA-NI) and SSE4.1, as used by Sha256.
+	public: static bool hasShaNi();
+	
+	
+	// Tests whether the CPU has AVX2 and the operating system saves the YMM registers.
+	public: static bool hasAvx2();
+	
+	
+	// Tests whether the CPU has AVX-512 Foundation and the operating system saves the ZMM registers.
+	public: static bool hasAvx512();
+	
+	
+#if defined(BCL_X86)
+	// Executes the CPUID instruction with the given leaf and subleaf, setting out to {EAX, EBX, ECX, EDX}.
+	// Sets out to zeros if the leaf is not supported.
+	private: static void cpuid(std::uint32_t leaf, std::uint32_t subleaf, std::uint32_t out[4]);
+	
+	
+	// Returns the extended control register XCR0, i.e. the register states that the OS saves, or 0 if XGETBV is unavailable.
+	private: static std::uint64_t getXcr0();
+#endif
+	
+	
+	CpuFeatures() = delete;  // Not instantiable
+	
+};
+
+
+}  // namespace bcl
@@ -8,6 +8,7 @@
 
 #include <cassert>
 #include "CurvePoint.hpp"
+#include "ScalarInt.hpp"
 
 namespace bcl {
 
@@ -114,6 +115,87 @@ void CurvePoint::add(const CurvePoint &other) {
 }
 
 
+void CurvePoint::add(const AffinePoint &other) {
+	/* 
+	 * This is add(CurvePoint) specialized to z1 = 1, which makes
+	 * u0 = x0, t0 = y0, and v = z0. Algorithm pseudocode:
+	 * if (this == ZERO)
+	 *   this = other
+	 * else if (other == ZERO)
+	 *   this = this
+	 * else {
+	 *   t1 = y1 * z0
+	 *   u1 = x1 * z0
+	 *   if (x0 == u1) {  // Same x coordinates
+	 *     if (y0 == t1)  // Same y coordinates
+	 *       this = twice()
+	 *     else
+	 *       this = ZERO
+	 *   } else {
+	 *     t = y0 - t1
+	 *     u = x0 - u1
+	 *     u2 = u^2
+	 *     w = t^2 * z0 - u2 * (x0 + u1)
+	 *     x' = u * w
+	 *     u3 = u2 * u
+	 *     y' = t * (x0 * u2 - w) - y0 * u3
+	 *     z' = u3 * z0
+	 *   }
+	 * }
+	 */
+	bool thisZero  = this->isZero();
+	bool otherZero = other.isZero();
+	CurvePoint temp = *this;
+	temp.twice();
+	temp.replace(*this, static_cast<uint32_t>(otherZero));
+	temp.replace(other.toCurvePoint(), static_cast<uint32_t>(thisZero));
+	
+	FieldInt u0 = this->x;
+	FieldInt u1 = other.x;
+	FieldInt t0 = this->y;
+	FieldInt &t1 = x;  // Reuse memory
+	t1 = other.y;
+	u1.multiply(this->z);
+	t1.multiply(this->z);
+	bool sameX = u0 == u1;
+	bool sameY = t0 == t1;
+	temp.replace(ZERO, static_cast<uint32_t>(!thisZero & !otherZero & sameX & !sameY));
+	
+	FieldInt &t = y;  // Reuse memory
+	t = t0;
+	t.subtract(t1);
+	FieldInt u = u0;
+	u.subtract(u1);
+	FieldInt u2 = u;
+	u2.square();
+	FieldInt &v = z;  // Reuse memory, v = z0
+	
+	FieldInt w = t;
+	w.square();
+	w.multiply(v);
+	u1.add(u0);
+	u1.multiply(u2);
+	w.subtract(u1);
+	
+	x = u;
+	x.multiply(w);
+	
+	FieldInt &u3 = u1;  // Reuse memory
+	u3 = u;
+	u3.multiply(u2);
+	
+	u0.multiply(u2);
+	u0.subtract(w);
+	t.multiply(u0);
+	t0.multiply(u3);
+	t.subtract(t0);  // Assigns to y
+	
+	v.multiply(u3);  // Assigns to z
+	
+	this->replace(temp, static_cast<uint32_t>(thisZero | otherZero | sameX));
+}
+
+
 void CurvePoint::twice() {
 	
 	/* 
@@ -176,36 +258,323 @@ void CurvePoint::twice() {
 }
 
 
+template <unsigned int len>
+void CurvePoint::buildTable(AffinePoint table[len]) const {
+	// Compute the multiples in projective form, then normalize them together
+	CurvePoint temp[len];
+	buildProjectiveTable<len>(temp);
+	AffinePoint::fromCurvePoints(temp, table, len);
+}
+
+
+template <unsigned int len>
+void CurvePoint::buildProjectiveTable(CurvePoint table[len]) const {
+	// Even multiples are doublings, which are cheaper than additions
+	table[0] = *this;
+	for (unsigned int i = 2; i <= len; i++) {
+		if (i % 2 == 0) {
+			table[i - 1] = table[i / 2 - 1];
+			table[i - 1].twice();
+		} else {
+			table[i - 1] = table[i - 2];
+			table[i - 1].add(*this);
+		}
+	}
+}
+
+
+template <int windowBits>
 void CurvePoint::multiply(const Uint256 &n) {
-	// Precompute [this*0, this*1, ..., this*15]
-	constexpr int tableBits = 4;  // Do not modify
-	constexpr unsigned int tableLen = 1U << tableBits;
+	static_assert(2 <= windowBits && windowBits <= 7, "Unsupported window width");
+	
+	// Precompute [this*0, this*1, ..., this*(tableLen-1)]. The table stays projective here,
+	// because normalizing it costs an inversion and a second table on the stack.
+	constexpr unsigned int tableLen = 1U << windowBits;
 	CurvePoint table[tableLen];  // Default-initialized with ZERO
-	table[1] = *this;
-	table[2] = *this;
-	table[2].twice();
-	for (unsigned int i = 3; i < tableLen; i++) {
-		table[i] = table[i - 1];
-		table[i].add(*this);
-	}
+	buildProjectiveTable<tableLen - 1>(&table[1]);
 	
-	// Process tableBits per iteration (windowed method)
+	// Process windowBits per iteration (windowed method)
+	constexpr int numBits = Uint256::NUM_WORDS * 32;
 	*this = ZERO;
-	for (int i = Uint256::NUM_WORDS * 32 - tableBits; i >= 0; i -= tableBits) {
-		unsigned int inc = (n.value[i >> 5] >> (i & 31)) & (tableLen - 1);
+	for (int i = (numBits - 1) / windowBits * windowBits; i >= 0; i -= windowBits) {
+		unsigned int inc = getWindow(n, i, windowBits);
 		CurvePoint q = ZERO;  // Dummy initial value
 		for (unsigned int j = 0; j < tableLen; j++) {
 			q.replace(table[j], static_cast<uint32_t>(j == inc));
 		}
 		this->add(q);
 		if (i != 0) {
-			for (int j = 0; j < tableBits; j++) {
+			for (int j = 0; j < windowBits; j++) {
 				this->twice();
 			}
 		}
 	}
 }
 
+template void CurvePoint::multiply<2>(const Uint256 &n);
+template void CurvePoint::multiply<3>(const Uint256 &n);
+template void CurvePoint::multiply<4>(const Uint256 &n);
+template void CurvePoint::multiply<5>(const Uint256 &n);
+template void CurvePoint::multiply<6>(const Uint256 &n);
+template void CurvePoint::multiply<7>(const Uint256 &n);
+
+
+void CurvePoint::multiply(const Uint256 &n) {
+	multiply<WINDOW_BITS>(n);
+}
+
+
+void CurvePoint::multiplyEndomorphism(const Uint256 &n) {
+	/* 
+	 * Algorithm pseudocode:
+	 * (k1, k2) = splitLambda(n % ORDER)
+	 * p1 = this, p2 = (BETA * x, y) = LAMBDA * this
+	 * if (k1 is negative) { k1 = -k1; p1 = -p1 }
+	 * if (k2 is negative) { k2 = -k2; p2 = -p2 }
+	 * this = k1 * p1 + k2 * p2  // With 128-bit k1 and k2 sharing doublings
+	 */
+	assert(z == FI_ONE || isZero());
+	constexpr int windowBits = WINDOW_BITS;
+	constexpr unsigned int tableLen = 1U << windowBits;
+	
+	ScalarInt k1(Uint256::ZERO);
+	ScalarInt k2(Uint256::ZERO);
+	ScalarInt(n).splitLambda(k1, k2);
+	ScalarInt negK1 = k1;
+	ScalarInt negK2 = k2;
+	negK1.negate();
+	negK2.negate();
+	uint32_t neg1 = static_cast<uint32_t>(Uint256(negK1) < Uint256(k1));
+	uint32_t neg2 = static_cast<uint32_t>(Uint256(negK2) < Uint256(k2));
+	k1.replace(negK1, neg1);
+	k2.replace(negK2, neg2);
+	
+	// Precompute [this*0, ..., this*(tableLen-1)] and [(LAMBDA*this)*0, ...] in affine form,
+	// where the latter only costs a field multiplication per entry, then apply the signs
+	AffinePoint table1[tableLen];  // Default-initialized with ZERO
+	AffinePoint table2[tableLen];
+	buildTable<tableLen - 1>(&table1[1]);
+	for (unsigned int i = 0; i < tableLen; i++) {
+		table2[i] = table1[i];
+		table2[i].x.multiply(BETA);
+		FieldInt negY = FI_ZERO;
+		negY.subtract(table1[i].y);
+		table1[i].y.replace(negY, neg1);
+		table2[i].y.replace(negY, neg2);
+	}
+	
+	// Same as multiply(), but over 128 bits and with two table lookups per window
+	constexpr int numBits = Uint256::NUM_WORDS * 32 / 2;
+	const Uint256 n1(k1);
+	const Uint256 n2(k2);
+	*this = ZERO;
+	for (int i = (numBits - 1) / windowBits * windowBits; i >= 0; i -= windowBits) {
+		unsigned int inc1 = getWindow(n1, i, windowBits);
+		unsigned int inc2 = getWindow(n2, i, windowBits);
+		AffinePoint q1 = AffinePoint::ZERO;  // Dummy initial values
+		AffinePoint q2 = AffinePoint::ZERO;
+		for (unsigned int j = 0; j < tableLen; j++) {
+			q1.replace(table1[j], static_cast<uint32_t>(j == inc1));
+			q2.replace(table2[j], static_cast<uint32_t>(j == inc2));
+		}
+		this->add(q1);
+		this->add(q2);
+		if (i != 0) {
+			for (int j = 0; j < windowBits; j++)
+				this->twice();
+		}
+	}
+}
+
+
+void CurvePoint::multiplyVartime(const Uint256 &n) {
+	constexpr int windowBits = WINDOW_BITS;
+	constexpr unsigned int tableLen = 1U << windowBits;
+	AffinePoint table[tableLen];  // Default-initialized with ZERO
+	buildTable<tableLen - 1>(&table[1]);
+	
+	// Same as multiply(), but skipping the table scan, zero windows, and leading doublings
+	constexpr int numBits = Uint256::NUM_WORDS * 32;
+	*this = ZERO;
+	for (int i = (numBits - 1) / windowBits * windowBits; i >= 0; i -= windowBits) {
+		if (!isZero()) {
+			for (int j = 0; j < windowBits; j++)
+				this->twice();
+		}
+		unsigned int inc = getWindow(n, i, windowBits);
+		if (inc != 0)
+			this->addVartime(table[inc]);
+	}
+}
+
+
+void CurvePoint::addVartime(const AffinePoint &other) {
+	// Same algorithm as add(const AffinePoint &), but branching on the special cases
+	if (other.isZero())
+		return;
+	if (this->isZero()) {
+		*this = other.toCurvePoint();
+		return;
+	}
+	
+	FieldInt u1 = other.x;
+	u1.multiply(z);
+	FieldInt t1 = other.y;
+	t1.multiply(z);
+	if (x == u1) {
+		if (y == t1)
+			this->twice();
+		else
+			*this = ZERO;
+		return;
+	}
+	
+	FieldInt t = y;
+	t.subtract(t1);
+	FieldInt u = x;
+	u.subtract(u1);
+	FieldInt u2 = u;
+	u2.square();
+	
+	FieldInt w = t;
+	w.square();
+	w.multiply(z);
+	u1.add(x);
+	u1.multiply(u2);
+	w.subtract(u1);
+	
+	FieldInt &u3 = u1;  // Reuse memory
+	u3 = u;
+	u3.multiply(u2);
+	
+	FieldInt temp = x;
+	temp.multiply(u2);
+	temp.subtract(w);
+	t.multiply(temp);
+	temp = y;
+	temp.multiply(u3);
+	t.subtract(temp);
+	y = t;
+	
+	x = u;
+	x.multiply(w);
+	z.multiply(u3);
+}
+
+
+CurvePoint CurvePoint::multiplyDualVartime(const Uint256 &u1, const CurvePoint &p, const Uint256 &u2) {
+	constexpr int windowBits = WINDOW_BITS;
+	constexpr unsigned int tableLen = (1U << windowBits) - 1;
+	
+	// Precompute [p*1, ..., p*tableLen] in affine form; the table for G is built once and shared by all calls
+	const AffinePoint *baseTable = getBaseTable();
+	AffinePoint table[tableLen];
+	p.buildTable<tableLen>(table);
+	
+	// Like multiplyVartime(), but both scalars share the same doublings
+	constexpr int numBits = Uint256::NUM_WORDS * 32;
+	CurvePoint result = ZERO;
+	for (int i = (numBits - 1) / windowBits * windowBits; i >= 0; i -= windowBits) {
+		if (!result.isZero()) {
+			for (int j = 0; j < windowBits; j++)
+				result.twice();
+		}
+		unsigned int inc1 = getWindow(u1, i, windowBits);
+		if (inc1 != 0)
+			result.addVartime(baseTable[inc1 - 1]);
+		unsigned int inc2 = getWindow(u2, i, windowBits);
+		if (inc2 != 0)
+			result.addVartime(table[inc2 - 1]);
+	}
+	return result;
+}
+
+
+CurvePoint CurvePoint::multiplyMultiVartime(const AffinePoint points[], const Uint256 scalars[], std::size_t len) {
+	assert((points != nullptr && scalars != nullptr) || len == 0);
+	constexpr int windowBits = WINDOW_BITS;
+	constexpr unsigned int tableLen = (1U << windowBits) - 1;
+	constexpr int numBits = Uint256::NUM_WORDS * 32;
+	
+	CurvePoint result = ZERO;
+	for (std::size_t start = 0; start < len; start += MULTI_CHUNK_LEN) {
+		std::size_t count = len - start < MULTI_CHUNK_LEN ? len - start : MULTI_CHUNK_LEN;
+		
+		// Precompute [p*1, ..., p*tableLen] for each point p of this chunk, with one shared field inversion
+		AffinePoint table[MULTI_CHUNK_LEN * tableLen];
+		{
+			CurvePoint temp[MULTI_CHUNK_LEN * tableLen];
+			for (std::size_t i = 0; i < count; i++)
+				points[start + i].toCurvePoint().buildProjectiveTable<tableLen>(&temp[i * tableLen]);
+			AffinePoint::fromCurvePoints(temp, table, count * tableLen);
+		}
+		
+		// Same as multiplyDualVartime(), but for count points
+		CurvePoint sum = ZERO;
+		for (int i = (numBits - 1) / windowBits * windowBits; i >= 0; i -= windowBits) {
+			if (!sum.isZero()) {
+				for (int j = 0; j < windowBits; j++)
+					sum.twice();
+			}
+			for (std::size_t j = 0; j < count; j++) {
+				unsigned int inc = getWindow(scalars[start + j], i, windowBits);
+				if (inc != 0)
+					sum.addVartime(table[j * tableLen + inc - 1]);
+			}
+		}
+		result.add(sum);
+	}
+	return result;
+}
+
+
+bool CurvePoint::fromCompressedPoint(const uint8_t input[33], CurvePoint &result) {
+	assert(input != nullptr);
+	if (input[0] != 0x02 && input[0] != 0x03)
+		return false;
+	return fromX(Uint256(&input[1]), input[0] & 1U, result);
+}
+
+
+bool CurvePoint::fromX(const Uint256 &x, uint32_t oddY, CurvePoint &result) {
+	/* 
+	 * Algorithm pseudocode:
+	 * if (x >= modulus)
+	 *   return false
+	 * y = sqrt(x^3 + a * x + b)
+	 * if (y does not exist)
+	 *   return false
+	 * if (y % 2 != oddY)
+	 *   y = modulus - y
+	 * result = (x, y)
+	 */
+	assert((oddY >> 1) == 0);
+	const FieldInt fx(x);
+	if (Uint256(fx) != x)  // x was reduced, so it was out of range
+		return false;
+	FieldInt y = fx;
+	y.square();
+	y.add(A);
+	y.multiply(fx);
+	y.add(B);
+	if (!y.sqrt())
+		return false;
+	FieldInt negY = FI_ZERO;
+	negY.subtract(y);
+	y.replace(negY, (y.value[0] & 1) ^ oddY);
+	result = CurvePoint(fx, y);
+	return true;
+}
+
+
+unsigned int CurvePoint::getWindow(const Uint256 &n, int i, int windowBits) {
+	// The bit position is public, so these branches do not leak the value of n
+	uint32_t bits = n.value[i >> 5] >> (i & 31);
+	if ((i & 31) + windowBits > 32 && (i >> 5) + 1 < Uint256::NUM_WORDS)
+		bits |= n.value[(i >> 5) + 1] << (32 - (i & 31));
+	return bits & ((1U << windowBits) - 1);
+}
+
 
 void CurvePoint::normalize() {
 	/* 
@@ -281,11 +650,41 @@ CurvePoint CurvePoint::privateExponentToPublicPoint(const Uint256 &privExp) {
 }
 
 
+void CurvePoint::privateExponentsToPublicPoints(const Uint256 privExps[], AffinePoint out[], std::size_t len) {
+	assert((privExps != nullptr && out != nullptr) || len == 0);
+	for (std::size_t start = 0; start < len; start += MULTI_CHUNK_LEN) {
+		std::size_t count = len - start < MULTI_CHUNK_LEN ? len - start : MULTI_CHUNK_LEN;
+		CurvePoint temp[MULTI_CHUNK_LEN];
+		for (std::size_t i = 0; i < count; i++) {
+			assert((Uint256::ZERO < privExps[start + i]) & (privExps[start + i] < CurvePoint::ORDER));
+			temp[i] = CurvePoint::G;
+			temp[i].multiply(privExps[start + i]);
+		}
+		AffinePoint::fromCurvePoints(temp, &out[start], count);
+	}
+}
+
+
+const AffinePoint *CurvePoint::getBaseTable() {
+	constexpr unsigned int tableLen = (1U << WINDOW_BITS) - 1;
+	struct Table final {
+		AffinePoint points[tableLen];
+	};
+	static const Table result = []() {
+		Table tbl;
+		G.buildTable<tableLen>(tbl.points);
+		return tbl;
+	}();
+	return result.points;
+}
+
+
 // Static initializers
 const FieldInt CurvePoint::FI_ZERO("0000000000000000000000000000000000000000000000000000000000000000");
 const FieldInt CurvePoint::FI_ONE ("0000000000000000000000000000000000000000000000000000000000000001");
 const FieldInt CurvePoint::A    ("0000000000000000000000000000000000000000000000000000000000000000");
 const FieldInt CurvePoint::B    ("0000000000000000000000000000000000000000000000000000000000000007");
+const FieldInt CurvePoint::BETA ("7AE96A2B657C07106E64479EAC3434E99CF0497512F58995C1396C28719501EE");
 const Uint256  CurvePoint::ORDER("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141");
 const CurvePoint CurvePoint::G(
 	FieldInt("79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798"),
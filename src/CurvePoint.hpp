@@ -8,10 +8,18 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include "AffinePoint.hpp"
 #include "FieldInt.hpp"
 #include "Uint256.hpp"
 
+// Width in bits of the window used by CurvePoint::multiply(), in the range [2, 7]. Each extra bit
+// doubles the size of the stack-allocated table of points but reduces the number of point additions.
+#if !defined(BCL_CURVEPOINT_WINDOW_BITS)
+	#define BCL_CURVEPOINT_WINDOW_BITS 4
+#endif
+
 namespace bcl {
 
 
@@ -64,6 +72,11 @@ class CurvePoint final {
 	public: void add(const CurvePoint &other);
 	
 	
+	// Adds the given affine point to this point (mixed addition), which needs fewer field multiplications
+	// than adding a CurvePoint. The resulting state is usually not normalized. Constant-time with respect to both values.
+	public: void add(const AffinePoint &other);
+	
+	
 	// Doubles this curve point. The resulting state is usually
 	// not normalized. Constant-time with respect to this value.
 	public: void twice();
@@ -71,9 +84,29 @@ class CurvePoint final {
 	
 	// Multiplies this point by the given unsigned integer. The resulting state
 	// is usually not normalized. Constant-time with respect to both values.
+	// This uses the default window width, which is set by BCL_CURVEPOINT_WINDOW_BITS.
 	public: void multiply(const Uint256 &n);
 	
 	
+	// Multiplies this point by the given unsigned integer, using a table of 2^windowBits points
+	// on the stack. Instantiated for 2 <= windowBits <= 7. The resulting state is usually
+	// not normalized. Constant-time with respect to both values.
+	public: template <int windowBits> void multiply(const Uint256 &n);
+	
+	
+	// Multiplies this point by the given unsigned integer using the secp256k1 endomorphism, which splits n into
+	// two 128-bit halves that share their doublings (GLV method). The result equals multiply(n) for points of order
+	// ORDER (i.e. all points on the curve), and this is faster. The point must be normalized. The resulting state
+	// is usually not normalized. Constant-time with respect to both values.
+	public: void multiplyEndomorphism(const Uint256 &n);
+	
+	
+	// Multiplies this point by the given unsigned integer, like multiply() but faster. The resulting state
+	// is usually not normalized. Not constant-time, so this must only be used on public values,
+	// such as when verifying signatures.
+	public: void multiplyVartime(const Uint256 &n);
+	
+	
 	// Normalizes the coordinates of this point. Idempotent operation.
 	// Constant-time with respect to this value.
 	public: void normalize();
@@ -111,6 +144,20 @@ class CurvePoint final {
 	public: void toCompressedPoint(std::uint8_t output[33]) const;
 	
 	
+	// Writes [this*1, this*2, ..., this*len] as affine points into the given array,
+	// using one field inversion. Constant-time with respect to this value.
+	private: template <unsigned int len> void buildTable(AffinePoint table[len]) const;
+	
+	
+	// Writes [this*1, this*2, ..., this*len] as (usually not normalized) curve points
+	// into the given array. Constant-time with respect to this value.
+	private: template <unsigned int len> void buildProjectiveTable(CurvePoint table[len]) const;
+	
+	
+	// Adds the given affine point to this point, with the same result as add(). Not constant-time.
+	private: void addVartime(const AffinePoint &other);
+	
+	
 	/*---- Static functions ----*/
 	
 	// Returns a normalized public curve point for the given private exponent key.
@@ -118,12 +165,56 @@ class CurvePoint final {
 	public: static CurvePoint privateExponentToPublicPoint(const Uint256 &privExp);
 	
 	
+	// Returns u1*G + u2*p, computed with shared doublings (Strauss-Shamir trick), which is much faster than
+	// two separate multiplications. The point p must be normalized. The result is usually not normalized.
+	// Not constant-time, so this must only be used on public values, such as when verifying signatures.
+	public: static CurvePoint multiplyDualVartime(const Uint256 &u1, const CurvePoint &p, const Uint256 &u2);
+	
+	
+	// Returns scalars[0]*points[0] + ... + scalars[len-1]*points[len-1], with the doublings shared within each
+	// chunk of MULTI_CHUNK_LEN points, whose tables are normalized with one field inversion. The result is usually
+	// not normalized. Not constant-time, so this must only be used on public values, such as in batch verification.
+	public: static CurvePoint multiplyMultiVartime(const AffinePoint points[], const Uint256 scalars[], std::size_t len);
+	
+	
+	// Decodes the given compressed point (header byte 0x02 or 0x03, x-coordinate in big-endian) into a
+	// normalized point on the curve. Returns true iff successful; result is assigned iff successful.
+	// Constant-time with respect to the value if successful.
+	public: static bool fromCompressedPoint(const std::uint8_t input[33], CurvePoint &result);
+	
+	
+	// Finds the normalized point on the curve with the given x-coordinate and the given parity of y
+	// (0 for even, 1 for odd). Returns false if x is not less than the field modulus or no such point
+	// exists; result is assigned iff successful. Constant-time with respect to the values if successful.
+	public: static bool fromX(const Uint256 &x, std::uint32_t oddY, CurvePoint &result);
+	
+	
+	// Computes the normalized public points for the given private exponents, like privateExponentToPublicPoint(),
+	// but with one field inversion per MULTI_CHUNK_LEN points. Requires 0 < privExps[i] < ORDER. The arrays must
+	// not overlap. Constant-time with respect to the values.
+	public: static void privateExponentsToPublicPoints(const Uint256 privExps[], AffinePoint out[], std::size_t len);
+	
+	
+	// Returns the windowBits-wide window of bits of n starting at bit position i (counting from the
+	// least significant bit), where bits past the top of n are zero. Constant-time with respect to n.
+	private: static unsigned int getWindow(const Uint256 &n, int i, int windowBits);
+	
+	
+	// Returns [G*1, G*2, ..., G*(2^WINDOW_BITS - 1)] as affine points, which are computed on the first call
+	// and kept for the life of the program, so that multiplyDualVartime() only needs a table for its point p.
+	private: static const AffinePoint *getBaseTable();
+	
+	
 	/*---- Class constants ----*/
 	
+	public: static constexpr int WINDOW_BITS = BCL_CURVEPOINT_WINDOW_BITS;
+	public: static constexpr std::size_t MULTI_CHUNK_LEN = 8;  // Number of points per table in multiplyMultiVartime()
+	
 	public: static const FieldInt FI_ZERO;  // These FieldInt constants are declared here because they are only needed in this class,
 	public: static const FieldInt FI_ONE;   // and because of C++'s lack of guarantee of static initialization order.
 	public: static const FieldInt A;       // Curve equation parameter
 	public: static const FieldInt B;       // Curve equation parameter
+	public: static const FieldInt BETA;    // Cube root of unity, such that (BETA * x, y) = ScalarInt::LAMBDA * (x, y)
 	public: static const Uint256 ORDER;    // Order of base point, which is a prime number
 	public: static const CurvePoint G;     // Base point (normalized)
 	public: static const CurvePoint ZERO;  // Dummy point at infinity (normalized)
@@ -0,0 +1,120 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include <cassert>
+#include "DerSignature.hpp"
+
+namespace bcl {
+
+using std::uint8_t;
+using std::uint32_t;
+using std::size_t;
+
+
+bool DerSignature::decode(const uint8_t der[], size_t len, Uint256 &outR, Uint256 &outS) {
+	/* 
+	 * Format: 0x30 [total-len] 0x02 [R-len] [R] 0x02 [S-len] [S]
+	 * where total-len = len - 2 and each integer is 1 to 33 bytes long.
+	 */
+	assert(der != nullptr || len == 0);
+	if (len < MIN_LEN || len > MAX_LEN)
+		return false;
+	if (der[0] != 0x30 || der[1] != len - 2)
+		return false;
+	
+	if (der[2] != 0x02)
+		return false;
+	size_t lenR = der[3];
+	if (lenR == 0 || 5 + lenR >= len)
+		return false;
+	
+	if (der[4 + lenR] != 0x02)
+		return false;
+	size_t lenS = der[5 + lenR];
+	if (lenS == 0 || 6 + lenR + lenS != len)
+		return false;
+	
+	const uint8_t *r = &der[4];
+	const uint8_t *s = &der[6 + lenR];
+	if (!isValidInteger(r, lenR) || !isValidInteger(s, lenS))
+		return false;
+	decodeInteger(r, lenR, outR);
+	decodeInteger(s, lenS, outS);
+	return true;
+}
+
+
+size_t DerSignature::decodeBatch(const uint8_t data[], size_t dataLen,
+		Uint256 outR[], Uint256 outS[], size_t maxCount, size_t &outConsumed) {
+	assert((data != nullptr || dataLen == 0) && ((outR != nullptr && outS != nullptr) || maxCount == 0));
+	size_t count = 0;
+	size_t offset = 0;
+	while (count < maxCount && dataLen - offset >= 2) {
+		size_t len = 2 + static_cast<size_t>(data[offset + 1]);
+		if (len > dataLen - offset || !decode(&data[offset], len, outR[count], outS[count]))
+			break;
+		offset += len;
+		count++;
+	}
+	outConsumed = offset;
+	return count;
+}
+
+
+size_t DerSignature::encode(const Uint256 &r, const Uint256 &s, uint8_t out[]) {
+	assert(out != nullptr);
+	size_t len = 2;
+	len += encodeInteger(r, &out[len]);
+	len += encodeInteger(s, &out[len]);
+	out[0] = 0x30;
+	out[1] = static_cast<uint8_t>(len - 2);
+	assert(MIN_LEN <= len && len <= MAX_LEN);
+	return len;
+}
+
+
+bool DerSignature::isValidInteger(const uint8_t der[], size_t len) {
+	if ((der[0] & 0x80) != 0)
+		return false;  // Negative
+	if (len > 1 && der[0] == 0 && (der[1] & 0x80) == 0)
+		return false;  // Excess zero padding
+	return len < 33 || (len == 33 && der[0] == 0);  // Less than 2^256
+}
+
+
+void DerSignature::decodeInteger(const uint8_t der[], size_t len, Uint256 &x) {
+	assert(1 <= len && len <= 33);
+	for (int i = 0; i < Uint256::NUM_WORDS; i++)
+		x.value[i] = 0;
+	if (len == 33) {  // Skip the zero padding byte
+		der++;
+		len--;
+	}
+	for (size_t i = 0; i < len; i++)
+		x.value[i / 4] |= static_cast<uint32_t>(der[len - 1 - i]) << (i % 4 * 8);
+}
+
+
+size_t DerSignature::encodeInteger(const Uint256 &x, uint8_t out[]) {
+	// Find the number of significant bytes (at least 1), then add a zero byte if the top bit is set
+	size_t numBytes = Uint256::NUM_WORDS * 4;
+	while (numBytes > 1 && static_cast<uint8_t>(x.value[(numBytes - 1) / 4] >> ((numBytes - 1) % 4 * 8)) == 0)
+		numBytes--;
+	uint8_t top = static_cast<uint8_t>(x.value[(numBytes - 1) / 4] >> ((numBytes - 1) % 4 * 8));
+	size_t pad = (top & 0x80) != 0 ? 1 : 0;
+	out[0] = 0x02;
+	out[1] = static_cast<uint8_t>(numBytes + pad);
+	if (pad == 1)
+		out[2] = 0;
+	for (size_t i = 0; i < numBytes; i++)
+		out[2 + pad + i] = static_cast<uint8_t>(x.value[(numBytes - 1 - i) / 4] >> ((numBytes - 1 - i) % 4 * 8));
+	return 2 + pad + numBytes;
+}
+
+
+}  // namespace bcl
@@ -0,0 +1,75 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "Uint256.hpp"
+
+namespace bcl {
+
+
+/* 
+ * Converts an ECDSA signature (r, s) to and from the strict DER encoding required by BIP 66,
+ * without a trailing sighash type byte. Parsing reads the integers straight into the words of
+ * the output Uint256 values, and serialization writes straight into the caller's buffer.
+ * Provides only static functions.
+ */
+class DerSignature final {
+	
+	/*---- Public functions ----*/
+	
+	// Parses the given DER-encoded signature, which must be exactly len bytes long and follow every
+	// BIP 66 rule (minimal lengths, no negative numbers, no excess zero padding). If it is valid, then
+	// r and s are set to the decoded values and true is returned. Otherwise r and s are unchanged and false
+	// is returned. The decoded values are not range-checked against CurvePoint::ORDER. Not constant-time.
+	public: static bool decode(const std::uint8_t der[], std::size_t len, Uint256 &outR, Uint256 &outS);
+	
+	
+	// Parses consecutive DER-encoded signatures from the given buffer (each one is delimited by its
+	// length byte) into outR[i] and outS[i], stopping at maxCount signatures, at the end of the buffer,
+	// or at the first invalid signature. Returns the number of signatures decoded, and sets outConsumed
+	// to the number of bytes they occupy (so the next signature, if any, starts at data[outConsumed]).
+	// Not constant-time.
+	public: static std::size_t decodeBatch(const std::uint8_t data[], std::size_t dataLen,
+		Uint256 outR[], Uint256 outS[], std::size_t maxCount, std::size_t &outConsumed);
+	
+	
+	// Writes the DER encoding of the signature (r, s) to the given buffer, and returns its length
+	// (between 8 and MAX_LEN bytes, inclusive). Not constant-time.
+	public: static std::size_t encode(const Uint256 &r, const Uint256 &s, std::uint8_t out[]);
+	
+	
+	/*---- Private helper functions ----*/
+	
+	// Checks the INTEGER element of the given length starting at der[0] (its content, after the tag and length bytes).
+	private: static bool isValidInteger(const std::uint8_t der[], std::size_t len);
+	
+	
+	// Sets x to the big-endian unsigned integer of the given length, which must be at most 33 bytes
+	// and have a value less than 2^256.
+	private: static void decodeInteger(const std::uint8_t der[], std::size_t len, Uint256 &x);
+	
+	
+	// Writes the INTEGER element (tag, length, and content) of x, and returns its total length.
+	private: static std::size_t encodeInteger(const Uint256 &x, std::uint8_t out[]);
+	
+	
+	DerSignature() = delete;  // Not instantiable
+	
+	
+	/*---- Class constants ----*/
+	
+	public: static constexpr std::size_t MIN_LEN = 8;
+	public: static constexpr std::size_t MAX_LEN = 72;
+	
+};
+
+
+}  // namespace bcl
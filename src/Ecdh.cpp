@@ -0,0 +1,48 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include <cassert>
+#include <cstring>
+#include "Ecdh.hpp"
+#include "Sha256.hpp"
+#include "Sha256Hash.hpp"
+
+namespace bcl {
+
+using std::uint8_t;
+
+
+bool Ecdh::sharedSecret(const Uint256 &privateKey, const uint8_t publicKey[33], uint8_t outSecret[32]) {
+	assert(publicKey != nullptr);
+	CurvePoint p = CurvePoint::ZERO;
+	if (!CurvePoint::fromCompressedPoint(publicKey, p))
+		return false;
+	return sharedSecret(privateKey, p, outSecret);
+}
+
+
+bool Ecdh::sharedSecret(const Uint256 &privateKey, const CurvePoint &publicKey, uint8_t outSecret[32]) {
+	assert(outSecret != nullptr);
+	if (privateKey == Uint256::ZERO || privateKey >= CurvePoint::ORDER)
+		return false;
+	if (publicKey.z != CurvePoint::FI_ONE || !publicKey.isOnCurve())
+		return false;
+	
+	// The product is never zero, because the private key is in range and the curve order is prime
+	CurvePoint p = publicKey;
+	p.multiplyEndomorphism(privateKey);
+	p.normalize();
+	uint8_t x[32];
+	p.x.getBigEndianBytes(x);
+	const Sha256Hash hash = Sha256::getHash(x, sizeof(x));
+	std::memcpy(outSecret, hash.value, Sha256Hash::HASH_LEN);
+	return true;
+}
+
+
+}  // namespace bcl
@@ -0,0 +1,43 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "CurvePoint.hpp"
+#include "Uint256.hpp"
+
+namespace bcl {
+
+
+/* 
+ * Performs elliptic curve Diffie-Hellman key agreement on secp256k1. The shared secret is
+ * the SHA-256 hash of the 32-byte big-endian x-coordinate of privateKey * publicKey.
+ * Provides only static functions.
+ */
+class Ecdh final {
+	
+	// Computes the shared secret of the given private key and the given public key in compressed format
+	// (see CurvePoint::toCompressedPoint()). Returns true iff successful, i.e. the private key is in the range
+	// [1, CurvePoint::ORDER) and the public key is a valid point; the output is assigned iff successful.
+	// Constant-time with respect to the private key, and with respect to the public key if it is valid.
+	public: static bool sharedSecret(const Uint256 &privateKey, const std::uint8_t publicKey[33], std::uint8_t outSecret[32]);
+	
+	
+	// Computes the shared secret of the given private key and the given public key, which must be normalized.
+	// Returns true iff successful, i.e. the private key is in the range [1, CurvePoint::ORDER) and the public key
+	// is on the curve; the output is assigned iff successful. Constant-time with respect to both values.
+	public: static bool sharedSecret(const Uint256 &privateKey, const CurvePoint &publicKey, std::uint8_t outSecret[32]);
+	
+	
+	Ecdh() = delete;  // Not instantiable
+	
+};
+
+
+}  // namespace bcl
@@ -9,8 +9,11 @@
 #include <cassert>
 #include <cstdint>
 #include <cstring>
+#include "AffinePoint.hpp"
 #include "Ecdsa.hpp"
 #include "FieldInt.hpp"
+#include "Rfc6979.hpp"
+#include "ScalarInt.hpp"
 #include "Sha256.hpp"
 
 namespace bcl {
@@ -20,6 +23,12 @@ using std::uint32_t;
 
 
 bool Ecdsa::sign(const Uint256 &privateKey, const Sha256Hash &msgHash, const Uint256 &nonce, Uint256 &outR, Uint256 &outS) {
+	uint8_t recId;
+	return sign(privateKey, msgHash, nonce, outR, outS, recId);
+}
+
+
+bool Ecdsa::sign(const Uint256 &privateKey, const Sha256Hash &msgHash, const Uint256 &nonce, Uint256 &outR, Uint256 &outS, uint8_t &outRecId) {
 	/* 
 	 * Algorithm pseudocode:
 	 * if (nonce outside range [1, order-1]) return false
@@ -29,15 +38,25 @@ bool Ecdsa::sign(const Uint256 &privateKey, const Sha256Hash &msgHash, const Uin
 	 * s = nonce^-1 * (msgHash + r * privateKey) % order
 	 * if (s == 0) return false
 	 * s = min(s, order - s)
+	 * recId = (p.y % 2) ^ (s was negated) + (p.x >= order ? 2 : 0)
 	 */
 	
 	const Uint256 &order = CurvePoint::ORDER;
-	const Uint256 &zero = Uint256::ZERO;
-	if (nonce == zero || nonce >= order)
+	if (nonce == Uint256::ZERO || nonce >= order)
 		return false;
 	
 	const CurvePoint p = CurvePoint::privateExponentToPublicPoint(nonce);
+	Uint256 kInv = nonce;
+	kInv.reciprocal(order);
+	return signWithPoint(privateKey, msgHash, AffinePoint(p), kInv, outR, outS, outRecId);
+}
+
+
+bool Ecdsa::signWithPoint(const Uint256 &privateKey, const Sha256Hash &msgHash, const AffinePoint &p, const Uint256 &kInv, Uint256 &outR, Uint256 &outS, uint8_t &outRecId) {
+	const Uint256 &order = CurvePoint::ORDER;
+	const Uint256 &zero = Uint256::ZERO;
 	Uint256 r(p.x);
+	uint32_t recId = static_cast<uint32_t>(r >= order) << 1 | (p.y.value[0] & 1);
 	r.subtract(order, static_cast<uint32_t>(r >= order));
 	if (r == zero)
 		return false;
@@ -49,27 +68,103 @@ bool Ecdsa::sign(const Uint256 &privateKey, const Sha256Hash &msgHash, const Uin
 	uint32_t carry = s.add(z);
 	s.subtract(order, carry | static_cast<uint32_t>(s >= order));
 	
-	Uint256 kInv = nonce;
-	kInv.reciprocal(order);
 	multiplyModOrder(s, kInv);
 	if (s == zero)
 		return false;
 	
 	Uint256 negS = order;
 	negS.subtract(s);
-	s.replace(negS, static_cast<uint32_t>(negS < s));  // To ensure low S values for BIP 62
+	uint32_t negate = static_cast<uint32_t>(negS < s);
+	s.replace(negS, negate);  // To ensure low S values for BIP 62
+	recId ^= negate;  // Negating s corresponds to negating the nonce point
 	outR = r;
 	outS = s;
+	outRecId = static_cast<uint8_t>(recId);
 	return true;
 }
 
 
 bool Ecdsa::signWithHmacNonce(const Uint256 &privateKey, const Sha256Hash &msgHash, Uint256 &outR, Uint256 &outS) {
-	uint8_t privkeyBytes[Uint256::NUM_WORDS * 4];
-	privateKey.getBigEndianBytes(privkeyBytes);
-	const Sha256Hash hmac = Sha256::getHmac(privkeyBytes, sizeof(privkeyBytes), msgHash.value, Sha256Hash::HASH_LEN);
-	const Uint256 nonce(hmac.value);
-	return sign(privateKey, msgHash, nonce, outR, outS);
+	uint8_t recId;
+	return signWithHmacNonce(privateKey, msgHash, outR, outS, recId);
+}
+
+
+bool Ecdsa::signWithHmacNonce(const Uint256 &privateKey, const Sha256Hash &msgHash, Uint256 &outR, Uint256 &outS, uint8_t &outRecId) {
+	return sign(privateKey, msgHash, getHmacNonce(privateKey, msgHash), outR, outS, outRecId);
+}
+
+
+bool Ecdsa::signWithRfc6979(const Uint256 &privateKey, const Sha256Hash &msgHash, Uint256 &outR, Uint256 &outS) {
+	uint8_t recId;
+	return signWithRfc6979(privateKey, msgHash, nullptr, 0, outR, outS, recId);
+}
+
+
+bool Ecdsa::signWithRfc6979(const Uint256 &privateKey, const Sha256Hash &msgHash, const uint8_t extraEntropy[], std::size_t extraLen, Uint256 &outR, Uint256 &outS, uint8_t &outRecId) {
+	if (privateKey == Uint256::ZERO || privateKey >= CurvePoint::ORDER)
+		return false;
+	Rfc6979 generator(privateKey, msgHash, extraEntropy, extraLen);
+	while (true) {
+		if (sign(privateKey, msgHash, generator.next(), outR, outS, outRecId))
+			return true;
+	}
+}
+
+
+bool Ecdsa::signBatch(const Uint256 privateKeys[], const Sha256Hash msgHashes[], Uint256 outR[], Uint256 outS[], std::size_t len) {
+	/* 
+	 * For each chunk of signatures, this does the same steps as signWithHmacNonce(), except:
+	 * - The nonce points are normalized together by CurvePoint::privateExponentsToPublicPoints().
+	 * - All nonces are inverted together with Montgomery's trick: with prefix products
+	 *   q[i] = k[0] * ... * k[i], one inversion gives q[n-1]^-1, and then going backward,
+	 *   k[i]^-1 = q[n-1]^-1 * ... * k[i+1] * q[i-1].
+	 */
+	assert((privateKeys != nullptr && msgHashes != nullptr && outR != nullptr && outS != nullptr) || len == 0);
+	const Uint256 &order = CurvePoint::ORDER;
+	for (std::size_t start = 0; start < len; start += SIGN_BATCH_CHUNK_LEN) {
+		std::size_t count = len - start < SIGN_BATCH_CHUNK_LEN ? len - start : SIGN_BATCH_CHUNK_LEN;
+		Uint256 nonces[SIGN_BATCH_CHUNK_LEN];
+		Uint256 prefix[SIGN_BATCH_CHUNK_LEN];
+		for (std::size_t i = 0; i < count; i++) {
+			nonces[i] = getHmacNonce(privateKeys[start + i], msgHashes[start + i]);
+			if (nonces[i] == Uint256::ZERO || nonces[i] >= order)
+				return false;
+			ScalarInt q(nonces[i]);
+			if (i > 0)
+				q.multiply(ScalarInt(prefix[i - 1]));
+			prefix[i] = Uint256(q);
+		}
+		AffinePoint points[SIGN_BATCH_CHUNK_LEN];
+		CurvePoint::privateExponentsToPublicPoints(nonces, points, count);
+		
+		ScalarInt inverse(prefix[count - 1]);
+		inverse.reciprocal();
+		for (std::size_t i = count; i-- > 0; ) {
+			ScalarInt kInv = inverse;
+			if (i > 0) {
+				kInv.multiply(ScalarInt(prefix[i - 1]));
+				inverse.multiply(ScalarInt(nonces[i]));
+			}
+			uint8_t recId;
+			if (!signWithPoint(privateKeys[start + i], msgHashes[start + i], points[i], Uint256(kInv), outR[start + i], outS[start + i], recId))
+				return false;
+		}
+	}
+	return true;
+}
+
+
+bool Ecdsa::signRecoverable(const Uint256 &privateKey, const Sha256Hash &msgHash, uint8_t outSig[65]) {
+	assert(outSig != nullptr);
+	Uint256 r, s;
+	uint8_t recId;
+	if (!signWithHmacNonce(privateKey, msgHash, r, s, recId))
+		return false;
+	r.getBigEndianBytes(&outSig[0]);
+	s.getBigEndianBytes(&outSig[32]);
+	outSig[64] = recId;
+	return true;
 }
 
 
@@ -91,7 +186,7 @@ bool Ecdsa::verify(const CurvePoint &publicKey, const Sha256Hash &msgHash, const
 	const Uint256 &order = CurvePoint::ORDER;
 	const Uint256 &zero = Uint256::ZERO;
 	CurvePoint q = publicKey;
-	q.multiply(CurvePoint::ORDER);
+	q.multiplyVartime(CurvePoint::ORDER);
 	if (!(zero < r && r < order && zero < s && s < order))
 		return false;
 	if (publicKey.isZero() || publicKey.z != CurvePoint::FI_ONE || !publicKey.isOnCurve() || !q.isZero())
@@ -105,11 +200,7 @@ bool Ecdsa::verify(const CurvePoint &publicKey, const Sha256Hash &msgHash, const
 	multiplyModOrder(u1, z);
 	multiplyModOrder(u2, r);
 	
-	CurvePoint p = CurvePoint::G;
-	q = publicKey;
-	p.multiply(u1);
-	q.multiply(u2);
-	p.add(q);
+	CurvePoint p = CurvePoint::multiplyDualVartime(u1, publicKey, u2);
 	p.normalize();
 	
 	Uint256 px(p.x);
@@ -118,32 +209,71 @@ bool Ecdsa::verify(const CurvePoint &publicKey, const Sha256Hash &msgHash, const
 }
 
 
-void Ecdsa::multiplyModOrder(Uint256 &x, const Uint256 &y) {
+bool Ecdsa::recoverPublicKey(const Sha256Hash &msgHash, const Uint256 &r, const Uint256 &s, uint8_t recId, CurvePoint &outPublicKey) {
 	/* 
-	 * Russian peasant multiplication with modular reduction at each step. Algorithm pseudocode:
-	 * z = 0
-	 * for (i = 255 .. 0) {
-	 *   z = (z * 2) % order
-	 *   if (y.bit[i] == 1)
-	 *     z = (z + x) % order
-	 * }
-	 * x = z
+	 * Algorithm pseudocode:
+	 * if (!(0 < r, s < order) || recId >= 4)
+	 *   return false
+	 * x = r + (recId >= 2 ? order : 0)
+	 * rp = the point with x-coordinate x and y parity (recId % 2), or fail
+	 * w = r^-1 % order
+	 * u1 = (-msgHash * w) % order
+	 * u2 = (s * w) % order
+	 * pubKey = u1 * G + u2 * rp
+	 * return pubKey != zero
 	 */
-	const Uint256 &mod = CurvePoint::ORDER;
-	assert(&x != &y && x < mod);
-	Uint256 z = Uint256::ZERO;
 	
-	for (int i = Uint256::NUM_WORDS * 32 - 1; i >= 0; i--) {
-		// Multiply by 2
-		uint32_t c = z.shiftLeft1();
-		z.subtract(mod, c | static_cast<uint32_t>(z >= mod));
-		// Conditionally add x
-		uint32_t enable = (y.value[i >> 5] >> (i & 31)) & 1;
-		c = z.add(x, enable);
-		z.subtract(mod, c | static_cast<uint32_t>(z >= mod));
-		assert(z < mod);
-	}
-	x = z;
+	const Uint256 &order = CurvePoint::ORDER;
+	const Uint256 &zero = Uint256::ZERO;
+	if (!(zero < r && r < order && zero < s && s < order) || recId >= 4)
+		return false;
+	
+	Uint256 x = r;
+	if ((recId & 2) != 0 && x.add(order) != 0)
+		return false;
+	CurvePoint rp = CurvePoint::ZERO;
+	if (!CurvePoint::fromX(x, recId & 1U, rp))
+		return false;
+	
+	Uint256 w = r;
+	w.reciprocal(order);
+	Uint256 z(msgHash.value);
+	z.subtract(order, static_cast<uint32_t>(z >= order));
+	Uint256 u1 = order;
+	u1.subtract(z);
+	u1.subtract(order, static_cast<uint32_t>(u1 >= order));  // For z = 0
+	Uint256 u2 = s;
+	multiplyModOrder(u1, w);
+	multiplyModOrder(u2, w);
+	
+	CurvePoint p = CurvePoint::multiplyDualVartime(u1, rp, u2);
+	if (p.isZero())
+		return false;
+	p.normalize();
+	outPublicKey = p;
+	return true;
+}
+
+
+bool Ecdsa::recoverPublicKey(const Sha256Hash &msgHash, const uint8_t sig[65], CurvePoint &outPublicKey) {
+	assert(sig != nullptr);
+	return recoverPublicKey(msgHash, Uint256(&sig[0]), Uint256(&sig[32]), sig[64], outPublicKey);
+}
+
+
+Uint256 Ecdsa::getHmacNonce(const Uint256 &privateKey, const Sha256Hash &msgHash) {
+	uint8_t privkeyBytes[Uint256::NUM_WORDS * 4];
+	privateKey.getBigEndianBytes(privkeyBytes);
+	const Sha256Hash hmac = Sha256::getHmac(privkeyBytes, sizeof(privkeyBytes), msgHash.value, Sha256Hash::HASH_LEN);
+	return Uint256(hmac.value);
+}
+
+
+void Ecdsa::multiplyModOrder(Uint256 &x, const Uint256 &y) {
+	assert(&x != &y && x < CurvePoint::ORDER);
+	ScalarInt z(x);
+	z.multiply(ScalarInt(y));  // The constructor reduces y
+	x = Uint256(z);
 }
 
 
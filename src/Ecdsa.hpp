@@ -8,6 +8,9 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include "AffinePoint.hpp"
 #include "CurvePoint.hpp"
 #include "Sha256Hash.hpp"
 #include "Uint256.hpp"
@@ -16,7 +19,11 @@ namespace bcl {
 
 
 /* 
- * Performs ECDSA signature generation and verification. Provides just three static functions.
+ * Performs ECDSA signature generation, verification, and public key recovery. Provides only static functions.
+ * 
+ * A recoverable signature carries a recovery ID in [0, 4) besides (r, s): bit 0 is the parity of the y-coordinate
+ * of the nonce point, and bit 1 is set iff its x-coordinate was at least CurvePoint::ORDER (which has vanishing
+ * probability). Its compact form is 65 bytes: r (32 bytes big-endian), s (32 bytes big-endian), recovery ID.
  */
 class Ecdsa final {
 	
@@ -36,17 +43,77 @@ class Ecdsa final {
 	public: static bool signWithHmacNonce(const Uint256 &privateKey, const Sha256Hash &msgHash, Uint256 &outR, Uint256 &outS);
 	
 	
+	// Same as sign(), but also computes the recovery ID of the signature (in the range [0, 4)),
+	// which is assigned iff signing is successful. This has the same constant-time behavior as sign().
+	public: static bool sign(const Uint256 &privateKey, const Sha256Hash &msgHash, const Uint256 &nonce, Uint256 &outR, Uint256 &outS, std::uint8_t &outRecId);
+	
+	
+	// Same as signWithHmacNonce(), but also computes the recovery ID of the signature.
+	// This has the same constant-time behavior as sign().
+	public: static bool signWithHmacNonce(const Uint256 &privateKey, const Sha256Hash &msgHash, Uint256 &outR, Uint256 &outS, std::uint8_t &outRecId);
+	
+	
+	// Computes the nonce with RFC 6979 (see Rfc6979), and then performs ECDSA signing, retrying with the next
+	// RFC 6979 nonce in the vanishingly unlikely case that the nonce is rejected. The signatures are the standard
+	// deterministic ones (as produced by libsecp256k1, with low s). Returns false iff the private key is outside
+	// the range [1, CurvePoint::ORDER). This has the same constant-time behavior as sign().
+	public: static bool signWithRfc6979(const Uint256 &privateKey, const Sha256Hash &msgHash, Uint256 &outR, Uint256 &outS);
+	
+	
+	// Same as signWithRfc6979(), but with extra entropy (which may be null iff extraLen is 0) mixed into the
+	// nonce as in RFC 6979 section 3.6, and also computes the recovery ID of the signature.
+	public: static bool signWithRfc6979(const Uint256 &privateKey, const Sha256Hash &msgHash, const std::uint8_t extraEntropy[], std::size_t extraLen, Uint256 &outR, Uint256 &outS, std::uint8_t &outRecId);
+	
+	
+	// Signs each msgHashes[i] with privateKeys[i] for 0 <= i < len, with the same results as signWithHmacNonce() but
+	// faster, because each chunk of SIGN_BATCH_CHUNK_LEN signatures shares the inversions of the nonces and the
+	// normalizations of the nonce points. Returns true iff all signings are successful (with overwhelming
+	// probability); if not, some outputs may be unassigned and signWithHmacNonce() should be used for each entry.
+	// Constant-time with respect to all the input values, like signWithHmacNonce().
+	public: static bool signBatch(const Uint256 privateKeys[], const Sha256Hash msgHashes[], Uint256 outR[], Uint256 outS[], std::size_t len);
+	
+	
+	// Same as sign() with a recovery ID, but takes the nonce point p = nonce * G (affine) and kInv = nonce^-1 mod
+	// CurvePoint::ORDER that the caller precomputed (e.g. NoncePool), so only a few scalar operations remain.
+	// The caller is responsible for the nonce being valid, secret, and never used again.
+	// This has the same constant-time behavior as sign().
+	public: static bool signWithPoint(const Uint256 &privateKey, const Sha256Hash &msgHash, const AffinePoint &p, const Uint256 &kInv, Uint256 &outR, Uint256 &outS, std::uint8_t &outRecId);
+	
+	
+	// Same as signWithHmacNonce(), but writes the 65-byte compact recoverable signature (r, s, recovery ID).
+	// The output is assigned iff signing is successful. This has the same constant-time behavior as sign().
+	public: static bool signRecoverable(const Uint256 &privateKey, const Sha256Hash &msgHash, std::uint8_t outSig[65]);
+	
+	
 	// Checks whether the given signature, message, and public key are valid together. The public key point
 	// must be normalized. This function does not need to be constant-time because all inputs are public.
 	public: static bool verify(const CurvePoint &publicKey, const Sha256Hash &msgHash, const Uint256 &r, const Uint256 &s);
 	
 	
+	// Computes the public key that produced the given signature on the given message hash, and returns
+	// true iff successful. The resulting point is normalized, and is assigned iff successful. A successful
+	// recovery does not by itself prove anything; the caller must check that the recovered key is the
+	// expected one (e.g. by comparing its address). Not constant-time, because all inputs are public.
+	public: static bool recoverPublicKey(const Sha256Hash &msgHash, const Uint256 &r, const Uint256 &s, std::uint8_t recId, CurvePoint &outPublicKey);
+	
+	
+	// Same as the other recoverPublicKey(), but takes a 65-byte compact recoverable signature (r, s, recovery ID).
+	public: static bool recoverPublicKey(const Sha256Hash &msgHash, const std::uint8_t sig[65], CurvePoint &outPublicKey);
+	
+	
+	// Returns the HMAC-SHA-256 of the message hash with the private key, as used by signWithHmacNonce().
+	private: static Uint256 getHmacNonce(const Uint256 &privateKey, const Sha256Hash &msgHash);
+	
+	
 	// Computes x = (x * y) % CurvePoint::ORDER. Requires x < CurvePoint::ORDER, but y is unrestricted.
 	private: static void multiplyModOrder(Uint256 &x, const Uint256 &y);
 	
 	
 	Ecdsa() = delete;  // Not instantiable
 	
+	
+	public: static constexpr std::size_t SIGN_BATCH_CHUNK_LEN = 16;  // Number of signatures sharing a nonce inversion in signBatch()
+	
 };
 
 
@@ -8,8 +8,11 @@
 
 #if defined(BCL_USE_EXTENDED_PRIVATEKEY)
 
+#include <cassert>
 #include <cstring>
+#include "CurvePoint.hpp"
 #include "ExtendedPrivateKey.hpp"
+#include "HmacSha512.hpp"
 #include "Ripemd160.hpp"
 #include "Sha256.hpp"
 #include "Sha256Hash.hpp"
@@ -20,11 +23,12 @@ namespace bcl {
 
 using std::uint8_t;
 using std::uint32_t;
+using std::size_t;
 
 
 ExtendedPrivateKey::ExtendedPrivateKey() :
 	privateKey(Uint256::ZERO),
-	publicKey(CurvePoint::ZERO),
+	publicKey(AffinePoint::ZERO),
 	chainCode(),
 	depth(0),
 	index(0),
@@ -44,6 +48,50 @@ ExtendedPrivateKey::ExtendedPrivateKey(
 
 ExtendedPrivateKey ExtendedPrivateKey::getChildKey(uint32_t index) const {
 	uint8_t msg[37];
+	getChildMessage(index, msg);
+	uint8_t hash[Sha512::HASH_LEN];
+	HmacSha512(chainCode, sizeof(chainCode)).getHmac(msg, sizeof(msg), hash);
+	uint8_t pubKeyHash[4];
+	getPublicKeyHash(pubKeyHash);
+	ExtendedPrivateKey result = getChildKey(index, hash, pubKeyHash);
+	Utils::clearBytes(msg, sizeof(msg));
+	Utils::clearBytes(hash, sizeof(hash));
+	return result;
+}
+
+
+void ExtendedPrivateKey::getChildKeys(const uint32_t indices[], size_t n, ExtendedPrivateKey out[]) const {
+	assert((indices != nullptr && out != nullptr) || n == 0);
+	if (n == 0)
+		return;
+	const HmacSha512 hmac(chainCode, sizeof(chainCode));
+	uint8_t pubKeyHash[4];
+	getPublicKeyHash(pubKeyHash);
+	
+	constexpr size_t GROUP = 16;
+	const HmacSha512 *keys[GROUP];
+	uint8_t msgs[GROUP][37];
+	const uint8_t *msgPtrs[GROUP];
+	size_t msgLens[GROUP];
+	uint8_t hashes[GROUP][Sha512::HASH_LEN];
+	for (size_t start = 0; start < n; start += GROUP) {
+		size_t count = n - start < GROUP ? n - start : GROUP;
+		for (size_t i = 0; i < count; i++) {
+			getChildMessage(indices[start + i], msgs[i]);
+			keys[i] = &hmac;
+			msgPtrs[i] = msgs[i];
+			msgLens[i] = sizeof(msgs[i]);
+		}
+		HmacSha512::getHmacs(keys, msgPtrs, msgLens, count, hashes);
+		for (size_t i = 0; i < count; i++)
+			out[start + i] = getChildKey(indices[start + i], hashes[i], pubKeyHash);
+	}
+	Utils::clearBytes(msgs, sizeof(msgs));
+	Utils::clearBytes(hashes, sizeof(hashes));
+}
+
+
+void ExtendedPrivateKey::getChildMessage(uint32_t index, uint8_t msg[37]) const {
 	if (index < HARDEN)  // Normal child key
 		publicKey.toCompressedPoint(msg);
 	else {  // Hardened child key
@@ -51,9 +99,10 @@ ExtendedPrivateKey ExtendedPrivateKey::getChildKey(uint32_t index) const {
 		privateKey.getBigEndianBytes(&msg[1]);
 	}
 	Utils::storeBigUint32(index, &msg[33]);
-	uint8_t hash[Sha512::HASH_LEN];
-	Sha512::getHmac(chainCode, sizeof(chainCode) / sizeof(chainCode[0]), msg, sizeof(msg) / sizeof(msg[0]), hash);
-	
+}
+
+
+ExtendedPrivateKey ExtendedPrivateKey::getChildKey(uint32_t index, const uint8_t hash[Sha512::HASH_LEN], const uint8_t pubKeyHash[4]) const {
 	Uint256 num(hash);
 	if (num >= CurvePoint::ORDER)
 		return ExtendedPrivateKey();
@@ -61,13 +110,17 @@ ExtendedPrivateKey ExtendedPrivateKey::getChildKey(uint32_t index) const {
 	num.subtract(CurvePoint::ORDER, carry | static_cast<uint32_t>(num >= CurvePoint::ORDER));
 	if (num == Uint256::ZERO)
 		return ExtendedPrivateKey();
-	
+	return ExtendedPrivateKey(num, &hash[32], static_cast<uint8_t>(depth + 1), index, pubKeyHash);
+}
+
+
+void ExtendedPrivateKey::getPublicKeyHash(uint8_t out[4]) const {
 	uint8_t pubKeyBytes[33];
 	publicKey.toCompressedPoint(pubKeyBytes);
 	Sha256Hash innerHash = Sha256::getHash(pubKeyBytes, sizeof(pubKeyBytes) / sizeof(pubKeyBytes[0]));
 	uint8_t pubKeyHash[Ripemd160::HASH_LEN];
 	Ripemd160::getHash(innerHash.value, Sha256Hash::HASH_LEN, pubKeyHash);
-	return ExtendedPrivateKey(num, &hash[32], static_cast<uint8_t>(depth + 1), index, pubKeyHash);
+	std::memcpy(out, pubKeyHash, 4);
 }
 
 
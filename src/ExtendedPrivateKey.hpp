@@ -10,8 +10,10 @@
 
 #if defined(BCL_USE_EXTENDED_PRIVATEKEY)
 
+#include <cstddef>
 #include <cstdint>
-#include "CurvePoint.hpp"
+#include "AffinePoint.hpp"
+#include "Sha512.hpp"
 #include "Uint256.hpp"
 
 namespace bcl {
@@ -25,7 +27,7 @@ class ExtendedPrivateKey final {
 	/*---- Fields ----*/
 	
 	public: Uint256 privateKey;
-	public: CurvePoint publicKey;
+	public: AffinePoint publicKey;
 	
 	public: std::uint8_t chainCode[32];
 	public: std::uint8_t depth;
@@ -49,6 +51,23 @@ class ExtendedPrivateKey final {
 	
 	public: ExtendedPrivateKey getChildKey(std::uint32_t index) const;
 	
+	
+	// Sets out[i] = getChildKey(indices[i]) for 0 <= i < n. The HMAC-SHA-512 context keyed by the chain code and the
+	// parent public key hash are computed once for all the children, and the HMACs run in SIMD lanes (see HmacSha512::getHmacs()).
+	public: void getChildKeys(const std::uint32_t indices[], std::size_t n, ExtendedPrivateKey out[]) const;
+	
+	
+	// Sets msg to the HMAC message for the child key with the given index.
+	private: void getChildMessage(std::uint32_t index, std::uint8_t msg[37]) const;
+	
+	
+	// Returns the child key with the given index, given its HMAC value and this key's public key hash.
+	private: ExtendedPrivateKey getChildKey(std::uint32_t index, const std::uint8_t hash[Sha512::HASH_LEN], const std::uint8_t pubKeyHash[4]) const;
+	
+	
+	// Returns the first 4 bytes of RIPEMD-160(SHA-256(compressed public key)), the parent fingerprint of the children.
+	private: void getPublicKeyHash(std::uint8_t out[4]) const;
+	
 };
 
 
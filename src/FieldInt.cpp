@@ -146,6 +146,65 @@ void FieldInt::reciprocal() {
 }
 
 
+bool FieldInt::sqrt() {
+	/* 
+	 * Because MODULUS = 3 mod 4, a root is this^((MODULUS + 1) / 4) if one exists. The exponent
+	 * has the binary form 1{223} 0 1{22} 0000 11 00, which is computed with this addition chain,
+	 * where xN denotes this^(2^N - 1), i.e. a run of N one bits. Algorithm pseudocode:
+	 * x2 = x1^2 * x1, x3 = x2^2 * x1, x6 = x3^(2^3) * x3, x9 = x6^(2^3) * x3,
+	 * x11 = x9^(2^2) * x2, x22 = x11^(2^11) * x11, x44 = x22^(2^22) * x22,
+	 * x88 = x44^(2^44) * x44, x176 = x88^(2^88) * x88, x220 = x176^(2^44) * x44,
+	 * x223 = x220^(2^3) * x3, result = ((x223^(2^23) * x22)^(2^6) * x2)^(2^2)
+	 * return result^2 == this
+	 */
+	const FieldInt x1 = *this;
+	FieldInt x2 = x1;
+	x2.square();
+	x2.multiply(x1);
+	FieldInt x3 = x2;
+	x3.square();
+	x3.multiply(x1);
+	FieldInt t = x3;
+	t.squareRepeat(3);
+	t.multiply(x3);  // x6
+	t.squareRepeat(3);
+	t.multiply(x3);  // x9
+	t.squareRepeat(2);
+	t.multiply(x2);
+	const FieldInt x11 = t;
+	t.squareRepeat(11);
+	t.multiply(x11);
+	const FieldInt x22 = t;
+	t.squareRepeat(22);
+	t.multiply(x22);
+	const FieldInt x44 = t;
+	t.squareRepeat(44);
+	t.multiply(x44);
+	const FieldInt x88 = t;
+	t.squareRepeat(88);
+	t.multiply(x88);  // x176
+	t.squareRepeat(44);
+	t.multiply(x44);  // x220
+	t.squareRepeat(3);
+	t.multiply(x3);   // x223
+	t.squareRepeat(23);
+	t.multiply(x22);
+	t.squareRepeat(6);
+	t.multiply(x2);
+	t.squareRepeat(2);
+	
+	*this = t;
+	t.square();
+	return t == x1;
+}
+
+
+void FieldInt::squareRepeat(int n) {
+	for (int i = 0; i < n; i++)
+		square();
+}
+
+
 void FieldInt::replace(const FieldInt &other, uint32_t enable) {
 	Uint256::replace(other, enable);
 }
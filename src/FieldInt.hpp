@@ -73,6 +73,16 @@ class FieldInt final : private Uint256 {
 	public: void reciprocal();
 	
 	
+	// Computes a square root of this number with respect to the modulus, and returns true iff this number
+	// is a quadratic residue (i.e. has a square root). If not, the resulting value is unspecified. The parity
+	// of the resulting root is unspecified. Constant-time with respect to this value.
+	public: bool sqrt();
+	
+	
+	// Squares this number n times, modulo the prime. Constant-time with respect to this value.
+	private: void squareRepeat(int n);
+	
+	
 	/*---- Miscellaneous methods ----*/
 	
 	public: void replace(const FieldInt &other, std::uint32_t enable);
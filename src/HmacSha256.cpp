@@ -0,0 +1,72 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include <cassert>
+#include <cstring>
+#include "HmacSha256.hpp"
+#include "Utils.hpp"
+
+namespace bcl {
+
+using std::uint8_t;
+using std::uint64_t;
+using std::size_t;
+
+
+HmacSha256::HmacSha256(const uint8_t key[], size_t keyLen) {
+	assert(key != nullptr || keyLen == 0);
+	
+	// Preprocess key
+	uint8_t tempKey[Sha256::BLOCK_LEN] = {};
+	if (keyLen <= Sha256::BLOCK_LEN)
+		Utils::copyBytes(tempKey, key, keyLen);
+	else {
+		const Sha256Hash keyHash = Sha256::getHash(key, keyLen);
+		std::memcpy(tempKey, keyHash.value, Sha256Hash::HASH_LEN);
+	}
+	
+	// Compress the inner and outer pads, each of which is exactly one block, into the initial state
+	uint64_t length;
+	Sha256().getMidstate(innerMidstate, length);
+	std::memcpy(outerMidstate, innerMidstate, sizeof(outerMidstate));
+	for (int i = 0; i < Sha256::BLOCK_LEN; i++)
+		tempKey[i] ^= 0x36;
+	Sha256::compress(innerMidstate, tempKey);
+	for (int i = 0; i < Sha256::BLOCK_LEN; i++)
+		tempKey[i] ^= 0x36 ^ 0x5C;
+	Sha256::compress(outerMidstate, tempKey);
+	Utils::clearBytes(tempKey, sizeof(tempKey));
+}
+
+
+HmacSha256::~HmacSha256() {
+	Utils::clearBytes(innerMidstate, sizeof(innerMidstate));
+	Utils::clearBytes(outerMidstate, sizeof(outerMidstate));
+}
+
+
+Sha256Hash HmacSha256::getHmac(const uint8_t msg[], size_t msgLen) const {
+	Sha256 hasher = getInnerHasher();
+	return finish(hasher.append(msg, msgLen));
+}
+
+
+Sha256 HmacSha256::getInnerHasher() const {
+	return Sha256(innerMidstate, Sha256::BLOCK_LEN);
+}
+
+
+Sha256Hash HmacSha256::finish(Sha256 &innerHasher) const {
+	const Sha256Hash innerHash = innerHasher.getHash();
+	return Sha256(outerMidstate, Sha256::BLOCK_LEN)
+		.append(innerHash.value, Sha256Hash::HASH_LEN)
+		.getHash();
+}
+
+
+}  // namespace bcl
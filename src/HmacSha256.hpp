@@ -0,0 +1,64 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "Sha256.hpp"
+#include "Sha256Hash.hpp"
+
+namespace bcl {
+
+
+/* 
+ * An HMAC-SHA-256 key, prepared for authenticating any number of messages. The constructor compresses
+ * the blocks (key XOR ipad) and (key XOR opad) once and keeps the two midstates, so each message costs
+ * only its own blocks plus one block for the outer hash. Instances are copyable, and the midstates
+ * (which are equivalent to the key) are wiped by the destructor.
+ */
+class HmacSha256 final {
+	
+	/*---- Fields ----*/
+	
+	// The SHA-256 states after absorbing (key XOR ipad) and (key XOR opad)
+	private: std::uint32_t innerMidstate[8];
+	private: std::uint32_t outerMidstate[8];
+	
+	
+	
+	/*---- Constructors ----*/
+	
+	// Prepares the given key, which may be null iff keyLen is 0. Keys longer than
+	// Sha256::BLOCK_LEN are hashed first, as in RFC 2104.
+	public: explicit HmacSha256(const std::uint8_t key[], std::size_t keyLen);
+	
+	
+	public: ~HmacSha256();
+	
+	
+	
+	/*---- Methods ----*/
+	
+	// Returns the HMAC of the given message under this key, the same value as Sha256::getHmac().
+	public: Sha256Hash getHmac(const std::uint8_t msg[], std::size_t msgLen) const;
+	
+	
+	// Returns a hasher that has absorbed the inner pad, for a message given in several pieces.
+	// Append the message to it, then pass it to finish().
+	public: Sha256 getInnerHasher() const;
+	
+	
+	// Returns the HMAC of the message that was appended to the given hasher from getInnerHasher(),
+	// destroying the hasher's state.
+	public: Sha256Hash finish(Sha256 &innerHasher) const;
+	
+};
+
+
+}  // namespace bcl
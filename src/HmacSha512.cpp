@@ -0,0 +1,141 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include <cassert>
+#include <cstring>
+#include <vector>
+#include "HmacSha512.hpp"
+#include "Utils.hpp"
+
+namespace bcl {
+
+using std::uint8_t;
+using std::uint32_t;
+using std::uint64_t;
+using std::size_t;
+
+
+HmacSha512::HmacSha512(const uint8_t key[], size_t keyLen) {
+	assert(key != nullptr || keyLen == 0);
+	
+	// Preprocess key
+	uint8_t tempKey[Sha512::BLOCK_LEN] = {};
+	if (keyLen <= Sha512::BLOCK_LEN)
+		Utils::copyBytes(tempKey, key, keyLen);
+	else
+		Sha512::getHash(key, keyLen, tempKey);
+	
+	// Compress the inner and outer pads, each of which is exactly one block, into the initial state
+	uint64_t length;
+	Sha512().getMidstate(innerMidstate, length);
+	std::memcpy(outerMidstate, innerMidstate, sizeof(outerMidstate));
+	for (int i = 0; i < Sha512::BLOCK_LEN; i++)
+		tempKey[i] ^= 0x36;
+	Sha512::compress(innerMidstate, tempKey, 1);
+	for (int i = 0; i < Sha512::BLOCK_LEN; i++)
+		tempKey[i] ^= 0x36 ^ 0x5C;
+	Sha512::compress(outerMidstate, tempKey, 1);
+	Utils::clearBytes(tempKey, sizeof(tempKey));
+}
+
+
+HmacSha512::~HmacSha512() {
+	Utils::clearBytes(innerMidstate, sizeof(innerMidstate));
+	Utils::clearBytes(outerMidstate, sizeof(outerMidstate));
+}
+
+
+void HmacSha512::getHmac(const uint8_t msg[], size_t msgLen, uint8_t result[Sha512::HASH_LEN]) const {
+	Sha512 hasher = getInnerHasher();
+	finish(hasher.append(msg, msgLen), result);
+}
+
+
+Sha512 HmacSha512::getInnerHasher() const {
+	return Sha512(innerMidstate, Sha512::BLOCK_LEN);
+}
+
+
+void HmacSha512::finish(Sha512 &innerHasher, uint8_t result[Sha512::HASH_LEN]) const {
+	assert(result != nullptr);
+	uint8_t innerHash[Sha512::HASH_LEN];
+	innerHasher.getHash(innerHash);
+	Sha512(outerMidstate, Sha512::BLOCK_LEN)
+		.append(innerHash, sizeof(innerHash))
+		.getHash(result);
+}
+
+
+
+void HmacSha512::getHmacs(const HmacSha512 *const keys[], const uint8_t *const msgs[], const size_t lens[],
+		size_t n, uint8_t out[][Sha512::HASH_LEN]) {
+	assert((keys != nullptr && msgs != nullptr && lens != nullptr && out != nullptr) || n == 0);
+	constexpr size_t GROUP = 16;  // A multiple of the number of SIMD lanes
+	const uint64_t *midstates[GROUP];
+	const uint8_t *innerHashes[GROUP];
+	size_t innerLens[GROUP];
+	for (size_t start = 0; start < n; start += GROUP) {
+		size_t count = n - start < GROUP ? n - start : GROUP;
+		for (size_t i = 0; i < count; i++)
+			midstates[i] = keys[start + i]->innerMidstate;
+		Sha512::getHashesFromMidstates(midstates, Sha512::BLOCK_LEN, &msgs[start], &lens[start], count, &out[start]);
+		for (size_t i = 0; i < count; i++) {
+			midstates[i] = keys[start + i]->outerMidstate;
+			innerHashes[i] = out[start + i];
+			innerLens[i] = Sha512::HASH_LEN;
+		}
+		Sha512::getHashesFromMidstates(midstates, Sha512::BLOCK_LEN, innerHashes, innerLens, count, &out[start]);
+	}
+}
+
+
+void HmacSha512::getPbkdf2(const uint8_t password[], size_t passwordLen, const uint8_t salt[], size_t saltLen,
+		uint32_t iterations, uint8_t result[Sha512::HASH_LEN]) {
+	uint8_t (*out)[Sha512::HASH_LEN] = reinterpret_cast<uint8_t (*)[Sha512::HASH_LEN]>(result);
+	getPbkdf2s(&password, &passwordLen, &salt, &saltLen, 1, iterations, out);
+}
+
+
+void HmacSha512::getPbkdf2s(const uint8_t *const passwords[], const size_t passwordLens[],
+		const uint8_t *const salts[], const size_t saltLens[], size_t n,
+		uint32_t iterations, uint8_t out[][Sha512::HASH_LEN]) {
+	/* 
+	 * With a 64-byte derived key there is only the first block:
+	 * U_1 = HMAC(password, salt || INT(1)), U_j = HMAC(password, U_{j-1}), result = U_1 XOR ... XOR U_c.
+	 * The chain of each password is sequential, so the parallelism is across the passwords.
+	 */
+	assert((passwords != nullptr && passwordLens != nullptr && salts != nullptr && saltLens != nullptr && out != nullptr) || n == 0);
+	assert(iterations >= 1);
+	std::vector<HmacSha512> hmacs;
+	hmacs.reserve(n);
+	std::vector<const HmacSha512 *> keys(n);
+	std::vector<uint8_t> us(n * Sha512::HASH_LEN);
+	uint8_t (*u)[Sha512::HASH_LEN] = reinterpret_cast<uint8_t (*)[Sha512::HASH_LEN]>(us.data());
+	std::vector<const uint8_t *> uPtrs(n);
+	std::vector<size_t> uLens(n, Sha512::HASH_LEN);
+	const uint8_t blockIndex[4] = {0, 0, 0, 1};
+	for (size_t i = 0; i < n; i++) {
+		hmacs.emplace_back(passwords[i], passwordLens[i]);
+		keys[i] = &hmacs[i];
+		uPtrs[i] = u[i];
+		Sha512 hasher = hmacs[i].getInnerHasher();
+		hasher.append(salts[i], saltLens[i]).append(blockIndex, sizeof(blockIndex));
+		hmacs[i].finish(hasher, u[i]);
+		std::memcpy(out[i], u[i], Sha512::HASH_LEN);
+	}
+	for (uint32_t j = 1; j < iterations; j++) {
+		getHmacs(keys.data(), uPtrs.data(), uLens.data(), n, u);
+		for (size_t i = 0; i < n; i++) {
+			for (int k = 0; k < Sha512::HASH_LEN; k++)
+				out[i][k] ^= u[i][k];
+		}
+	}
+	Utils::clearBytes(us.data(), us.size());
+}
+
+}  // namespace bcl
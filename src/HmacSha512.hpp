@@ -0,0 +1,83 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "Sha512.hpp"
+
+namespace bcl {
+
+
+/* 
+ * An HMAC-SHA-512 key, prepared for authenticating any number of messages. The constructor compresses
+ * the blocks (key XOR ipad) and (key XOR opad) once and keeps the two midstates, so each message costs
+ * only its own blocks plus one block for the outer hash. Instances are copyable, and the midstates
+ * (which are equivalent to the key) are wiped by the destructor.
+ */
+class HmacSha512 final {
+	
+	/*---- Fields ----*/
+	
+	// The SHA-512 states after absorbing (key XOR ipad) and (key XOR opad)
+	private: std::uint64_t innerMidstate[8];
+	private: std::uint64_t outerMidstate[8];
+	
+	
+	
+	/*---- Constructors ----*/
+	
+	// Prepares the given key, which may be null iff keyLen is 0. Keys longer than
+	// Sha512::BLOCK_LEN are hashed first, as in RFC 2104.
+	public: explicit HmacSha512(const std::uint8_t key[], std::size_t keyLen);
+	
+	
+	public: ~HmacSha512();
+	
+	
+	
+	/*---- Methods ----*/
+	
+	// Computes the HMAC of the given message under this key, the same value as Sha512::getHmac().
+	public: void getHmac(const std::uint8_t msg[], std::size_t msgLen, std::uint8_t result[Sha512::HASH_LEN]) const;
+	
+	
+	// Returns a hasher that has absorbed the inner pad, for a message given in several pieces.
+	// Append the message to it, then pass it to finish().
+	public: Sha512 getInnerHasher() const;
+	
+	
+	// Computes the HMAC of the message that was appended to the given hasher from getInnerHasher(),
+	// destroying the hasher's state.
+	public: void finish(Sha512 &innerHasher, std::uint8_t result[Sha512::HASH_LEN]) const;
+	
+	
+	// Sets out[i] to the HMAC of msgs[i] under keys[i] for 0 <= i < n, hashing groups of messages in parallel in SIMD
+	// lanes (see Sha512::getHashesFromMidstates()). The same key may appear many times (e.g. one chain code for many
+	// child keys). Each out[i] may be the same array as msgs[i], but must not overlap any other message.
+	public: static void getHmacs(const HmacSha512 *const keys[], const std::uint8_t *const msgs[], const std::size_t lens[],
+		std::size_t n, std::uint8_t out[][Sha512::HASH_LEN]);
+	
+	
+	// Computes PBKDF2-HMAC-SHA-512 (RFC 8018) of the given password and salt with the given number of iterations
+	// (at least 1), for a derived key of 64 bytes (e.g. a BIP 39 seed from a mnemonic). Either input may be null iff its length is 0.
+	public: static void getPbkdf2(const std::uint8_t password[], std::size_t passwordLen, const std::uint8_t salt[], std::size_t saltLen,
+		std::uint32_t iterations, std::uint8_t result[Sha512::HASH_LEN]);
+	
+	
+	// Sets out[i] to getPbkdf2() of passwords[i] and salts[i] for 0 <= i < n. The iterations of the n
+	// independent computations are done together with getHmacs(), so they run in parallel in SIMD lanes.
+	public: static void getPbkdf2s(const std::uint8_t *const passwords[], const std::size_t passwordLens[],
+		const std::uint8_t *const salts[], const std::size_t saltLens[], std::size_t n,
+		std::uint32_t iterations, std::uint8_t out[][Sha512::HASH_LEN]);
+	
+};
+
+
+}  // namespace bcl
@@ -7,49 +7,528 @@
  */
 
 #include <cassert>
+#include <cstring>
 #include "Keccak256.hpp"
+#include "MultiBuffer.hpp"
+
+#if defined(BCL_X86)
+	#include <immintrin.h>
+#endif
 
 namespace bcl {
 
 using std::uint8_t;
+using std::uint32_t;
 using std::uint64_t;
 using std::size_t;
 
 
-void Keccak256::getHash(const uint8_t msg[], size_t len, uint8_t hashResult[HASH_LEN]) {
-	assert((msg != nullptr || len == 0) && hashResult != nullptr);
-	uint64_t state[5][5] = {};
-	
-	// XOR each message byte into the state, and absorb full blocks
-	int blockOff = 0;
-	for (size_t i = 0; i < len; i++) {
-		int j = blockOff >> 3;
-		state[j % 5][j / 5] ^= static_cast<uint64_t>(msg[i]) << ((blockOff & 7) << 3);
-		blockOff++;
-		if (blockOff == BLOCK_SIZE) {
+Keccak256::Keccak256() :
+		state(),
+		blockOff(0) {}
+
+
+Keccak256::Keccak256(const uint64_t midstate[25]) :
+		state(),
+		blockOff(0) {
+	assert(midstate != nullptr);
+	for (int i = 0; i < 25; i++)
+		xorLane(i, midstate[i]);
+}
+
+
+Keccak256 &Keccak256::append(const uint8_t bytes[], size_t len) {
+	assert(bytes != nullptr || len == 0);
+	while (len > 0) {
+		if (blockOff == 0 && len >= BLOCK_SIZE) {
+			// XOR a whole block straight from the input as little-endian words
+			for (int i = 0; i < BLOCK_SIZE / 8; i++) {
+				uint64_t word = 0;
+				for (int j = 0; j < 8; j++)
+					word |= static_cast<uint64_t>(bytes[i * 8 + j]) << (j << 3);
+				xorLane(i, word);
+			}
 			absorb(state);
-			blockOff = 0;
+			bytes += BLOCK_SIZE;
+			len -= BLOCK_SIZE;
+		} else {
+			// XOR bytes up to the end of the current lane
+			int off = blockOff & 7;
+			int n = len < static_cast<size_t>(8 - off) ? static_cast<int>(len) : 8 - off;
+			uint64_t word = 0;
+			for (int j = 0; j < n; j++)
+				word |= static_cast<uint64_t>(bytes[j]) << ((off + j) << 3);
+			xorLane(blockOff >> 3, word);
+			bytes += n;
+			len -= n;
+			blockOff += n;
+			if (blockOff == BLOCK_SIZE) {
+				absorb(state);
+				blockOff = 0;
+			}
 		}
 	}
+	return *this;
+}
+
+
+void Keccak256::getHash(uint8_t result[HASH_LEN]) {
+	assert(result != nullptr);
 	
 	// Final block and padding
-	{
-		int i = blockOff >> 3;
-		state[i % 5][i / 5] ^= UINT64_C(0x01) << ((blockOff & 7) << 3);
-		blockOff = BLOCK_SIZE - 1;
-		int j = blockOff >> 3;
-		state[j % 5][j / 5] ^= UINT64_C(0x80) << ((blockOff & 7) << 3);
-		absorb(state);
-	}
+	xorLane(blockOff >> 3, UINT64_C(0x01) << ((blockOff & 7) << 3));
+	xorLane(BLOCK_SIZE / 8 - 1, UINT64_C(0x80) << 56);
+	absorb(state);
 	
 	// Uint64 array to bytes in little endian
-	for (int i = 0; i < HASH_LEN; i++) {
-		int j = i >> 3;
-		hashResult[i] = static_cast<uint8_t>(state[j % 5][j / 5] >> ((i & 7) << 3));
+	for (int i = 0; i < HASH_LEN / 8; i++) {
+		uint64_t lane = getLane(i);
+		for (int j = 0; j < 8; j++)
+			result[i * 8 + j] = static_cast<uint8_t>(lane >> (j << 3));
 	}
 }
 
 
+bool Keccak256::getMidstate(uint64_t outMidstate[25]) const {
+	assert(outMidstate != nullptr);
+	if (blockOff != 0)
+		return false;
+	for (int i = 0; i < 25; i++)
+		outMidstate[i] = getLane(i);
+	return true;
+}
+
+
+void Keccak256::getHash(const uint8_t msg[], size_t len, uint8_t hashResult[HASH_LEN]) {
+	Keccak256().append(msg, len).getHash(hashResult);
+}
+
+
+void Keccak256::getHashes(const uint8_t *const msgs[], const size_t lens[], size_t n, uint8_t out[][HASH_LEN]) {
+	size_t lanes = 0;
+	PermuteLanes permuteLanes = getPermuteLanes(lanes);
+	getHashes(msgs, lens, n, out, lanes, permuteLanes);
+}
+
+
+bool Keccak256::getHashesInLanes(const uint8_t *const msgs[], const size_t lens[], size_t n, uint8_t out[][HASH_LEN], size_t lanes) {
+	PermuteLanes permuteLanes = nullptr;
+#if defined(BCL_X86)
+	if (lanes == 8 && CpuFeatures::hasAvx512())
+		permuteLanes = permuteAvx512;
+	else if (lanes == 4 && CpuFeatures::hasAvx2())
+		permuteLanes = permuteAvx2;
+#endif
+	if (permuteLanes == nullptr)
+		return false;
+	getHashes(msgs, lens, n, out, lanes, permuteLanes);
+	return true;
+}
+
+
+void Keccak256::getHashes(const uint8_t *const msgs[], const size_t lens[], size_t n, uint8_t out[][HASH_LEN],
+		size_t lanes, PermuteLanes permuteLanes) {
+	assert((msgs != nullptr && lens != nullptr && out != nullptr) || n == 0);
+	size_t i = 0;
+	for (size_t count; (count = MultiBuffer::getGroupLen(i, n, lanes)) > 0; i += count)
+		getHashesLanes(&msgs[i], &lens[i], count, &out[i], lanes, permuteLanes);
+	for (; i < n; i++)
+		getHash(msgs[i], lens[i], out[i]);
+}
+
+
+Keccak256::PermuteLanes Keccak256::getPermuteLanes(size_t &outLanes) {
+#if defined(BCL_X86)
+	if (CpuFeatures::hasAvx512()) {
+		outLanes = 8;
+		return permuteAvx512;
+	} else if (CpuFeatures::hasAvx2()) {
+		outLanes = 4;
+		return permuteAvx2;
+	}
+#endif
+	outLanes = 0;
+	return nullptr;
+}
+
+
+void Keccak256::getHashesLanes(const uint8_t *const msgs[], const size_t lens[], size_t count,
+		uint8_t out[][HASH_LEN], size_t lanes, PermuteLanes permuteLanes) {
+	assert(count <= lanes && lanes <= MAX_LANES);
+	const MultiBuffer schedule(msgs, lens, count, BLOCK_SIZE, MultiBuffer::Padding::KECCAK, 0);
+	uint64_t states[25 * MAX_LANES] = {};
+	schedule.absorb<25>(states, lanes,
+		[&](const uint8_t *block, size_t j) {
+			for (int i = 0; i < BLOCK_SIZE / 8; i++) {
+				uint64_t word = 0;
+				for (int m = 0; m < 8; m++)
+					word |= static_cast<uint64_t>(block[i * 8 + m]) << (m << 3);
+				states[i * lanes + j] ^= word;
+			}
+		},
+		[&]() { permuteLanes(states); });
+	
+	// All the input has been read, so the output may overwrite it
+	for (size_t j = 0; j < count; j++) {
+		for (int i = 0; i < HASH_LEN; i++)
+			out[j][i] = static_cast<uint8_t>(states[(i >> 3) * lanes + j] >> ((i & 7) << 3));
+	}
+}
+
+
+#if defined(BCL_X86)
+
+// Rotates each 64-bit lane of x left by n, for 0 <= n <= 63
+#define BCL_ROTL256(x, n)  _mm256_or_si256(_mm256_slli_epi64((x), (n)), _mm256_srli_epi64((x), 64 - (n)))
+
+BCL_TARGET("avx2")
+void Keccak256::permuteAvx2(uint64_t states[25 * 4]) {
+	// The same step mappings as the compact absorb(), on 4 states at once. The loops
+	// have constant bounds, so the compiler can unroll them and keep the lanes in registers.
+	__m256i a[25];
+	for (int i = 0; i < 25; i++)
+		a[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&states[i * 4]));
+	for (int r = 0; r < NUM_ROUNDS; r++) {
+		// Theta step
+		__m256i c[5];
+		for (int x = 0; x < 5; x++) {
+			c[x] = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(a[x], a[x + 5]),
+				_mm256_xor_si256(a[x + 10], a[x + 15])), a[x + 20]);
+		}
+		for (int x = 0; x < 5; x++) {
+			__m256i d = _mm256_xor_si256(c[(x + 4) % 5], BCL_ROTL256(c[(x + 1) % 5], 1));
+			for (int y = 0; y < 25; y += 5)
+				a[x + y] = _mm256_xor_si256(a[x + y], d);
+		}
+		
+		// Rho and pi steps
+		__m256i b[25];
+		for (int x = 0; x < 5; x++) {
+			for (int y = 0; y < 5; y++)
+				b[y + (x * 2 + y * 3) % 5 * 5] = BCL_ROTL256(a[x + y * 5], ROTATION[x][y]);
+		}
+		
+		// Chi and iota steps
+		for (int y = 0; y < 25; y += 5) {
+			for (int x = 0; x < 5; x++)
+				a[x + y] = _mm256_xor_si256(b[x + y], _mm256_andnot_si256(b[(x + 1) % 5 + y], b[(x + 2) % 5 + y]));
+		}
+		a[0] = _mm256_xor_si256(a[0], _mm256_set1_epi64x(static_cast<long long>(ROUND_CONSTANTS[r])));
+	}
+	for (int i = 0; i < 25; i++)
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(&states[i * 4]), a[i]);
+}
+
+#undef BCL_ROTL256
+
+
+BCL_AVX512_WARNINGS_BEGIN
+
+BCL_TARGET("avx512f")
+void Keccak256::permuteAvx512(uint64_t states[25 * 8]) {
+	// Like permuteAvx2(), but with native rotations and ternary logic (0x96 = x ^ y ^ z, 0xD2 = x ^ (~y & z))
+	__m512i a[25];
+	for (int i = 0; i < 25; i++)
+		a[i] = _mm512_loadu_si512(&states[i * 8]);
+	for (int r = 0; r < NUM_ROUNDS; r++) {
+		// Theta step
+		__m512i c[5];
+		for (int x = 0; x < 5; x++)
+			c[x] = _mm512_ternarylogic_epi64(_mm512_ternarylogic_epi64(a[x], a[x + 5], a[x + 10], 0x96), a[x + 15], a[x + 20], 0x96);
+		for (int x = 0; x < 5; x++) {
+			__m512i d = _mm512_xor_si512(c[(x + 4) % 5], _mm512_rol_epi64(c[(x + 1) % 5], 1));
+			for (int y = 0; y < 25; y += 5)
+				a[x + y] = _mm512_xor_si512(a[x + y], d);
+		}
+		
+		// Rho and pi steps
+		__m512i b[25];
+		for (int x = 0; x < 5; x++) {
+			for (int y = 0; y < 5; y++)
+				b[y + (x * 2 + y * 3) % 5 * 5] = _mm512_rolv_epi64(a[x + y * 5], _mm512_set1_epi64(ROTATION[x][y]));
+		}
+		
+		// Chi and iota steps
+		for (int y = 0; y < 25; y += 5) {
+			for (int x = 0; x < 5; x++)
+				a[x + y] = _mm512_ternarylogic_epi64(b[x + y], b[(x + 1) % 5 + y], b[(x + 2) % 5 + y], 0xD2);
+		}
+		a[0] = _mm512_xor_si512(a[0], _mm512_set1_epi64(static_cast<long long>(ROUND_CONSTANTS[r])));
+	}
+	for (int i = 0; i < 25; i++)
+		_mm512_storeu_si512(&states[i * 8], a[i]);
+}
+
+BCL_AVX512_WARNINGS_END
+
+#endif
+
+
+void Keccak256::xorLane(int i, uint64_t value) {
+#if BCL_KECCAK_INTERLEAVED
+	state[i % 5][i / 5] ^= toInterleaved(value);
+#else
+	state[i % 5][i / 5] ^= value;
+#endif
+}
+
+
+uint64_t Keccak256::getLane(int i) const {
+#if BCL_KECCAK_INTERLEAVED
+	return fromInterleaved(state[i % 5][i / 5]);
+#else
+	return state[i % 5][i / 5];
+#endif
+}
+
+
+#if BCL_KECCAK_INTERLEAVED
+
+// One round of the permutation on bit-interleaved words, like BCL_KECCAK_ROUND below. Each lane is split
+// into word 0 (even bits) and word 1 (odd bits). Rotating a lane left by 2n rotates both words by n, and
+// rotating it by 2n + 1 moves the odd word to the even word rotated by n + 1 and the even word to the odd
+// word rotated by n.
+#define BCL_KECCAK_ROUND32(a, e, rc) \
+	c00 = a##ba0 ^ a##ga0 ^ a##ka0 ^ a##ma0 ^ a##sa0; \
+	c01 = a##ba1 ^ a##ga1 ^ a##ka1 ^ a##ma1 ^ a##sa1; \
+	c10 = a##be0 ^ a##ge0 ^ a##ke0 ^ a##me0 ^ a##se0; \
+	c11 = a##be1 ^ a##ge1 ^ a##ke1 ^ a##me1 ^ a##se1; \
+	c20 = a##bi0 ^ a##gi0 ^ a##ki0 ^ a##mi0 ^ a##si0; \
+	c21 = a##bi1 ^ a##gi1 ^ a##ki1 ^ a##mi1 ^ a##si1; \
+	c30 = a##bo0 ^ a##go0 ^ a##ko0 ^ a##mo0 ^ a##so0; \
+	c31 = a##bo1 ^ a##go1 ^ a##ko1 ^ a##mo1 ^ a##so1; \
+	c40 = a##bu0 ^ a##gu0 ^ a##ku0 ^ a##mu0 ^ a##su0; \
+	c41 = a##bu1 ^ a##gu1 ^ a##ku1 ^ a##mu1 ^ a##su1; \
+	d00 = c40 ^ rotl32(c11, 1); \
+	d01 = c41 ^ c10; \
+	d10 = c00 ^ rotl32(c21, 1); \
+	d11 = c01 ^ c20; \
+	d20 = c10 ^ rotl32(c31, 1); \
+	d21 = c11 ^ c30; \
+	d30 = c20 ^ rotl32(c41, 1); \
+	d31 = c21 ^ c40; \
+	d40 = c30 ^ rotl32(c01, 1); \
+	d41 = c31 ^ c00; \
+	b00 = a##ba0 ^ d00; \
+	b01 = a##ba1 ^ d01; \
+	b10 = rotl32(a##ge0 ^ d10, 22); \
+	b11 = rotl32(a##ge1 ^ d11, 22); \
+	b20 = rotl32(a##ki1 ^ d21, 22); \
+	b21 = rotl32(a##ki0 ^ d20, 21); \
+	b30 = rotl32(a##mo1 ^ d31, 11); \
+	b31 = rotl32(a##mo0 ^ d30, 10); \
+	b40 = rotl32(a##su0 ^ d40, 7); \
+	b41 = rotl32(a##su1 ^ d41, 7); \
+	e##ba0 = b00 ^ (b10 | b20) ^ rc[0]; \
+	e##ba1 = b01 ^ (b11 | b21) ^ rc[1]; \
+	e##be0 = b10 ^ (~b20 | b30); \
+	e##be1 = b11 ^ (~b21 | b31); \
+	e##bi0 = b20 ^ (b30 & b40); \
+	e##bi1 = b21 ^ (b31 & b41); \
+	e##bo0 = b30 ^ (b40 | b00); \
+	e##bo1 = b31 ^ (b41 | b01); \
+	e##bu0 = b40 ^ (b00 & b10); \
+	e##bu1 = b41 ^ (b01 & b11); \
+	b00 = rotl32(a##bo0 ^ d30, 14); \
+	b01 = rotl32(a##bo1 ^ d31, 14); \
+	b10 = rotl32(a##gu0 ^ d40, 10); \
+	b11 = rotl32(a##gu1 ^ d41, 10); \
+	b20 = rotl32(a##ka1 ^ d01, 2); \
+	b21 = rotl32(a##ka0 ^ d00, 1); \
+	b30 = rotl32(a##me1 ^ d11, 23); \
+	b31 = rotl32(a##me0 ^ d10, 22); \
+	b40 = rotl32(a##si1 ^ d21, 31); \
+	b41 = rotl32(a##si0 ^ d20, 30); \
+	e##ga0 = b00 ^ (b10 | b20); \
+	e##ga1 = b01 ^ (b11 | b21); \
+	e##ge0 = b10 ^ (b20 & b30); \
+	e##ge1 = b11 ^ (b21 & b31); \
+	e##gi0 = b20 ^ (b30 | ~b40); \
+	e##gi1 = b21 ^ (b31 | ~b41); \
+	e##go0 = b30 ^ (b40 | b00); \
+	e##go1 = b31 ^ (b41 | b01); \
+	e##gu0 = b40 ^ (b00 & b10); \
+	e##gu1 = b41 ^ (b01 & b11); \
+	b00 = rotl32(a##be1 ^ d11, 1); \
+	b01 = a##be0 ^ d10; \
+	b10 = rotl32(a##gi0 ^ d20, 3); \
+	b11 = rotl32(a##gi1 ^ d21, 3); \
+	b20 = rotl32(a##ko1 ^ d31, 13); \
+	b21 = rotl32(a##ko0 ^ d30, 12); \
+	b30 = rotl32(a##mu0 ^ d40, 4); \
+	b31 = rotl32(a##mu1 ^ d41, 4); \
+	b40 = rotl32(a##sa0 ^ d00, 9); \
+	b41 = rotl32(a##sa1 ^ d01, 9); \
+	e##ka0 = b00 ^ (b10 | b20); \
+	e##ka1 = b01 ^ (b11 | b21); \
+	e##ke0 = b10 ^ (b20 & b30); \
+	e##ke1 = b11 ^ (b21 & b31); \
+	e##ki0 = b20 ^ (~b30 & b40); \
+	e##ki1 = b21 ^ (~b31 & b41); \
+	e##ko0 = ~(b30 ^ (b40 | b00)); \
+	e##ko1 = ~(b31 ^ (b41 | b01)); \
+	e##ku0 = b40 ^ (b00 & b10); \
+	e##ku1 = b41 ^ (b01 & b11); \
+	b00 = rotl32(a##bu1 ^ d41, 14); \
+	b01 = rotl32(a##bu0 ^ d40, 13); \
+	b10 = rotl32(a##ga0 ^ d00, 18); \
+	b11 = rotl32(a##ga1 ^ d01, 18); \
+	b20 = rotl32(a##ke0 ^ d10, 5); \
+	b21 = rotl32(a##ke1 ^ d11, 5); \
+	b30 = rotl32(a##mi1 ^ d21, 8); \
+	b31 = rotl32(a##mi0 ^ d20, 7); \
+	b40 = rotl32(a##so0 ^ d30, 28); \
+	b41 = rotl32(a##so1 ^ d31, 28); \
+	e##ma0 = b00 ^ (b10 & b20); \
+	e##ma1 = b01 ^ (b11 & b21); \
+	e##me0 = b10 ^ (b20 | b30); \
+	e##me1 = b11 ^ (b21 | b31); \
+	e##mi0 = b20 ^ (~b30 | b40); \
+	e##mi1 = b21 ^ (~b31 | b41); \
+	e##mo0 = ~(b30 ^ (b40 & b00)); \
+	e##mo1 = ~(b31 ^ (b41 & b01)); \
+	e##mu0 = b40 ^ (b00 | b10); \
+	e##mu1 = b41 ^ (b01 | b11); \
+	b00 = rotl32(a##bi0 ^ d20, 31); \
+	b01 = rotl32(a##bi1 ^ d21, 31); \
+	b10 = rotl32(a##go1 ^ d31, 28); \
+	b11 = rotl32(a##go0 ^ d30, 27); \
+	b20 = rotl32(a##ku1 ^ d41, 20); \
+	b21 = rotl32(a##ku0 ^ d40, 19); \
+	b30 = rotl32(a##ma1 ^ d01, 21); \
+	b31 = rotl32(a##ma0 ^ d00, 20); \
+	b40 = rotl32(a##se0 ^ d10, 1); \
+	b41 = rotl32(a##se1 ^ d11, 1); \
+	e##sa0 = b00 ^ (~b10 & b20); \
+	e##sa1 = b01 ^ (~b11 & b21); \
+	e##se0 = ~(b10 ^ (b20 | b30)); \
+	e##se1 = ~(b11 ^ (b21 | b31)); \
+	e##si0 = b20 ^ (b30 & b40); \
+	e##si1 = b21 ^ (b31 & b41); \
+	e##so0 = b30 ^ (b40 | b00); \
+	e##so1 = b31 ^ (b41 | b01); \
+	e##su0 = b40 ^ (b00 & b10); \
+	e##su1 = b41 ^ (b01 & b11);
+
+
+void Keccak256::absorb(uint64_t state[5][5]) {
+	uint32_t aba0 = static_cast<uint32_t>(state[0][0]), aba1 = static_cast<uint32_t>(state[0][0] >> 32);
+	uint32_t abe0 = ~static_cast<uint32_t>(state[1][0]), abe1 = ~static_cast<uint32_t>(state[1][0] >> 32);
+	uint32_t abi0 = ~static_cast<uint32_t>(state[2][0]), abi1 = ~static_cast<uint32_t>(state[2][0] >> 32);
+	uint32_t abo0 = static_cast<uint32_t>(state[3][0]), abo1 = static_cast<uint32_t>(state[3][0] >> 32);
+	uint32_t abu0 = static_cast<uint32_t>(state[4][0]), abu1 = static_cast<uint32_t>(state[4][0] >> 32);
+	uint32_t aga0 = static_cast<uint32_t>(state[0][1]), aga1 = static_cast<uint32_t>(state[0][1] >> 32);
+	uint32_t age0 = static_cast<uint32_t>(state[1][1]), age1 = static_cast<uint32_t>(state[1][1] >> 32);
+	uint32_t agi0 = static_cast<uint32_t>(state[2][1]), agi1 = static_cast<uint32_t>(state[2][1] >> 32);
+	uint32_t ago0 = ~static_cast<uint32_t>(state[3][1]), ago1 = ~static_cast<uint32_t>(state[3][1] >> 32);
+	uint32_t agu0 = static_cast<uint32_t>(state[4][1]), agu1 = static_cast<uint32_t>(state[4][1] >> 32);
+	uint32_t aka0 = static_cast<uint32_t>(state[0][2]), aka1 = static_cast<uint32_t>(state[0][2] >> 32);
+	uint32_t ake0 = static_cast<uint32_t>(state[1][2]), ake1 = static_cast<uint32_t>(state[1][2] >> 32);
+	uint32_t aki0 = ~static_cast<uint32_t>(state[2][2]), aki1 = ~static_cast<uint32_t>(state[2][2] >> 32);
+	uint32_t ako0 = static_cast<uint32_t>(state[3][2]), ako1 = static_cast<uint32_t>(state[3][2] >> 32);
+	uint32_t aku0 = static_cast<uint32_t>(state[4][2]), aku1 = static_cast<uint32_t>(state[4][2] >> 32);
+	uint32_t ama0 = static_cast<uint32_t>(state[0][3]), ama1 = static_cast<uint32_t>(state[0][3] >> 32);
+	uint32_t ame0 = static_cast<uint32_t>(state[1][3]), ame1 = static_cast<uint32_t>(state[1][3] >> 32);
+	uint32_t ami0 = ~static_cast<uint32_t>(state[2][3]), ami1 = ~static_cast<uint32_t>(state[2][3] >> 32);
+	uint32_t amo0 = static_cast<uint32_t>(state[3][3]), amo1 = static_cast<uint32_t>(state[3][3] >> 32);
+	uint32_t amu0 = static_cast<uint32_t>(state[4][3]), amu1 = static_cast<uint32_t>(state[4][3] >> 32);
+	uint32_t asa0 = ~static_cast<uint32_t>(state[0][4]), asa1 = ~static_cast<uint32_t>(state[0][4] >> 32);
+	uint32_t ase0 = static_cast<uint32_t>(state[1][4]), ase1 = static_cast<uint32_t>(state[1][4] >> 32);
+	uint32_t asi0 = static_cast<uint32_t>(state[2][4]), asi1 = static_cast<uint32_t>(state[2][4] >> 32);
+	uint32_t aso0 = static_cast<uint32_t>(state[3][4]), aso1 = static_cast<uint32_t>(state[3][4] >> 32);
+	uint32_t asu0 = static_cast<uint32_t>(state[4][4]), asu1 = static_cast<uint32_t>(state[4][4] >> 32);
+	uint32_t eba0, eba1, ebe0, ebe1, ebi0, ebi1, ebo0, ebo1, ebu0, ebu1;
+	uint32_t ega0, ega1, ege0, ege1, egi0, egi1, ego0, ego1, egu0, egu1;
+	uint32_t eka0, eka1, eke0, eke1, eki0, eki1, eko0, eko1, eku0, eku1;
+	uint32_t ema0, ema1, eme0, eme1, emi0, emi1, emo0, emo1, emu0, emu1;
+	uint32_t esa0, esa1, ese0, ese1, esi0, esi1, eso0, eso1, esu0, esu1;
+	uint32_t c00, c01, c10, c11, c20, c21, c30, c31, c40, c41;
+	uint32_t d00, d01, d10, d11, d20, d21, d30, d31, d40, d41;
+	uint32_t b00, b01, b10, b11, b20, b21, b30, b31, b40, b41;
+	for (int i = 0; i < NUM_ROUNDS; i += 2) {
+		BCL_KECCAK_ROUND32(a, e, ROUND_CONSTANTS_INTERLEAVED[i])
+		BCL_KECCAK_ROUND32(e, a, ROUND_CONSTANTS_INTERLEAVED[i + 1])
+	}
+	state[0][0] = static_cast<uint64_t>(aba1) << 32 | aba0;
+	state[1][0] = ~(static_cast<uint64_t>(abe1) << 32 | abe0);
+	state[2][0] = ~(static_cast<uint64_t>(abi1) << 32 | abi0);
+	state[3][0] = static_cast<uint64_t>(abo1) << 32 | abo0;
+	state[4][0] = static_cast<uint64_t>(abu1) << 32 | abu0;
+	state[0][1] = static_cast<uint64_t>(aga1) << 32 | aga0;
+	state[1][1] = static_cast<uint64_t>(age1) << 32 | age0;
+	state[2][1] = static_cast<uint64_t>(agi1) << 32 | agi0;
+	state[3][1] = ~(static_cast<uint64_t>(ago1) << 32 | ago0);
+	state[4][1] = static_cast<uint64_t>(agu1) << 32 | agu0;
+	state[0][2] = static_cast<uint64_t>(aka1) << 32 | aka0;
+	state[1][2] = static_cast<uint64_t>(ake1) << 32 | ake0;
+	state[2][2] = ~(static_cast<uint64_t>(aki1) << 32 | aki0);
+	state[3][2] = static_cast<uint64_t>(ako1) << 32 | ako0;
+	state[4][2] = static_cast<uint64_t>(aku1) << 32 | aku0;
+	state[0][3] = static_cast<uint64_t>(ama1) << 32 | ama0;
+	state[1][3] = static_cast<uint64_t>(ame1) << 32 | ame0;
+	state[2][3] = ~(static_cast<uint64_t>(ami1) << 32 | ami0);
+	state[3][3] = static_cast<uint64_t>(amo1) << 32 | amo0;
+	state[4][3] = static_cast<uint64_t>(amu1) << 32 | amu0;
+	state[0][4] = ~(static_cast<uint64_t>(asa1) << 32 | asa0);
+	state[1][4] = static_cast<uint64_t>(ase1) << 32 | ase0;
+	state[2][4] = static_cast<uint64_t>(asi1) << 32 | asi0;
+	state[3][4] = static_cast<uint64_t>(aso1) << 32 | aso0;
+	state[4][4] = static_cast<uint64_t>(asu1) << 32 | asu0;
+}
+
+#undef BCL_KECCAK_ROUND32
+
+
+uint64_t Keccak256::toInterleaved(uint64_t lane) {
+	uint32_t lo = unshuffle(static_cast<uint32_t>(lane));
+	uint32_t hi = unshuffle(static_cast<uint32_t>(lane >> 32));
+	uint32_t even = (lo & UINT32_C(0x0000FFFF)) | (hi << 16);
+	uint32_t odd = (lo >> 16) | (hi & UINT32_C(0xFFFF0000));
+	return static_cast<uint64_t>(odd) << 32 | even;
+}
+
+
+uint64_t Keccak256::fromInterleaved(uint64_t words) {
+	uint32_t even = static_cast<uint32_t>(words);
+	uint32_t odd = static_cast<uint32_t>(words >> 32);
+	uint32_t lo = shuffle((even & UINT32_C(0x0000FFFF)) | (odd << 16));
+	uint32_t hi = shuffle((even >> 16) | (odd & UINT32_C(0xFFFF0000)));
+	return static_cast<uint64_t>(hi) << 32 | lo;
+}
+
+
+uint32_t Keccak256::unshuffle(uint32_t x) {
+	// Each step swaps the bit groups selected by the mask with the groups just above them
+	uint32_t t = (x ^ (x >> 1)) & UINT32_C(0x22222222);
+	x ^= t ^ (t << 1);
+	t = (x ^ (x >> 2)) & UINT32_C(0x0C0C0C0C);
+	x ^= t ^ (t << 2);
+	t = (x ^ (x >> 4)) & UINT32_C(0x00F000F0);
+	x ^= t ^ (t << 4);
+	t = (x ^ (x >> 8)) & UINT32_C(0x0000FF00);
+	return x ^ t ^ (t << 8);
+}
+
+
+uint32_t Keccak256::shuffle(uint32_t x) {
+	// The steps of unshuffle() in reverse order
+	uint32_t t = (x ^ (x >> 8)) & UINT32_C(0x0000FF00);
+	x ^= t ^ (t << 8);
+	t = (x ^ (x >> 4)) & UINT32_C(0x00F000F0);
+	x ^= t ^ (t << 4);
+	t = (x ^ (x >> 2)) & UINT32_C(0x0C0C0C0C);
+	x ^= t ^ (t << 2);
+	t = (x ^ (x >> 1)) & UINT32_C(0x22222222);
+	return x ^ t ^ (t << 1);
+}
+
+
+uint32_t Keccak256::rotl32(uint32_t x, int i) {
+	return ((0U + x) << i) | (x >> ((32 - i) & 31));
+}
+
+#elif defined(BCL_KECCAK_COMPACT)
+
 void Keccak256::absorb(uint64_t state[5][5]) {
 	uint64_t (*a)[5] = state;
 	uint8_t r = 1;  // LFSR
@@ -88,12 +567,126 @@ void Keccak256::absorb(uint64_t state[5][5]) {
 }
 
 
+#else
+
+// One round of the permutation from the lanes named a## to the lanes named e##. The lanes are named
+// after their row y (b, g, k, m, s) and column x (a, e, i, o, u). On entry and exit, the lanes
+// at positions (1,0), (2,0), (3,1), (2,2), (2,3) and (0,4) hold the complements of their values,
+// which lets the chi step use OR in place of most of the NOTs.
+#define BCL_KECCAK_ROUND(a, e, rc) \
+	c0 = a##ba ^ a##ga ^ a##ka ^ a##ma ^ a##sa; \
+	c1 = a##be ^ a##ge ^ a##ke ^ a##me ^ a##se; \
+	c2 = a##bi ^ a##gi ^ a##ki ^ a##mi ^ a##si; \
+	c3 = a##bo ^ a##go ^ a##ko ^ a##mo ^ a##so; \
+	c4 = a##bu ^ a##gu ^ a##ku ^ a##mu ^ a##su; \
+	d0 = c4 ^ rotl64(c1, 1); \
+	d1 = c0 ^ rotl64(c2, 1); \
+	d2 = c1 ^ rotl64(c3, 1); \
+	d3 = c2 ^ rotl64(c4, 1); \
+	d4 = c3 ^ rotl64(c0, 1); \
+	b0 = a##ba ^ d0; \
+	b1 = rotl64(a##ge ^ d1, 44); \
+	b2 = rotl64(a##ki ^ d2, 43); \
+	b3 = rotl64(a##mo ^ d3, 21); \
+	b4 = rotl64(a##su ^ d4, 14); \
+	e##ba = b0 ^ (b1 | b2) ^ rc; \
+	e##be = b1 ^ (~b2 | b3); \
+	e##bi = b2 ^ (b3 & b4); \
+	e##bo = b3 ^ (b4 | b0); \
+	e##bu = b4 ^ (b0 & b1); \
+	b0 = rotl64(a##bo ^ d3, 28); \
+	b1 = rotl64(a##gu ^ d4, 20); \
+	b2 = rotl64(a##ka ^ d0, 3); \
+	b3 = rotl64(a##me ^ d1, 45); \
+	b4 = rotl64(a##si ^ d2, 61); \
+	e##ga = b0 ^ (b1 | b2); \
+	e##ge = b1 ^ (b2 & b3); \
+	e##gi = b2 ^ (b3 | ~b4); \
+	e##go = b3 ^ (b4 | b0); \
+	e##gu = b4 ^ (b0 & b1); \
+	b0 = rotl64(a##be ^ d1, 1); \
+	b1 = rotl64(a##gi ^ d2, 6); \
+	b2 = rotl64(a##ko ^ d3, 25); \
+	b3 = rotl64(a##mu ^ d4, 8); \
+	b4 = rotl64(a##sa ^ d0, 18); \
+	e##ka = b0 ^ (b1 | b2); \
+	e##ke = b1 ^ (b2 & b3); \
+	e##ki = b2 ^ (~b3 & b4); \
+	e##ko = ~(b3 ^ (b4 | b0)); \
+	e##ku = b4 ^ (b0 & b1); \
+	b0 = rotl64(a##bu ^ d4, 27); \
+	b1 = rotl64(a##ga ^ d0, 36); \
+	b2 = rotl64(a##ke ^ d1, 10); \
+	b3 = rotl64(a##mi ^ d2, 15); \
+	b4 = rotl64(a##so ^ d3, 56); \
+	e##ma = b0 ^ (b1 & b2); \
+	e##me = b1 ^ (b2 | b3); \
+	e##mi = b2 ^ (~b3 | b4); \
+	e##mo = ~(b3 ^ (b4 & b0)); \
+	e##mu = b4 ^ (b0 | b1); \
+	b0 = rotl64(a##bi ^ d2, 62); \
+	b1 = rotl64(a##go ^ d3, 55); \
+	b2 = rotl64(a##ku ^ d4, 39); \
+	b3 = rotl64(a##ma ^ d0, 41); \
+	b4 = rotl64(a##se ^ d1, 2); \
+	e##sa = b0 ^ (~b1 & b2); \
+	e##se = ~(b1 ^ (b2 | b3)); \
+	e##si = b2 ^ (b3 & b4); \
+	e##so = b3 ^ (b4 | b0); \
+	e##su = b4 ^ (b0 & b1);
+
+
+void Keccak256::absorb(uint64_t state[5][5]) {
+	uint64_t aba = state[0][0], abe = ~state[1][0], abi = ~state[2][0], abo = state[3][0], abu = state[4][0];
+	uint64_t aga = state[0][1], age = state[1][1], agi = state[2][1], ago = ~state[3][1], agu = state[4][1];
+	uint64_t aka = state[0][2], ake = state[1][2], aki = ~state[2][2], ako = state[3][2], aku = state[4][2];
+	uint64_t ama = state[0][3], ame = state[1][3], ami = ~state[2][3], amo = state[3][3], amu = state[4][3];
+	uint64_t asa = ~state[0][4], ase = state[1][4], asi = state[2][4], aso = state[3][4], asu = state[4][4];
+	uint64_t eba, ebe, ebi, ebo, ebu, ega, ege, egi, ego, egu, eka, eke, eki,
+		eko, eku, ema, eme, emi, emo, emu, esa, ese, esi, eso, esu;
+	uint64_t c0, c1, c2, c3, c4, d0, d1, d2, d3, d4, b0, b1, b2, b3, b4;
+	for (int i = 0; i < NUM_ROUNDS; i += 2) {
+		BCL_KECCAK_ROUND(a, e, ROUND_CONSTANTS[i])
+		BCL_KECCAK_ROUND(e, a, ROUND_CONSTANTS[i + 1])
+	}
+	state[0][0] = aba; state[1][0] = ~abe; state[2][0] = ~abi; state[3][0] = abo; state[4][0] = abu;
+	state[0][1] = aga; state[1][1] = age; state[2][1] = agi; state[3][1] = ~ago; state[4][1] = agu;
+	state[0][2] = aka; state[1][2] = ake; state[2][2] = ~aki; state[3][2] = ako; state[4][2] = aku;
+	state[0][3] = ama; state[1][3] = ame; state[2][3] = ~ami; state[3][3] = amo; state[4][3] = amu;
+	state[0][4] = ~asa; state[1][4] = ase; state[2][4] = asi; state[3][4] = aso; state[4][4] = asu;
+}
+
+#undef BCL_KECCAK_ROUND
+
+#endif
+
+
 uint64_t Keccak256::rotl64(uint64_t x, int i) {
 	return ((0U + x) << i) | (x >> ((64 - i) & 63));
 }
 
 
 // Static initializers
+const uint64_t Keccak256::ROUND_CONSTANTS[NUM_ROUNDS] = {
+	UINT64_C(0x0000000000000001), UINT64_C(0x0000000000008082), UINT64_C(0x800000000000808A), UINT64_C(0x8000000080008000),
+	UINT64_C(0x000000000000808B), UINT64_C(0x0000000080000001), UINT64_C(0x8000000080008081), UINT64_C(0x8000000000008009),
+	UINT64_C(0x000000000000008A), UINT64_C(0x0000000000000088), UINT64_C(0x0000000080008009), UINT64_C(0x000000008000000A),
+	UINT64_C(0x000000008000808B), UINT64_C(0x800000000000008B), UINT64_C(0x8000000000008089), UINT64_C(0x8000000000008003),
+	UINT64_C(0x8000000000008002), UINT64_C(0x8000000000000080), UINT64_C(0x000000000000800A), UINT64_C(0x800000008000000A),
+	UINT64_C(0x8000000080008081), UINT64_C(0x8000000000008080), UINT64_C(0x0000000080000001), UINT64_C(0x8000000080008008),
+};
+
+#if BCL_KECCAK_INTERLEAVED
+const uint32_t Keccak256::ROUND_CONSTANTS_INTERLEAVED[NUM_ROUNDS][2] = {
+	{UINT32_C(0x00000001), UINT32_C(0x00000000)}, {UINT32_C(0x00000000), UINT32_C(0x00000089)}, {UINT32_C(0x00000000), UINT32_C(0x8000008B)}, {UINT32_C(0x00000000), UINT32_C(0x80008080)},
+	{UINT32_C(0x00000001), UINT32_C(0x0000008B)}, {UINT32_C(0x00000001), UINT32_C(0x00008000)}, {UINT32_C(0x00000001), UINT32_C(0x80008088)}, {UINT32_C(0x00000001), UINT32_C(0x80000082)},
+	{UINT32_C(0x00000000), UINT32_C(0x0000000B)}, {UINT32_C(0x00000000), UINT32_C(0x0000000A)}, {UINT32_C(0x00000001), UINT32_C(0x00008082)}, {UINT32_C(0x00000000), UINT32_C(0x00008003)},
+	{UINT32_C(0x00000001), UINT32_C(0x0000808B)}, {UINT32_C(0x00000001), UINT32_C(0x8000000B)}, {UINT32_C(0x00000001), UINT32_C(0x8000008A)}, {UINT32_C(0x00000001), UINT32_C(0x80000081)},
+	{UINT32_C(0x00000000), UINT32_C(0x80000081)}, {UINT32_C(0x00000000), UINT32_C(0x80000008)}, {UINT32_C(0x00000000), UINT32_C(0x00000083)}, {UINT32_C(0x00000000), UINT32_C(0x80008003)},
+	{UINT32_C(0x00000001), UINT32_C(0x80008088)}, {UINT32_C(0x00000000), UINT32_C(0x80000088)}, {UINT32_C(0x00000001), UINT32_C(0x00008000)}, {UINT32_C(0x00000000), UINT32_C(0x80008082)},
+};
+#endif
+
 const unsigned char Keccak256::ROTATION[5][5] = {
 	{ 0, 36,  3, 41, 18},
 	{ 1, 44, 10, 45,  2},
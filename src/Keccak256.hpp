@@ -10,33 +10,166 @@
 
 #include <cstddef>
 #include <cstdint>
+#include "CpuFeatures.hpp"
+
+// Set to 1 to run the permutation on pairs of 32-bit words holding the even and odd bits of each lane
+// (bit interleaving), which turns each 64-bit rotation into two 32-bit rotations. This defaults to 1 on
+// 32-bit targets (e.g. ESP32, ESP8266), except x86 where a double-word shift already makes 64-bit rotations cheap.
+#if !defined(BCL_KECCAK_INTERLEAVED)
+	#if UINTPTR_MAX <= UINT32_MAX && !defined(__i386__) && !defined(_M_IX86)
+		#define BCL_KECCAK_INTERLEAVED 1
+	#else
+		#define BCL_KECCAK_INTERLEAVED 0
+	#endif
+#endif
 
 namespace bcl {
 
 
 /* 
  * Computes the Keccak-256 hash of a sequence of bytes. The hash value is 32 bytes long.
- * Provides just one static method.
+ * Provides a static method, and an instantiable stateful hasher that absorbs input as it arrives.
+ * A hasher can be checkpointed by copying it, or exported and restored as a midstate (the
+ * 25 words of the sponge) after a whole number of blocks.
  */
 class Keccak256 final {
 	
+	/*---- Scalar constants ----*/
+	
 	public: static constexpr int HASH_LEN = 32;
-	private: static constexpr int BLOCK_SIZE = 200 - HASH_LEN * 2;
+	public: static constexpr int BLOCK_SIZE = 200 - HASH_LEN * 2;  // The rate in bytes
 	private: static constexpr int NUM_ROUNDS = 24;
+	private: static constexpr std::size_t MAX_LANES = 8;
+	
+	
+	
+	/*---- Instance members ----*/
+	
+	private: std::uint64_t state[5][5];  // Accessed through xorLane() and getLane()
+	private: int blockOff;  // Number of bytes of the current block that have been XORed into the state
+	
+	
+	// Constructs a new Keccak-256 hasher with an initially blank message.
+	public: explicit Keccak256();
+	
+	
+	// Constructs a hasher that continues from the given midstate, which is the sponge state
+	// (with lane x + 5 * y at index x + 5 * y) after absorbing a whole number of blocks.
+	public: explicit Keccak256(const std::uint64_t midstate[25]);
+	
+	
+	// Appends message bytes to this ongoing hasher, and returns this object itself.
+	public: Keccak256 &append(const std::uint8_t bytes[], std::size_t len);
+	
 	
+	// Computes the Keccak-256 hash of all the bytes seen. Destroys the state so that no further append() or getHash() will be valid.
+	public: void getHash(std::uint8_t result[HASH_LEN]);
+	
+	
+	// If the number of bytes appended so far is a multiple of BLOCK_SIZE, then this sets outMidstate
+	// to the sponge state and returns true. Otherwise this returns false and leaves the output unchanged.
+	public: bool getMidstate(std::uint64_t outMidstate[25]) const;
+	
+	
+	
+	/*---- Static functions ----*/
 	
 	public: static void getHash(const std::uint8_t msg[], std::size_t len, std::uint8_t hashResult[HASH_LEN]);
 	
 	
+	// For 0 <= i < n, sets out[i] to the hash of msgs[i], i.e. getHash(msgs[i], lens[i], out[i]). When the CPU has AVX-512
+	// or AVX2 (see CpuFeatures), groups of 8 or 4 messages are hashed in parallel in the SIMD lanes, which is fastest for
+	// many messages of similar length (e.g. public keys). Each out[i] may be the same array as msgs[i], but must not
+	// overlap any other message. Not constant-time with respect to the lengths.
+	public: static void getHashes(const std::uint8_t *const msgs[], const std::size_t lens[], std::size_t n, std::uint8_t out[][HASH_LEN]);
+	
+	
+	// Same as getHashes(), but always with the SIMD kernel of the given number of lanes (8 for AVX-512, 4 for AVX2).
+	// Returns false and leaves the output unchanged if the CPU lacks that kernel. For testing and benchmarking each
+	// kernel on a CPU that has several.
+	public: static bool getHashesInLanes(const std::uint8_t *const msgs[], const std::size_t lens[], std::size_t n, std::uint8_t out[][HASH_LEN], std::size_t lanes);
+	
+	
+	// The signature of permuteAvx2() and permuteAvx512().
+	private: typedef void (*PermuteLanes)(std::uint64_t states[]);
+	
+	
+	// Returns the fastest multi-lane permutation function and sets outLanes to its number of lanes,
+	// or returns null if one message at a time is faster on this CPU.
+	private: static PermuteLanes getPermuteLanes(std::size_t &outLanes);
+	
+	
+	// Computes getHashes() in groups with the given function of the given number of lanes,
+	// and one at a time for the remainder. The function may be null if lanes is 0.
+	private: static void getHashes(const std::uint8_t *const msgs[], const std::size_t lens[], std::size_t n, std::uint8_t out[][HASH_LEN],
+		std::size_t lanes, PermuteLanes permuteLanes);
+	
+	
+	// Hashes the given count <= lanes messages at once with the given function, with the blocks scheduled by MultiBuffer.
+	private: static void getHashesLanes(const std::uint8_t *const msgs[], const std::size_t lens[], std::size_t count,
+		std::uint8_t out[][HASH_LEN], std::size_t lanes, PermuteLanes permuteLanes);
+	
+	
+#if defined(BCL_X86)
+	// Applies the permutation to each of 4 states. Lane i (= x + 5 * y) of state j is at states[i * 4 + j].
+	// The CPU must support AVX2.
+	private: static void permuteAvx2(std::uint64_t states[25 * 4]);
+	
+	
+	// Applies the permutation to each of 8 states, like permuteAvx2(). The CPU must support AVX-512F.
+	private: static void permuteAvx512(std::uint64_t states[25 * 8]);
+#endif
+	
+	
+	// XORs the value into lane i (= x + 5 * y) of the state.
+	private: void xorLane(int i, std::uint64_t value);
+	
+	
+	// Returns lane i (= x + 5 * y) of the state.
+	private: std::uint64_t getLane(int i) const;
+	
+	
+	// Applies the Keccak-f[1600] permutation, unrolled with lane complementing. If BCL_KECCAK_INTERLEAVED is 1,
+	// this works on pairs of 32-bit words and the state holds each lane in the form of toInterleaved(). Otherwise
+	// this works on 64-bit lanes, or runs the compact loop over the step mappings if BCL_KECCAK_COMPACT is defined.
 	private: static void absorb(std::uint64_t state[5][5]);
 	
 	
+#if BCL_KECCAK_INTERLEAVED
+	// Returns the lane in the form kept in the state: bits 0, 2, ..., 62 in the low word
+	// and bits 1, 3, ..., 63 in the high word.
+	private: static std::uint64_t toInterleaved(std::uint64_t lane);
+	
+	
+	// Returns the lane whose interleaved form is the given words, the inverse of toInterleaved().
+	private: static std::uint64_t fromInterleaved(std::uint64_t words);
+	
+	
+	// Moves the even bits of x to its low 16 bits and the odd bits to its high 16 bits.
+	private: static std::uint32_t unshuffle(std::uint32_t x);
+	
+	
+	// The inverse of unshuffle().
+	private: static std::uint32_t shuffle(std::uint32_t x);
+	
+	
+	// Requires 0 <= i <= 31
+	private: static std::uint32_t rotl32(std::uint32_t x, int i);
+#endif
+	
+	
 	// Requires 0 <= i <= 63
 	private: static std::uint64_t rotl64(std::uint64_t x, int i);
 	
 	
-	Keccak256() = delete;  // Not instantiable
 	
+	/*---- Array constants ----*/
+	
+	private: static const std::uint64_t ROUND_CONSTANTS[NUM_ROUNDS];
+	
+#if BCL_KECCAK_INTERLEAVED
+	private: static const std::uint32_t ROUND_CONSTANTS_INTERLEAVED[NUM_ROUNDS][2];  // Even and odd bits
+#endif
 	
 	private: static const unsigned char ROTATION[5][5];
 	
@@ -0,0 +1,173 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include <cassert>
+#include <cstring>
+#include <vector>
+#include "MerkleTree.hpp"
+#include "Sha256.hpp"
+
+#if defined(BCL_USE_THREADS)
+	#include <thread>
+#endif
+
+namespace bcl {
+
+using std::uint8_t;
+using std::size_t;
+
+
+// A level is hashed as a byte array of consecutive 64-byte pairs
+static_assert(sizeof(Sha256Hash) == Sha256Hash::HASH_LEN, "Sha256Hash must have no padding");
+
+
+Sha256Hash MerkleTree::computeRoot(Sha256Hash hashes[], size_t len) {
+	assert(hashes != nullptr && len >= 1);
+	while (len > 1)
+		len = hashLevel(hashes, len);
+	return hashes[0];
+}
+
+
+#if defined(BCL_USE_THREADS)
+Sha256Hash MerkleTree::computeRoot(Sha256Hash hashes[], size_t len, size_t numThreads) {
+	assert(hashes != nullptr && len >= 1 && numThreads >= 1);
+	while (len > 1)
+		len = hashLevel(hashes, len, numThreads);
+	return hashes[0];
+}
+#endif
+
+
+size_t MerkleTree::getBranchLen(size_t numLeaves) {
+	size_t result = 0;
+	for (; numLeaves > 1; numLeaves = (numLeaves + 1) / 2)
+		result++;
+	return result;
+}
+
+
+Sha256Hash MerkleTree::computeBranches(Sha256Hash hashes[], size_t len,
+		const size_t indices[], size_t numIndices, Sha256Hash outBranches[]) {
+	assert(hashes != nullptr && len >= 1);
+	assert(indices != nullptr || numIndices == 0);
+	assert(outBranches != nullptr || numIndices == 0 || len == 1);
+	for (size_t k = 0; k < numIndices; k++)
+		assert(indices[k] < len);
+	const size_t branchLen = getBranchLen(len);
+	for (size_t level = 0; len > 1; level++) {
+		// Record the sibling of each index's ancestor at this level, which is itself if it is the odd last node
+		for (size_t k = 0; k < numIndices; k++) {
+			size_t i = indices[k] >> level;
+			size_t sibling = (i ^ 1) < len ? (i ^ 1) : i;
+			outBranches[k * branchLen + level] = hashes[sibling];
+		}
+		len = hashLevel(hashes, len);
+	}
+	return hashes[0];
+}
+
+
+Sha256Hash MerkleTree::computeRootFromBranch(const Sha256Hash &leaf, size_t index,
+		const Sha256Hash branch[], size_t branchLen) {
+	assert(branch != nullptr || branchLen == 0);
+	Sha256Hash result = leaf;
+	for (size_t i = 0; i < branchLen; i++, index >>= 1) {
+		if ((index & 1) == 0)
+			result = hashPair(result, branch[i]);
+		else
+			result = hashPair(branch[i], result);
+	}
+	return result;
+}
+
+
+bool MerkleTree::verifyBranches(const Sha256Hash leaves[], const size_t indices[],
+		const Sha256Hash branches[], size_t branchLen, size_t count, const Sha256Hash &root, bool results[]) {
+	assert((leaves != nullptr && indices != nullptr && results != nullptr) || count == 0);
+	assert(branches != nullptr || count == 0 || branchLen == 0);
+	
+	// Climb all the proofs together, hashing the pairs of one level in a single multi-buffer call
+	std::vector<Sha256Hash> nodes(leaves, leaves + count);
+	std::vector<uint8_t> pairs(count * 2 * Sha256Hash::HASH_LEN);
+	for (size_t level = 0; level < branchLen; level++) {
+		for (size_t k = 0; k < count; k++) {
+			uint8_t *pair = &pairs[k * 2 * Sha256Hash::HASH_LEN];
+			const Sha256Hash &sibling = branches[k * branchLen + level];
+			bool isRight = ((indices[k] >> level) & 1) != 0;
+			std::memcpy(&pair[isRight ? Sha256Hash::HASH_LEN : 0], nodes[k].value, Sha256Hash::HASH_LEN);
+			std::memcpy(&pair[isRight ? 0 : Sha256Hash::HASH_LEN], sibling.value, Sha256Hash::HASH_LEN);
+		}
+		Sha256::getDoubleHashes64(pairs.data(), count, nodes.data());
+	}
+	
+	bool result = true;
+	for (size_t k = 0; k < count; k++) {
+		// An index beyond the tree's width would need more levels than the branch has
+		results[k] = nodes[k] == root && (branchLen >= sizeof(size_t) * 8 || (indices[k] >> branchLen) == 0);
+		result = result && results[k];
+	}
+	return result;
+}
+
+
+size_t MerkleTree::hashLevel(Sha256Hash hashes[], size_t len) {
+	assert(len >= 2);
+	size_t numPairs = len / 2;
+	Sha256::getDoubleHashes64(hashes[0].value, numPairs, hashes);
+	if (len % 2 == 1)  // The last node is at or after index numPairs, so it has not been overwritten
+		hashes[numPairs] = hashPair(hashes[len - 1], hashes[len - 1]);
+	return numPairs + len % 2;
+}
+
+
+#if defined(BCL_USE_THREADS)
+size_t MerkleTree::hashLevel(Sha256Hash hashes[], size_t len, size_t numThreads) {
+	assert(len >= 2 && numThreads >= 1);
+	size_t numPairs = len / 2;
+	if (numThreads > numPairs / MIN_PAIRS_PER_THREAD)
+		numThreads = numPairs / MIN_PAIRS_PER_THREAD;
+	if (numThreads <= 1)
+		return hashLevel(hashes, len);
+	
+	// Each thread hashes its range of pairs [begin, end) in place into the start of its own input
+	// (hashes[2 * begin] onward), so threads never write another thread's input.
+	// Afterward, each thread's output is moved down to hashes[begin], in increasing order.
+	auto hashRange = [hashes, numPairs, numThreads](size_t i) {
+		size_t begin = numPairs * i / numThreads;
+		size_t end = numPairs * (i + 1) / numThreads;
+		Sha256::getDoubleHashes64(hashes[begin * 2].value, end - begin, &hashes[begin * 2]);
+	};
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < numThreads; i++)
+		threads.emplace_back(hashRange, i);
+	hashRange(0);
+	for (std::thread &thread : threads)
+		thread.join();
+	for (size_t i = 1; i < numThreads; i++) {
+		size_t begin = numPairs * i / numThreads;
+		size_t end = numPairs * (i + 1) / numThreads;
+		std::memmove(&hashes[begin], &hashes[begin * 2], (end - begin) * sizeof(Sha256Hash));
+	}
+	
+	if (len % 2 == 1)
+		hashes[numPairs] = hashPair(hashes[len - 1], hashes[len - 1]);
+	return numPairs + len % 2;
+}
+#endif
+
+
+Sha256Hash MerkleTree::hashPair(const Sha256Hash &left, const Sha256Hash &right) {
+	uint8_t pair[Sha256Hash::HASH_LEN * 2];
+	std::memcpy(&pair[0], left.value, Sha256Hash::HASH_LEN);
+	std::memcpy(&pair[Sha256Hash::HASH_LEN], right.value, Sha256Hash::HASH_LEN);
+	return Sha256::getDoubleHash64(pair);
+}
+
+
+}  // namespace bcl
@@ -0,0 +1,93 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#pragma once
+
+#include <cstddef>
+#include "Sha256Hash.hpp"
+
+namespace bcl {
+
+
+/* 
+ * Computes Bitcoin Merkle roots and branches (SPV proofs) over arrays of hashes in internal byte order,
+ * such as transaction IDs. Each node is the double SHA-256 hash of its two children, and a level with an
+ * odd number of nodes pairs its last node with itself. Levels are hashed in place with the multi-buffer
+ * Sha256::getDoubleHashes64(), so computing a root does not allocate memory. Provides only static functions.
+ * Not constant-time (all inputs are public).
+ */
+class MerkleTree final {
+	
+	/*---- Public functions ----*/
+	
+	// Returns the Merkle root of the given len >= 1 leaf hashes. The array is used as scratch space,
+	// so its contents are unspecified afterward.
+	public: static Sha256Hash computeRoot(Sha256Hash hashes[], std::size_t len);
+	
+	
+#if defined(BCL_USE_THREADS)
+	// Returns the same value as computeRoot(hashes, len), but hashes each level that has at least
+	// MIN_PAIRS_PER_THREAD pairs per thread on up to the given number of threads (including the caller).
+	public: static Sha256Hash computeRoot(Sha256Hash hashes[], std::size_t len, std::size_t numThreads);
+#endif
+	
+	
+	// Returns the number of hashes in each branch of a tree with the given number of leaves, which is
+	// the number of levels above the leaves (0 for a single leaf).
+	public: static std::size_t getBranchLen(std::size_t numLeaves);
+	
+	
+	// Returns the Merkle root of the given len >= 1 leaf hashes (using the array as scratch space like computeRoot()),
+	// and writes the branch of each leaf indices[k] to outBranches[k * branchLen + i] for 0 <= i < branchLen,
+	// where branchLen = getBranchLen(len). Each branch lists the sibling hashes from the leaf level upward.
+	public: static Sha256Hash computeBranches(Sha256Hash hashes[], std::size_t len,
+		const std::size_t indices[], std::size_t numIndices, Sha256Hash outBranches[]);
+	
+	
+	// Returns the root of the tree implied by the given leaf at the given index and its branch of the given length.
+	public: static Sha256Hash computeRootFromBranch(const Sha256Hash &leaf, std::size_t index,
+		const Sha256Hash branch[], std::size_t branchLen);
+	
+	
+	// Checks count proofs against the given root, all with the same branch length: proof k is leaves[k]
+	// at indices[k] with the branch at branches[k * branchLen]. Sets results[k] to whether
+	// computeRootFromBranch() gives the root, and returns true iff all proofs are valid.
+	// The proofs are hashed level by level with Sha256::getDoubleHashes64().
+	public: static bool verifyBranches(const Sha256Hash leaves[], const std::size_t indices[],
+		const Sha256Hash branches[], std::size_t branchLen, std::size_t count, const Sha256Hash &root, bool results[]);
+	
+	
+	/*---- Private helper functions ----*/
+	
+	// Replaces the first (len + 1) / 2 hashes with the next level up of the given level of len >= 2 hashes,
+	// and returns the new length.
+	private: static std::size_t hashLevel(Sha256Hash hashes[], std::size_t len);
+	
+	
+#if defined(BCL_USE_THREADS)
+	// Like hashLevel(), but splits the pairs among the given number of threads.
+	private: static std::size_t hashLevel(Sha256Hash hashes[], std::size_t len, std::size_t numThreads);
+#endif
+	
+	
+	// Returns the double SHA-256 hash of the concatenation of the given hashes.
+	private: static Sha256Hash hashPair(const Sha256Hash &left, const Sha256Hash &right);
+	
+	
+	MerkleTree() = delete;  // Not instantiable
+	
+	
+	/*---- Class constants ----*/
+	
+	// The least number of pairs in a level for each thread, so that the work outweighs starting a thread.
+	public: static constexpr std::size_t MIN_PAIRS_PER_THREAD = 4096;
+	
+};
+
+
+}  // namespace bcl
@@ -0,0 +1,69 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include <cstring>
+#include "MultiBuffer.hpp"
+#include "Utils.hpp"
+
+namespace bcl {
+
+using std::uint8_t;
+using std::uint32_t;
+using std::uint64_t;
+using std::size_t;
+
+
+MultiBuffer::MultiBuffer(const uint8_t *const msgArr[], const size_t lens[], size_t count,
+		int blkLen, Padding padding, uint64_t prefixLen) :
+		msgs(msgArr),
+		blockLen(static_cast<size_t>(blkLen)),
+		numWhole(),
+		numBlocks(),
+		maxBlocks(0) {
+	assert(count <= MAX_LANES && 0 < blkLen && blkLen <= MAX_BLOCK_LEN && prefixLen % blockLen == 0);
+	for (size_t i = 0; i < count; i++) {
+		assert(msgs[i] != nullptr || lens[i] == 0);
+		numWhole[i] = lens[i] / blockLen;
+		size_t rem = lens[i] % blockLen;
+		size_t tailLen;
+		if (padding == Padding::KECCAK)
+			tailLen = blockLen;
+		else {
+			size_t lengthLen = padding == Padding::MD_LENGTH_64 ? 8 : 16;
+			tailLen = rem < blockLen - lengthLen ? blockLen : blockLen * 2;
+		}
+		std::memset(tails[i], 0, tailLen);
+		if (rem > 0)
+			std::memcpy(tails[i], &msgs[i][numWhole[i] * blockLen], rem);
+		if (padding == Padding::KECCAK) {
+			tails[i][rem] ^= 0x01;
+			tails[i][tailLen - 1] ^= 0x80;
+		} else {
+			tails[i][rem] = 0x80;
+			uint64_t length = prefixLen + lens[i];
+			if (padding == Padding::MD_LENGTH_128)
+				Utils::storeBigUint32(static_cast<uint32_t>(length >> 61), &tails[i][tailLen - 12]);
+			Utils::storeBigUint32(static_cast<uint32_t>(length >> 29), &tails[i][tailLen - 8]);
+			Utils::storeBigUint32(static_cast<uint32_t>(length << 3), &tails[i][tailLen - 4]);
+		}
+		numBlocks[i] = numWhole[i] + tailLen / blockLen;
+		if (numBlocks[i] > maxBlocks)
+			maxBlocks = numBlocks[i];
+	}
+}
+
+
+size_t MultiBuffer::getGroupLen(size_t i, size_t n, size_t lanes) {
+	if (lanes == 0 || i >= n || (n - i) * 2 < lanes)
+		return 0;
+	return n - i < lanes ? n - i : lanes;
+}
+
+
+
+}  // namespace bcl
@@ -0,0 +1,111 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+namespace bcl {
+
+
+/* 
+ * Schedules the blocks of a group of independent messages for a multi-buffer kernel, which processes one block
+ * of every lane per call (e.g. Sha256::compressAvx2()). This is shared by the getHashes() functions of Sha256,
+ * Sha512 and Keccak256. Each message is split into its whole blocks, which are read in place, and a tail of one
+ * or two blocks, which holds the remaining bytes and the padding. Messages of different lengths finish after
+ * different numbers of blocks, but a finished lane still goes through the kernel, so absorb() saves its state
+ * before each call and restores it afterward. Lanes beyond the number of messages have no blocks at all.
+ * Not constant-time with respect to the lengths.
+ */
+class MultiBuffer final {
+	
+	/*---- Types ----*/
+	
+	// How the tail of a message is padded.
+	public: enum class Padding {
+		MD_LENGTH_64,   // 0x80, zeros, and the 64-bit big-endian length in bits (SHA-256)
+		MD_LENGTH_128,  // 0x80, zeros, and the 128-bit big-endian length in bits (SHA-512)
+		KECCAK,         // 0x01, zeros, and 0x80 XORed into the last byte (Keccak-256)
+	};
+	
+	
+	
+	/*---- Scalar constants ----*/
+	
+	public: static constexpr std::size_t MAX_LANES = 16;
+	public: static constexpr int MAX_BLOCK_LEN = 136;
+	
+	
+	
+	/*---- Fields ----*/
+	
+	private: const std::uint8_t *const *msgs;
+	private: std::size_t blockLen;
+	private: std::uint8_t tails[MAX_LANES][MAX_BLOCK_LEN * 2];
+	private: std::size_t numWhole[MAX_LANES];
+	private: std::size_t numBlocks[MAX_LANES];
+	private: std::size_t maxBlocks;
+	
+	
+	
+	/*---- Constructors ----*/
+	
+	// Schedules the given count <= MAX_LANES messages, whose array and bytes must stay valid while this object is used.
+	// The length field of the padding also counts prefixLen bytes before each message, which were absorbed into the
+	// initial states (a whole number of blocks).
+	public: explicit MultiBuffer(const std::uint8_t *const msgs[], const std::size_t lens[], std::size_t count,
+		int blockLen, Padding padding, std::uint64_t prefixLen);
+	
+	
+	
+	/*---- Methods ----*/
+	
+	// Calls kernel() once for each block index of the longest message. Before each call, load(block, j) is called
+	// for each lane j that has a block at that index, and must put the block into lane j of the kernel's input.
+	// Each lane j of the states array holds stateWords words, at states[i * lanes + j] for 0 <= i < stateWords.
+	public: template <int stateWords, typename Word, typename Load, typename Kernel>
+	void absorb(Word states[], std::size_t lanes, Load load, Kernel kernel) const;
+	
+	
+	// Returns the number of messages from index i of n to process together in the given number of lanes,
+	// or 0 if the rest should be hashed one at a time. A partial group is still worth running if it fills
+	// at least half of the lanes. Returns 0 if lanes is 0, i.e. no kernel is available.
+	public: static std::size_t getGroupLen(std::size_t i, std::size_t n, std::size_t lanes);
+	
+};
+
+
+template <int stateWords, typename Word, typename Load, typename Kernel>
+void MultiBuffer::absorb(Word states[], std::size_t lanes, Load load, Kernel kernel) const {
+	assert(lanes <= MAX_LANES);
+	for (std::size_t k = 0; k < maxBlocks; k++) {
+		Word saved[stateWords * MAX_LANES];
+		for (std::size_t j = 0; j < lanes; j++) {
+			if (k < numWhole[j])
+				load(&msgs[j][k * blockLen], j);
+			else if (k < numBlocks[j])
+				load(&tails[j][(k - numWhole[j]) * blockLen], j);
+			else {
+				for (int i = 0; i < stateWords; i++)
+					saved[i * lanes + j] = states[i * lanes + j];
+			}
+		}
+		kernel();
+		for (std::size_t j = 0; j < lanes; j++) {
+			if (k >= numBlocks[j]) {
+				for (int i = 0; i < stateWords; i++)
+					states[i * lanes + j] = saved[i * lanes + j];
+			}
+		}
+	}
+}
+
+
+}  // namespace bcl
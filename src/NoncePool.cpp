@@ -0,0 +1,148 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#if defined(BCL_USE_THREADS)
+
+#include <cassert>
+#include "CurvePoint.hpp"
+#include "Ecdsa.hpp"
+#include "NoncePool.hpp"
+#include "Utils.hpp"
+
+namespace bcl {
+
+using std::uint8_t;
+using std::uint64_t;
+using std::size_t;
+
+
+NoncePool::NoncePool(size_t capacity, size_t numThreads, const uint8_t seed[32]) :
+		ring(capacity),
+		head(0),
+		count(0),
+		inFlight(0),
+		seedHmac(seed, 32),
+		counter(0),
+		stopping(false) {
+	assert(capacity > 0 && seed != nullptr);
+	for (size_t i = 0; i < numThreads; i++)
+		workers.emplace_back(&NoncePool::workerLoop, this);
+}
+
+
+NoncePool::~NoncePool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	notFull.notify_all();
+	for (std::thread &worker : workers)
+		worker.join();
+	Utils::clearBytes(ring.data(), ring.size() * sizeof(Entry));
+}
+
+
+bool NoncePool::sign(const Uint256 &privateKey, const Sha256Hash &msgHash, Uint256 &outR, Uint256 &outS, uint8_t &outRecId) {
+	if (privateKey == Uint256::ZERO || privateKey >= CurvePoint::ORDER)
+		return false;
+	while (true) {
+		Entry entry;
+		bool found;
+		Uint256 nonce;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			found = count > 0;
+			if (found) {
+				entry = ring[head];
+				Utils::clearBytes(&ring[head], sizeof(Entry));
+				head = (head + 1) % ring.size();
+				count--;
+			} else
+				nonce = nextNonce();
+		}
+		if (found) {
+			notFull.notify_one();
+			changed.notify_all();
+		} else {
+			makeEntry(nonce, entry);
+			Utils::clearBytes(&nonce, sizeof(nonce));
+		}
+		bool ok = Ecdsa::signWithPoint(privateKey, msgHash, entry.point, entry.inverse, outR, outS, outRecId);
+		Utils::clearBytes(&entry, sizeof(entry));
+		if (ok)
+			return true;
+		// Else r or s is zero (vanishing probability), so try the next nonce
+	}
+}
+
+
+size_t NoncePool::getSize() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return count;
+}
+
+
+void NoncePool::waitUntilFull() const {
+	assert(!workers.empty());
+	std::unique_lock<std::mutex> lock(mutex);
+	changed.wait(lock, [this]() { return count == ring.size(); });
+}
+
+
+void NoncePool::workerLoop() {
+	while (true) {
+		Uint256 nonce;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			notFull.wait(lock, [this]() { return stopping || count + inFlight < ring.size(); });
+			if (stopping)
+				return;
+			nonce = nextNonce();
+			inFlight++;
+		}
+		Entry entry;
+		makeEntry(nonce, entry);
+		Utils::clearBytes(&nonce, sizeof(nonce));
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			ring[(head + count) % ring.size()] = entry;
+			count++;
+			inFlight--;
+		}
+		Utils::clearBytes(&entry, sizeof(entry));
+		changed.notify_all();
+	}
+}
+
+
+Uint256 NoncePool::nextNonce() {
+	// k = HMAC-SHA-256(seed, counter as 8 bytes big-endian), skipping values that are out of range
+	while (true) {
+		uint8_t msg[8];
+		for (int i = 0; i < 8; i++)
+			msg[i] = static_cast<uint8_t>(counter >> ((7 - i) * 8));
+		counter++;
+		Sha256Hash hash = seedHmac.getHmac(msg, sizeof(msg));
+		const Uint256 nonce(hash.value);
+		Utils::clearBytes(hash.value, sizeof(hash.value));
+		if (nonce != Uint256::ZERO && nonce < CurvePoint::ORDER)
+			return nonce;
+	}
+}
+
+
+void NoncePool::makeEntry(const Uint256 &nonce, Entry &out) {
+	out.point = AffinePoint(CurvePoint::privateExponentToPublicPoint(nonce));
+	out.inverse = nonce;
+	out.inverse.reciprocal(CurvePoint::ORDER);
+}
+
+
+}  // namespace bcl
+
+#endif  // BCL_USE_THREADS
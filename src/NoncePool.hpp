@@ -0,0 +1,114 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#pragma once
+
+#if defined(BCL_USE_THREADS)
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "AffinePoint.hpp"
+#include "HmacSha256.hpp"
+#include "Sha256Hash.hpp"
+#include "Uint256.hpp"
+
+namespace bcl {
+
+
+/* 
+ * A bounded ring of precomputed ECDSA nonces, filled by background threads, so that signing only needs
+ * a few scalar operations (see Ecdsa::signWithPoint()). Each entry holds the nonce point k * G and the
+ * inverse k^-1 mod CurvePoint::ORDER; the nonce k itself is not kept. The nonces are derived from a secret
+ * seed and a counter with HMAC-SHA-256, so they are unique within a pool and unpredictable without the seed.
+ * Single use: sign() removes its entry from the ring under a lock and wipes the ring slot before signing,
+ * and the destructor wipes all unused entries and the seed. The signatures are not deterministic.
+ */
+class NoncePool final {
+	
+	/*---- Helper structure ----*/
+	
+	private: struct Entry final {
+		AffinePoint point;
+		Uint256 inverse;
+	};
+	
+	
+	/*---- Fields ----*/
+	
+	private: std::vector<Entry> ring;
+	private: std::size_t head;      // Index of the oldest entry
+	private: std::size_t count;     // Number of ready entries
+	private: std::size_t inFlight;  // Number of entries being computed by workers
+	
+	private: HmacSha256 seedHmac;  // Keyed by the seed
+	private: std::uint64_t counter;
+	
+	private: mutable std::mutex mutex;
+	private: std::condition_variable notFull;
+	private: mutable std::condition_variable changed;
+	private: bool stopping;
+	
+	private: std::vector<std::thread> workers;
+	
+	
+	
+	/*---- Constructors ----*/
+	
+	// Starts numThreads background threads that keep the ring filled with up to capacity entries (which must be
+	// positive). With 0 threads, every sign() computes its nonce inline. The seed must be 32 secret random bytes,
+	// and must not be reused for another pool (otherwise nonces would repeat and leak private keys).
+	public: explicit NoncePool(std::size_t capacity, std::size_t numThreads, const std::uint8_t seed[32]);
+	
+	
+	// Stops and joins the background threads, and wipes the unused entries and the seed.
+	public: ~NoncePool();
+	
+	
+	NoncePool(const NoncePool &) = delete;
+	NoncePool &operator=(const NoncePool &) = delete;
+	
+	
+	
+	/*---- Methods ----*/
+	
+	// Signs the message hash with the private key using the oldest ready nonce, or a freshly computed one if the
+	// ring is empty, and also computes the recovery ID. Returns false iff the private key is outside the range
+	// [1, CurvePoint::ORDER); the outputs are assigned iff successful. Safe to call from several threads.
+	// Constant-time with respect to the private key and the nonce, but not whether the ring was empty.
+	public: bool sign(const Uint256 &privateKey, const Sha256Hash &msgHash, Uint256 &outR, Uint256 &outS, std::uint8_t &outRecId);
+	
+	
+	// Returns the number of ready entries.
+	public: std::size_t getSize() const;
+	
+	
+	// Blocks until the ring is full. Requires at least one background thread.
+	public: void waitUntilFull() const;
+	
+	
+	// The loop of each background thread, which computes entries while the ring is not full.
+	private: void workerLoop();
+	
+	
+	// Returns the next nonce in the range [1, CurvePoint::ORDER). The mutex must be held.
+	private: Uint256 nextNonce();
+	
+	
+	// Computes the entry of the given nonce. Constant-time with respect to the nonce.
+	private: static void makeEntry(const Uint256 &nonce, Entry &out);
+	
+};
+
+
+}  // namespace bcl
+
+#endif  // BCL_USE_THREADS
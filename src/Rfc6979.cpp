@@ -0,0 +1,88 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include <cassert>
+#include <cstring>
+#include "CurvePoint.hpp"
+#include "Rfc6979.hpp"
+
+namespace bcl {
+
+using std::uint8_t;
+using std::size_t;
+
+
+Rfc6979::Rfc6979(const Uint256 &privateKey, const Sha256Hash &msgHash, const uint8_t extraEntropy[], size_t extraLen) :
+		hmacK(ZERO_KEY, sizeof(ZERO_KEY)),
+		hasOutput(false) {
+	/* 
+	 * Seed = int2octets(privateKey) || bits2octets(msgHash) || extraEntropy
+	 * V = 0x01 0x01 ... 0x01
+	 * K = 0x00 0x00 ... 0x00
+	 * K = HMAC_K(V || 0x00 || seed); V = HMAC_K(V)
+	 * K = HMAC_K(V || 0x01 || seed); V = HMAC_K(V)
+	 */
+	assert(extraEntropy != nullptr || extraLen == 0);
+	constexpr size_t HASH_LEN = Sha256Hash::HASH_LEN;
+	
+	// bits2octets(h) = int2octets(h mod order), since the hash and the order are both 256 bits long
+	Uint256 h(msgHash.value);
+	h.subtract(CurvePoint::ORDER, static_cast<std::uint32_t>(h >= CurvePoint::ORDER));
+	uint8_t seed[HASH_LEN * 2];
+	privateKey.getBigEndianBytes(&seed[0]);
+	h.getBigEndianBytes(&seed[HASH_LEN]);
+	
+	std::memset(v, 0x01, sizeof(v));
+	for (uint8_t marker = 0; marker < 2; marker++) {
+		Sha256 hasher = hmacK.getInnerHasher();
+		hasher.append(v, sizeof(v)).append(&marker, 1).append(seed, sizeof(seed)).append(extraEntropy, extraLen);
+		setKey(hmacK.finish(hasher));
+		updateV();
+	}
+}
+
+
+Uint256 Rfc6979::next() {
+	if (hasOutput)
+		reseed();
+	hasOutput = true;
+	while (true) {
+		updateV();
+		const Uint256 k(v);
+		if (k != Uint256::ZERO && k < CurvePoint::ORDER)
+			return k;
+		reseed();
+	}
+}
+
+
+void Rfc6979::reseed() {
+	const uint8_t marker = 0x00;
+	Sha256 hasher = hmacK.getInnerHasher();
+	hasher.append(v, sizeof(v)).append(&marker, 1);
+	setKey(hmacK.finish(hasher));
+	updateV();
+}
+
+
+void Rfc6979::updateV() {
+	const Sha256Hash hash = hmacK.getHmac(v, sizeof(v));
+	std::memcpy(v, hash.value, sizeof(v));
+}
+
+
+void Rfc6979::setKey(const Sha256Hash &key) {
+	hmacK = HmacSha256(key.value, Sha256Hash::HASH_LEN);
+}
+
+
+// Static initializers
+const uint8_t Rfc6979::ZERO_KEY[Sha256Hash::HASH_LEN] = {};
+
+
+}  // namespace bcl
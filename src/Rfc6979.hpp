@@ -0,0 +1,77 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "HmacSha256.hpp"
+#include "Sha256Hash.hpp"
+#include "Uint256.hpp"
+
+namespace bcl {
+
+
+/* 
+ * The deterministic nonce generator of RFC 6979 for secp256k1 with HMAC-SHA-256 (HMAC-DRBG),
+ * with optional extra entropy appended to the seed as in section 3.6 of the RFC.
+ * Each HMAC with the current key K uses a cached HmacSha256 context, so only the message blocks
+ * are compressed per call.
+ */
+class Rfc6979 final {
+	
+	/*---- Fields ----*/
+	
+	private: std::uint8_t v[Sha256Hash::HASH_LEN];
+	
+	private: HmacSha256 hmacK;  // Keyed by the current key K
+	
+	private: bool hasOutput;  // Whether next() has returned a nonce, so the next call must reseed first
+	
+	
+	
+	/*---- Constructors ----*/
+	
+	// Seeds the generator with the given private key, message hash, and optional extra entropy (which
+	// may be null iff extraLen is 0), following steps (b) to (g) of RFC 6979 section 3.2. The private key
+	// should be in the range [1, CurvePoint::ORDER). Constant-time with respect to all the values.
+	public: explicit Rfc6979(const Uint256 &privateKey, const Sha256Hash &msgHash,
+		const std::uint8_t extraEntropy[] = nullptr, std::size_t extraLen = 0);
+	
+	
+	
+	/*---- Methods ----*/
+	
+	// Returns the next nonce in the range [1, CurvePoint::ORDER). The first call returns the RFC 6979 nonce,
+	// and each later call returns the nonce that the RFC specifies for retrying after the previous nonce
+	// was rejected (e.g. because it gave r = 0 or s = 0). Constant-time with respect to the state, except
+	// for the vanishingly unlikely case that a candidate is out of range and must be skipped.
+	public: Uint256 next();
+	
+	
+	// Sets K = HMAC_K(V || 0x00), then V = HMAC_K(V), as in step (h.3) of the RFC.
+	private: void reseed();
+	
+	
+	// Sets V = HMAC_K(V).
+	private: void updateV();
+	
+	
+	// Sets K to the given value.
+	private: void setKey(const Sha256Hash &key);
+	
+	
+	
+	/*---- Class constants ----*/
+	
+	private: static const std::uint8_t ZERO_KEY[Sha256Hash::HASH_LEN];  // The initial K
+	
+};
+
+
+}  // namespace bcl
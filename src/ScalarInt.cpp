@@ -0,0 +1,180 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include <cassert>
+#include <cstring>
+#include "ScalarInt.hpp"
+
+namespace bcl {
+
+using std::uint32_t;
+using std::uint64_t;
+
+
+ScalarInt::ScalarInt(const char *str) :
+		Uint256(str) {
+	// Same static initialization order consideration as in FieldInt(const char *)
+	if (MODULUS.value[0] != 0)
+		assert(*this < MODULUS);
+}
+
+
+ScalarInt::ScalarInt(const Uint256 &val) :
+		Uint256(val) {
+	Uint256::subtract(MODULUS, static_cast<uint32_t>(*this >= MODULUS));
+	assert(*this < MODULUS);
+}
+
+
+void ScalarInt::add(const ScalarInt &other) {
+	uint32_t c = Uint256::add(other);  // Perform addition
+	assert((c >> 1) == 0);
+	Uint256::subtract(MODULUS, c | static_cast<uint32_t>(*this >= MODULUS));  // Conditionally subtract modulus
+}
+
+
+void ScalarInt::subtract(const ScalarInt &other) {
+	uint32_t b = Uint256::subtract(other);  // Perform subtraction
+	assert((b >> 1) == 0);
+	Uint256::add(MODULUS, b);  // Conditionally add modulus
+}
+
+
+void ScalarInt::negate() {
+	Uint256 temp = MODULUS;
+	temp.subtract(*this);
+	temp.subtract(MODULUS, static_cast<uint32_t>(temp == MODULUS));  // For zero
+	Uint256::replace(temp, 1);
+}
+
+
+void ScalarInt::multiply(const ScalarInt &other) {
+	uint32_t product0[NUM_WORDS * 2];
+	multiplyFull(this->value, other.value, product0);
+	
+	// Because 2^256 = FOLD_CONSTANT mod MODULUS and FOLD_CONSTANT < 2^129, replacing the
+	// high words with their product with FOLD_CONSTANT shrinks the number each time:
+	// 512 bits -> less than 386 bits -> less than 260 bits -> less than 2^256 + 2^133.
+	uint32_t product1[NUM_WORDS + 6];
+	fold(product0, NUM_WORDS * 2, product1, NUM_WORDS + 6);
+	uint32_t product2[NUM_WORDS + 4];
+	fold(product1, NUM_WORDS + 6, product2, NUM_WORDS + 4);
+	uint32_t product3[NUM_WORDS + 2];
+	fold(product2, NUM_WORDS + 4, product3, NUM_WORDS + 2);
+	assert(product3[NUM_WORDS + 1] == 0 && (product3[NUM_WORDS] >> 1) == 0);
+	
+	// Final conditional subtraction to yield a ScalarInt value, since the value is less than 2 * MODULUS
+	std::memcpy(this->value, product3, sizeof(value));
+	uint32_t dosub = static_cast<uint32_t>((product3[NUM_WORDS] != 0) | (*this >= MODULUS));
+	Uint256::subtract(MODULUS, dosub);
+}
+
+
+void ScalarInt::splitLambda(ScalarInt &r1, ScalarInt &r2) const {
+	/* 
+	 * (See the GLV method, as implemented in libsecp256k1's scalar_split_lambda.) Algorithm pseudocode:
+	 * c1 = round(k * G1 / 2^384)  // Approximately k * b2 / MODULUS
+	 * c2 = round(k * G2 / 2^384)  // Approximately k * -b1 / MODULUS
+	 * r2 = c1 * MINUS_B1 + c2 * MINUS_B2
+	 * r1 = k - r2 * LAMBDA
+	 */
+	assert(&r1 != this && &r2 != this && &r1 != &r2);
+	const Uint256 k(*this);
+	ScalarInt c1(multiplyShift384(k, G1));
+	ScalarInt c2(multiplyShift384(k, G2));
+	c1.multiply(MINUS_B1);
+	c2.multiply(MINUS_B2);
+	r2 = c1;
+	r2.add(c2);
+	r1 = r2;
+	r1.multiply(LAMBDA);
+	r1.negate();
+	r1.add(*this);
+}
+
+
+void ScalarInt::multiplyFull(const uint32_t x[NUM_WORDS], const uint32_t y[NUM_WORDS], uint32_t out[NUM_WORDS * 2]) {
+	// Long multiplication of (uint256 x) * (uint256 y) = (uint512 out)
+	for (int i = 0; i < NUM_WORDS * 2; i++)
+		out[i] = 0;
+	for (int i = 0; i < NUM_WORDS; i++) {
+		uint32_t carry = 0;
+		for (int j = 0; j < NUM_WORDS; j++) {
+			uint64_t sum = static_cast<uint64_t>(x[i]) * y[j];
+			sum += static_cast<uint64_t>(out[i + j]) + carry;  // Does not overflow
+			out[i + j] = static_cast<uint32_t>(sum);
+			carry = static_cast<uint32_t>(sum >> 32);
+		}
+		out[i + NUM_WORDS] = carry;
+	}
+}
+
+
+Uint256 ScalarInt::multiplyShift384(const Uint256 &x, const Uint256 &y) {
+	uint32_t product[NUM_WORDS * 2];
+	multiplyFull(x.value, y.value, product);
+	Uint256 result;
+	for (int i = 0; i < NUM_WORDS; i++)
+		result.value[i] = i < 4 ? product[12 + i] : 0;
+	Uint256 round = Uint256::ZERO;
+	round.value[0] = product[11] >> 31;  // Bit 383
+	result.add(round);  // Does not overflow
+	return result;
+}
+
+
+void ScalarInt::fold(const uint32_t in[], int inLen, uint32_t out[], int outLen) {
+	assert(inLen > NUM_WORDS && outLen >= NUM_WORDS + 1 && outLen >= inLen - NUM_WORDS + 5 + 1);
+	for (int i = 0; i < outLen; i++)
+		out[i] = i < NUM_WORDS ? in[i] : 0;
+	for (int i = 0; i < inLen - NUM_WORDS; i++) {
+		uint32_t carry = 0;
+		for (int j = i; j < outLen; j++) {
+			uint64_t sum = static_cast<uint64_t>(out[j]) + carry;
+			if (j - i < 5)
+				sum += static_cast<uint64_t>(in[NUM_WORDS + i]) * FOLD_CONSTANT[j - i];  // Does not overflow
+			out[j] = static_cast<uint32_t>(sum);
+			carry = static_cast<uint32_t>(sum >> 32);
+		}
+		assert(carry == 0);
+	}
+}
+
+
+void ScalarInt::reciprocal() {
+	Uint256::reciprocal(MODULUS);
+}
+
+
+void ScalarInt::replace(const ScalarInt &other, uint32_t enable) {
+	Uint256::replace(other, enable);
+}
+
+
+bool ScalarInt::operator==(const ScalarInt &other) const {
+	return Uint256::operator==(other);
+}
+
+bool ScalarInt::operator!=(const ScalarInt &other) const {
+	return Uint256::operator!=(other);
+}
+
+
+// Static initializers
+const Uint256 ScalarInt::MODULUS("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141");
+const uint32_t ScalarInt::FOLD_CONSTANT[5] = {
+	UINT32_C(0x2FC9BEBF), UINT32_C(0x402DA173), UINT32_C(0x50B75FC4), UINT32_C(0x45512319), UINT32_C(0x00000001),
+};
+const ScalarInt ScalarInt::LAMBDA  ("5363AD4CC05C30E0A5261C028812645A122E22EA20816678DF02967C1B23BD72");
+const Uint256   ScalarInt::G1      ("3086D221A7D46BCDE86C90E49284EB153DAA8A1471E8CA7FE893209A45DBB031");
+const Uint256   ScalarInt::G2      ("E4437ED6010E88286F547FA90ABFE4C4221208AC9DF506C61571B4AE8AC47F71");
+const ScalarInt ScalarInt::MINUS_B1("00000000000000000000000000000000E4437ED6010E88286F547FA90ABFE4C3");
+const ScalarInt ScalarInt::MINUS_B2("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFE8A280AC50774346DD765CDA83DB1562C");
+
+
+}  // namespace bcl
@@ -0,0 +1,121 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "Uint256.hpp"
+
+namespace bcl {
+
+
+/* 
+ * An unsigned 256-bit integer modulo the order of the secp256k1 base point (CurvePoint::ORDER),
+ * for private keys, nonces, and signature values. The input and output values of each method
+ * are always in the range [0, MODULUS).
+ * 
+ * This is the counterpart of FieldInt for scalars. The number representation format is the
+ * same as Uint256. It is illegal to set the value to be greater than or equal to MODULUS;
+ * undefined behavior will result. Instances of this class are mutable.
+ */
+class ScalarInt final : private Uint256 {
+	
+	public: using Uint256::NUM_WORDS;
+	
+	/*---- Fields ----*/
+	
+	public: using Uint256::value;
+	
+	
+	
+	/*---- Constructors ----*/
+	
+	// Constructs a ScalarInt from the given 64-character hexadecimal string. Not constant-time.
+	// If the syntax of the string is invalid, then an assertion will fail.
+	public: explicit ScalarInt(const char *str);
+	
+	
+	// Constructs a ScalarInt from the given Uint256, reducing it as necessary.
+	// Constant-time with respect to the given value.
+	public: explicit ScalarInt(const Uint256 &val);
+	
+	
+	
+	/*---- Arithmetic methods ----*/
+	
+	// Adds the given number into this number, modulo the order. Constant-time with respect to both values.
+	public: void add(const ScalarInt &other);
+	
+	
+	// Subtracts the given number from this number, modulo the order. Constant-time with respect to both values.
+	public: void subtract(const ScalarInt &other);
+	
+	
+	// Negates this number, modulo the order. Constant-time with respect to this value.
+	public: void negate();
+	
+	
+	// Multiplies the given number into this number, modulo the order. Constant-time with respect to both values.
+	public: void multiply(const ScalarInt &other);
+	
+	
+	// Computes the multiplicative inverse of this number with respect to the modulus.
+	// If this number is zero, the reciprocal is zero. Constant-time with respect to this value.
+	public: void reciprocal();
+	
+	
+	// Splits this number k into r1 and r2 such that k = r1 + r2 * LAMBDA (mod MODULUS), where r1 and r2 are each
+	// either less than 2^128 or greater than MODULUS - 2^128 (i.e. small negative numbers). This is the GLV
+	// decomposition used by CurvePoint::multiplyEndomorphism(). Constant-time with respect to this value.
+	public: void splitLambda(ScalarInt &r1, ScalarInt &r2) const;
+	
+	
+	// Computes the full 512-bit product of the given numbers. Constant-time with respect to both values.
+	private: static void multiplyFull(const std::uint32_t x[NUM_WORDS], const std::uint32_t y[NUM_WORDS], std::uint32_t out[NUM_WORDS * 2]);
+	
+	
+	// Returns round(x * y / 2^384). Constant-time with respect to both values.
+	private: static Uint256 multiplyShift384(const Uint256 &x, const Uint256 &y);
+	
+	
+	// Sets out = in[0 : 8] + in[8 : inLen] * (2^256 - MODULUS), which is congruent to in modulo MODULUS.
+	// Requires outLen >= max(8, inLen - 3) + 1, and the value of out must fit. Constant-time with respect to the values.
+	private: static void fold(const std::uint32_t in[], int inLen, std::uint32_t out[], int outLen);
+	
+	
+	/*---- Miscellaneous methods ----*/
+	
+	public: void replace(const ScalarInt &other, std::uint32_t enable);
+	
+	public: using Uint256::getBigEndianBytes;
+	
+	
+	/*---- Equality and inequality operators ----*/
+	
+	public: bool operator==(const ScalarInt &other) const;
+	
+	public: bool operator!=(const ScalarInt &other) const;
+	
+	
+	
+	/*---- Class constants ----*/
+	
+	private: static const Uint256 MODULUS;  // Prime number, equal to CurvePoint::ORDER
+	
+	private: static const std::uint32_t FOLD_CONSTANT[5];  // 2^256 - MODULUS, in little endian
+	
+	public: static const ScalarInt LAMBDA;     // Cube root of unity, such that LAMBDA * (x, y) = (CurvePoint::BETA * x, y)
+	private: static const Uint256 G1;          // Rounding multipliers and lattice basis for splitLambda()
+	private: static const Uint256 G2;
+	private: static const ScalarInt MINUS_B1;
+	private: static const ScalarInt MINUS_B2;
+	
+};
+
+
+}  // namespace bcl
@@ -0,0 +1,197 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include <cassert>
+#include <cstring>
+#include "AffinePoint.hpp"
+#include "Schnorr.hpp"
+#include "Sha256Hash.hpp"
+
+namespace bcl {
+
+using std::uint8_t;
+using std::uint32_t;
+using std::size_t;
+
+
+bool Schnorr::sign(const Uint256 &privateKey, const uint8_t msg[32], const uint8_t auxRand[32], uint8_t outSig[64]) {
+	/* 
+	 * Algorithm pseudocode:
+	 * if (privateKey outside range [1, order-1]) return false
+	 * p = privateKey * G
+	 * d = p.y is even ? privateKey : order - privateKey
+	 * t = bytes(d) XOR hashAux(auxRand)
+	 * k = hashNonce(t || bytes(p.x) || msg) % order
+	 * if (k == 0) return false
+	 * r = k * G
+	 * k = r.y is even ? k : order - k
+	 * e = hashChallenge(bytes(r.x) || bytes(p.x) || msg) % order
+	 * sig = bytes(r.x) || bytes((k + e * d) % order)
+	 */
+	assert(msg != nullptr && auxRand != nullptr && outSig != nullptr);
+	if (privateKey == Uint256::ZERO || privateKey >= CurvePoint::ORDER)
+		return false;
+	
+	const CurvePoint p = CurvePoint::privateExponentToPublicPoint(privateKey);
+	uint8_t pBytes[32];
+	p.x.getBigEndianBytes(pBytes);
+	ScalarInt d(privateKey);
+	ScalarInt negD = d;
+	negD.negate();
+	d.replace(negD, p.y.value[0] & 1);
+	
+	uint8_t t[32];
+	d.getBigEndianBytes(t);
+	const Sha256Hash auxHash = getTaggedHasher(AUX_MIDSTATE).append(auxRand, 32).getHash();
+	for (int i = 0; i < 32; i++)
+		t[i] ^= auxHash.value[i];
+	const Sha256Hash nonceHash = getTaggedHasher(NONCE_MIDSTATE).append(t, sizeof(t)).append(pBytes, sizeof(pBytes)).append(msg, 32).getHash();
+	ScalarInt k(Uint256(nonceHash.value));
+	if (Uint256(k) == Uint256::ZERO)
+		return false;
+	
+	const CurvePoint r = CurvePoint::privateExponentToPublicPoint(Uint256(k));
+	ScalarInt negK = k;
+	negK.negate();
+	k.replace(negK, r.y.value[0] & 1);
+	uint8_t rBytes[32];
+	r.x.getBigEndianBytes(rBytes);
+	
+	ScalarInt s = getChallenge(getTaggedHasher(CHALLENGE_MIDSTATE), rBytes, pBytes, msg);
+	s.multiply(d);
+	s.add(k);
+	std::memcpy(&outSig[0], rBytes, sizeof(rBytes));
+	s.getBigEndianBytes(&outSig[32]);
+	return true;
+}
+
+
+bool Schnorr::verify(const uint8_t publicKey[32], const uint8_t msg[32], const uint8_t sig[64]) {
+	/* 
+	 * Algorithm pseudocode:
+	 * p = the point with x-coordinate publicKey and even y, or fail
+	 * r = sig[0 : 32], s = sig[32 : 64]
+	 * if (s >= order) return false
+	 * e = hashChallenge(r || publicKey || msg) % order
+	 * q = s * G - e * p
+	 * return q != zero && q.y is even && q.x == r
+	 */
+	assert(publicKey != nullptr && msg != nullptr && sig != nullptr);
+	CurvePoint p = CurvePoint::ZERO;
+	if (!CurvePoint::fromX(Uint256(publicKey), 0, p))
+		return false;
+	const Uint256 r(&sig[0]);
+	const Uint256 s(&sig[32]);
+	if (s >= CurvePoint::ORDER)
+		return false;
+	
+	ScalarInt negE = getChallenge(getTaggedHasher(CHALLENGE_MIDSTATE), &sig[0], publicKey, msg);
+	negE.negate();
+	CurvePoint q = CurvePoint::multiplyDualVartime(s, p, Uint256(negE));
+	if (q.isZero())
+		return false;
+	q.normalize();
+	return (q.y.value[0] & 1) == 0 && Uint256(q.x) == r;
+}
+
+
+bool Schnorr::verifyBatch(const uint8_t publicKeys[][32], const uint8_t msgs[][32], const uint8_t sigs[][64], size_t len) {
+	/* 
+	 * Checks the single equation sum(a[i] * s[i]) * G == sum(a[i] * r[i] + a[i] * e[i] * p[i]),
+	 * where r[i] and p[i] are the points with even y lifted from the signature and public key.
+	 * a[0] = 1, and the other a[i] are 128-bit values derived from a hash of all the inputs,
+	 * so a forger cannot pick invalid signatures whose errors cancel out.
+	 */
+	assert((publicKeys != nullptr && msgs != nullptr && sigs != nullptr) || len == 0);
+	const Sha256 challengeHasher = getTaggedHasher(CHALLENGE_MIDSTATE);
+	Sha256 seedHasher = getTaggedHasher(BATCH_MIDSTATE);
+	for (size_t i = 0; i < len; i++)
+		seedHasher.append(publicKeys[i], 32).append(msgs[i], 32).append(sigs[i], 64);
+	const Sha256Hash seed = seedHasher.getHash();
+	
+	// Each chunk of signatures contributes one (r, p) pair of points to a multi-scalar multiplication
+	constexpr size_t chunkLen = CurvePoint::MULTI_CHUNK_LEN / 2;
+	AffinePoint points[chunkLen * 2];
+	Uint256 scalars[chunkLen * 2];
+	ScalarInt gScalar(Uint256::ZERO);
+	CurvePoint sum = CurvePoint::ZERO;
+	for (size_t start = 0; start < len; start += chunkLen) {
+		size_t count = len - start < chunkLen ? len - start : chunkLen;
+		for (size_t j = 0; j < count; j++) {
+			size_t i = start + j;
+			CurvePoint p = CurvePoint::ZERO;
+			CurvePoint r = CurvePoint::ZERO;
+			const Uint256 s(&sigs[i][32]);
+			if (!CurvePoint::fromX(Uint256(publicKeys[i]), 0, p) || !CurvePoint::fromX(Uint256(&sigs[i][0]), 0, r) || s >= CurvePoint::ORDER)
+				return false;
+			
+			Uint256 a = Uint256::ONE;
+			if (i > 0) {
+				const uint8_t index[4] = {
+					static_cast<uint8_t>(i >> 24), static_cast<uint8_t>(i >> 16),
+					static_cast<uint8_t>(i >>  8), static_cast<uint8_t>(i >>  0),
+				};
+				const Sha256Hash h = Sha256().append(seed.value, Sha256Hash::HASH_LEN).append(index, sizeof(index)).getHash();
+				uint8_t aBytes[32] = {};
+				std::memcpy(&aBytes[16], h.value, 16);
+				a = Uint256(aBytes);
+			}
+			ScalarInt as(s);
+			as.multiply(ScalarInt(a));
+			gScalar.add(as);
+			ScalarInt ae = getChallenge(challengeHasher, &sigs[i][0], publicKeys[i], msgs[i]);
+			ae.multiply(ScalarInt(a));
+			
+			points[j * 2 + 0] = AffinePoint(r);
+			scalars[j * 2 + 0] = a;
+			points[j * 2 + 1] = AffinePoint(p);
+			scalars[j * 2 + 1] = Uint256(ae);
+		}
+		sum.add(CurvePoint::multiplyMultiVartime(points, scalars, count * 2));
+	}
+	
+	gScalar.negate();
+	CurvePoint g = CurvePoint::G;
+	g.multiplyVartime(Uint256(gScalar));
+	sum.add(g);
+	return sum.isZero();
+}
+
+
+Sha256 Schnorr::getTaggedHasher(const uint32_t midstate[8]) {
+	return Sha256(midstate, Sha256::BLOCK_LEN);
+}
+
+
+ScalarInt Schnorr::getChallenge(const Sha256 &hasher, const uint8_t r[32], const uint8_t publicKey[32], const uint8_t msg[32]) {
+	Sha256 temp = hasher;
+	const Sha256Hash hash = temp.append(r, 32).append(publicKey, 32).append(msg, 32).getHash();
+	return ScalarInt(Uint256(hash.value));
+}
+
+
+// Static initializers
+const uint32_t Schnorr::AUX_MIDSTATE[8] = {
+	UINT32_C(0x24DD3219), UINT32_C(0x4EBA7E70), UINT32_C(0xCA0FABB9), UINT32_C(0x0FA3166D),
+	UINT32_C(0x3AFBE4B1), UINT32_C(0x4C44DF97), UINT32_C(0x4AAC2739), UINT32_C(0x249E850A),
+};
+const uint32_t Schnorr::NONCE_MIDSTATE[8] = {
+	UINT32_C(0x46615B35), UINT32_C(0xF4BFBFF7), UINT32_C(0x9F8DC671), UINT32_C(0x83627AB3),
+	UINT32_C(0x60217180), UINT32_C(0x57358661), UINT32_C(0x21A29E54), UINT32_C(0x68B07B4C),
+};
+const uint32_t Schnorr::CHALLENGE_MIDSTATE[8] = {
+	UINT32_C(0x9CECBA11), UINT32_C(0x23925381), UINT32_C(0x11679112), UINT32_C(0xD1627E0F),
+	UINT32_C(0x97C87550), UINT32_C(0x003CC765), UINT32_C(0x90F61164), UINT32_C(0x33E9B66A),
+};
+const uint32_t Schnorr::BATCH_MIDSTATE[8] = {
+	UINT32_C(0x79E3E0D2), UINT32_C(0x12284F32), UINT32_C(0xD7D89E1C), UINT32_C(0x6491EA9A),
+	UINT32_C(0xAD823B2F), UINT32_C(0xFACFE0B6), UINT32_C(0x342B78BA), UINT32_C(0x12ECE87C),
+};
+
+
+}  // namespace bcl
@@ -0,0 +1,73 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "CurvePoint.hpp"
+#include "ScalarInt.hpp"
+#include "Sha256.hpp"
+#include "Uint256.hpp"
+
+namespace bcl {
+
+
+/* 
+ * Performs BIP 340 Schnorr signature generation and verification, with 32-byte x-only public keys
+ * (see AffinePoint::toXOnly()), 32-byte messages, and 64-byte signatures. Provides only static functions.
+ */
+class Schnorr final {
+	
+	// Computes the signature of the given message with the given private key and auxiliary random data, following
+	// the BIP 340 default signing algorithm. Returns true if signing was successful (overwhelming probability), or
+	// false if the private key is outside the range [1, CurvePoint::ORDER) or a vanishingly unlikely nonce occurred.
+	// The output is assigned iff signing is successful. The auxiliary data should be 32 fresh random bytes, but signing
+	// is still secure with all zeros. Constant-time with respect to the private key and the auxiliary data.
+	public: static bool sign(const Uint256 &privateKey, const std::uint8_t msg[32], const std::uint8_t auxRand[32], std::uint8_t outSig[64]);
+	
+	
+	// Checks whether the given signature, message, and x-only public key are valid together.
+	// This function does not need to be constant-time because all inputs are public.
+	public: static bool verify(const std::uint8_t publicKey[32], const std::uint8_t msg[32], const std::uint8_t sig[64]);
+	
+	
+	// Checks whether all the given (public key, message, signature) triples are valid, by checking a random linear
+	// combination of their verification equations with one multi-scalar multiplication, which is considerably faster
+	// than calling verify() on each one. Returns true if len is 0. If the result is false, at least one triple is
+	// invalid, but this does not say which one. The random coefficients are derived by hashing all the inputs.
+	// Not constant-time, because all inputs are public.
+	public: static bool verifyBatch(const std::uint8_t publicKeys[][32], const std::uint8_t msgs[][32], const std::uint8_t sigs[][64], std::size_t len);
+	
+	
+	// Returns a SHA-256 hasher primed with the BIP 340 prefix SHA256(tag) || SHA256(tag),
+	// given the midstate after that 64-byte prefix (one of the *_MIDSTATE constants).
+	private: static Sha256 getTaggedHasher(const std::uint32_t midstate[8]);
+	
+	
+	// Returns the challenge hash e of the given R x-coordinate, x-only public key, and message, reduced modulo
+	// the order. The hasher must come from getTaggedHasher(CHALLENGE_MIDSTATE) and is copied.
+	private: static ScalarInt getChallenge(const Sha256 &hasher, const std::uint8_t r[32], const std::uint8_t publicKey[32], const std::uint8_t msg[32]);
+	
+	
+	Schnorr() = delete;  // Not instantiable
+	
+	
+	/*---- Class constants ----*/
+	
+	// The SHA-256 midstates after the prefixes of the tags "BIP0340/aux", "BIP0340/nonce",
+	// "BIP0340/challenge", and "BIP0340/batch", so that no tagged hash recomputes its prefix.
+	private: static const std::uint32_t AUX_MIDSTATE[8];
+	private: static const std::uint32_t NONCE_MIDSTATE[8];
+	private: static const std::uint32_t CHALLENGE_MIDSTATE[8];
+	private: static const std::uint32_t BATCH_MIDSTATE[8];
+	
+};
+
+
+}  // namespace bcl
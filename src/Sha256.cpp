@@ -8,9 +8,15 @@
 
 #include <cassert>
 #include <cstring>
+#include "HmacSha256.hpp"
+#include "MultiBuffer.hpp"
 #include "Sha256.hpp"
 #include "Utils.hpp"
 
+#if defined(BCL_X86)
+	#include <immintrin.h>
+#endif
+
 namespace bcl {
 
 using std::uint8_t;
@@ -20,40 +26,77 @@ using std::size_t;
 
 
 Sha256::Sha256() :
-	length(0),
-	bufferLen(0) {}
+		length(0),
+		bufferLen(0) {
+	std::memcpy(state, INITIAL_STATE, sizeof(state));
+}
+
+
+Sha256::Sha256(const uint32_t midstate[8], uint64_t len) :
+		length(len),
+		bufferLen(0) {
+	assert(midstate != nullptr && len % BLOCK_LEN == 0);
+	std::memcpy(state, midstate, sizeof(state));
+}
 
 
 Sha256 &Sha256::append(const uint8_t bytes[], size_t len) {
 	assert(bytes != nullptr || len == 0);
-	for (size_t i = 0; i < len; i++) {
-		buffer[bufferLen] = bytes[i];
-		bufferLen++;
-		if (bufferLen == BLOCK_LEN) {
-			compress(state, buffer);
-			bufferLen = 0;
-		}
-	}
 	length += len;
+	
+	// Top up a partially filled buffer
+	if (bufferLen > 0) {
+		size_t n = static_cast<size_t>(BLOCK_LEN - bufferLen);
+		if (n > len)
+			n = len;
+		Utils::copyBytes(&buffer[bufferLen], bytes, n);
+		bufferLen += static_cast<int>(n);
+		bytes += n;
+		len -= n;
+		if (bufferLen < BLOCK_LEN)
+			return *this;
+		compressBlocks(state, buffer, 1);
+		bufferLen = 0;
+	}
+	
+	// Compress whole blocks straight from the input, and keep the rest
+	size_t numBlocks = len / BLOCK_LEN;
+	if (numBlocks > 0) {
+		compressBlocks(state, bytes, numBlocks);
+		bytes += numBlocks * BLOCK_LEN;
+		len -= numBlocks * BLOCK_LEN;
+	}
+	Utils::copyBytes(buffer, bytes, len);
+	bufferLen = static_cast<int>(len);
 	return *this;
 }
 
 
 Sha256Hash Sha256::getHash() {
+	// Pad with the 0x80 byte, zeros, and the length in bits, in one or two blocks
 	uint64_t bitLength = length << 3;
-	uint8_t temp = 0x80;
-	append(&temp, 1);
-	temp = 0x00;
-	while (bufferLen != 56)
-		append(&temp, 1);
-	for (int i = 0; i < 8; i++) {
-		temp = static_cast<uint8_t>(bitLength >> ((7 - i) << 3));
-		append(&temp, 1);
+	buffer[bufferLen] = 0x80;
+	bufferLen++;
+	if (bufferLen > BLOCK_LEN - 8) {
+		std::memset(&buffer[bufferLen], 0, static_cast<size_t>(BLOCK_LEN - bufferLen));
+		compressBlocks(state, buffer, 1);
+		bufferLen = 0;
 	}
-	uint8_t result[Sha256Hash::HASH_LEN];
-	for (size_t i = 0; i < sizeof(state) / sizeof(state[0]); i++)
-		Utils::storeBigUint32(state[i], &result[i * 4]);
-	return Sha256Hash(result, Sha256Hash::HASH_LEN);
+	std::memset(&buffer[bufferLen], 0, static_cast<size_t>(BLOCK_LEN - 8 - bufferLen));
+	Utils::storeBigUint32(static_cast<uint32_t>(bitLength >> 32), &buffer[BLOCK_LEN - 8]);
+	Utils::storeBigUint32(static_cast<uint32_t>(bitLength), &buffer[BLOCK_LEN - 4]);
+	compressBlocks(state, buffer, 1);
+	return stateToHash(state);
+}
+
+
+bool Sha256::getMidstate(uint32_t outMidstate[8], uint64_t &outLength) const {
+	assert(outMidstate != nullptr);
+	if (bufferLen != 0)
+		return false;
+	std::memcpy(outMidstate, state, sizeof(state));
+	outLength = length;
+	return true;
 }
 
 
@@ -68,51 +111,214 @@ Sha256Hash Sha256::getDoubleHash(const uint8_t msg[], size_t len) {
 }
 
 
+Sha256Hash Sha256::getHash32(const uint8_t msg[32]) {
+	assert(msg != nullptr);
+	uint32_t words[8];
+	for (int i = 0; i < 8; i++)
+		words[i] = Utils::loadBigUint32(&msg[i * 4]);
+	hashWords32(words);
+	return stateToHash(words);
+}
+
+
+Sha256Hash Sha256::getDoubleHash64(const uint8_t msg[64]) {
+	assert(msg != nullptr);
+	uint32_t state[8];
+	std::memcpy(state, INITIAL_STATE, sizeof(state));
+	compressBlocks(state, msg, 1);
+	compressPadding64(state);
+	hashWords32(state);
+	return stateToHash(state);
+}
+
+
 Sha256Hash Sha256::getHmac(const uint8_t key[], size_t keyLen, const uint8_t msg[], size_t msgLen) {
-	assert(key != nullptr || keyLen == 0);
+	return HmacSha256(key, keyLen).getHmac(msg, msgLen);
+}
+
+
+void Sha256::getHashes(const uint8_t *const msgs[], const size_t lens[], size_t n, Sha256Hash out[]) {
+	size_t lanes = 0;
+	CompressLanes compressLanes = getCompressLanes(lanes);
+	// With SHA-NI, the lanes only beat one hash at a time for messages that fit in one block
+	getHashes(msgs, lens, n, out, lanes, compressLanes, CpuFeatures::hasShaNi());
+}
+
+
+bool Sha256::getHashesInLanes(const uint8_t *const msgs[], const size_t lens[], size_t n, Sha256Hash out[], size_t lanes) {
+	CompressLanes compressLanes = nullptr;
+#if defined(BCL_X86)
+	if (lanes == 16 && CpuFeatures::hasAvx512())
+		compressLanes = compressAvx512;
+	else if (lanes == 8 && CpuFeatures::hasAvx2())
+		compressLanes = compressAvx2;
+#endif
+	if (compressLanes == nullptr)
+		return false;
+	getHashes(msgs, lens, n, out, lanes, compressLanes, false);
+	return true;
+}
+
+
+void Sha256::getHashes(const uint8_t *const msgs[], const size_t lens[], size_t n, Sha256Hash out[],
+		size_t lanes, CompressLanes compressLanes, bool oneBlockOnly) {
+	assert((msgs != nullptr && lens != nullptr && out != nullptr) || n == 0);
+	size_t i = 0;
+	for (size_t count; (count = MultiBuffer::getGroupLen(i, n, lanes)) > 0; i += count) {
+		bool useLanes = true;
+		for (size_t j = 0; j < count && oneBlockOnly; j++)
+			useLanes &= lens[i + j] < BLOCK_LEN - 8;  // Room for the 0x80 byte and the 64-bit length
+		if (useLanes)
+			getHashesLanes(&msgs[i], &lens[i], count, &out[i], lanes, compressLanes);
+		else {
+			for (size_t j = 0; j < count; j++)
+				out[i + j] = getHash(msgs[i + j], lens[i + j]);
+		}
+	}
+	for (; i < n; i++)
+		out[i] = getHash(msgs[i], lens[i]);
+}
+
+
+void Sha256::getDoubleHashes64(const uint8_t msgs[], size_t n, Sha256Hash out[]) {
+	assert((msgs != nullptr && out != nullptr) || n == 0);
+	// Each group reads all of its input before writing its output, which is at a lower or equal address
+	size_t lanes = 0;
+	CompressLanes compressLanes = getCompressLanes(lanes);
+	size_t i = 0;
+	for (size_t count; (count = MultiBuffer::getGroupLen(i, n, lanes)) > 0; i += count)
+		getDoubleHashes64Lanes(&msgs[i * 64], count, &out[i], lanes, compressLanes);
+	for (; i < n; i++)
+		out[i] = getDoubleHash64(&msgs[i * 64]);
+}
+
+
+Sha256::CompressLanes Sha256::getCompressLanes(size_t &outLanes) {
+#if defined(BCL_X86)
+	if (CpuFeatures::hasAvx512()) {
+		outLanes = 16;
+		return compressAvx512;
+	} else if (CpuFeatures::hasAvx2() && !CpuFeatures::hasShaNi()) {  // 8 lanes are slower than one SHA-NI hash at a time
+		outLanes = 8;
+		return compressAvx2;
+	}
+#endif
+	outLanes = 0;
+	return nullptr;
+}
+
+
+void Sha256::getHashesLanes(const uint8_t *const msgs[], const size_t lens[], size_t count, Sha256Hash out[],
+		size_t lanes, CompressLanes compressLanes) {
+	assert(count <= lanes && lanes <= MAX_LANES);
+	const MultiBuffer schedule(msgs, lens, count, BLOCK_LEN, MultiBuffer::Padding::MD_LENGTH_64, 0);
+	uint32_t states[8 * MAX_LANES];
+	for (int i = 0; i < 8; i++) {
+		for (size_t j = 0; j < lanes; j++)
+			states[i * lanes + j] = INITIAL_STATE[i];
+	}
+	uint32_t words[16 * MAX_LANES] = {};
+	schedule.absorb<8>(states, lanes,
+		[&](const uint8_t *block, size_t j) {
+			for (int i = 0; i < 16; i++)
+				words[i * lanes + j] = Utils::loadBigUint32(&block[i * 4]);
+		},
+		[&]() { compressLanes(states, words); });
+	
+	for (size_t j = 0; j < count; j++) {
+		uint32_t state[8];
+		for (int i = 0; i < 8; i++)
+			state[i] = states[i * lanes + j];
+		out[j] = stateToHash(state);
+	}
+}
+
+
+void Sha256::getDoubleHashes64Lanes(const uint8_t msgs[], size_t count, Sha256Hash out[],
+		size_t lanes, CompressLanes compressLanes) {
+	assert(count <= lanes && lanes <= MAX_LANES);
+	uint32_t states[8 * MAX_LANES];
+	uint32_t words[16 * MAX_LANES] = {};  // Unused lanes hash zeros
+	for (size_t j = 0; j < count; j++) {
+		for (int i = 0; i < 16; i++)
+			words[i * lanes + j] = Utils::loadBigUint32(&msgs[j * 64 + i * 4]);
+	}
+	for (int i = 0; i < 8; i++) {
+		for (size_t j = 0; j < lanes; j++)
+			states[i * lanes + j] = INITIAL_STATE[i];
+	}
+	compressLanes(states, words);
 	
-	// Preprocess key
-	uint8_t tempKey[BLOCK_LEN] = {};
-	if (keyLen <= BLOCK_LEN)
-		Utils::copyBytes(tempKey, key, keyLen);
-	else {
-		const Sha256Hash keyHash = getHash(key, keyLen);
-		std::memcpy(tempKey, keyHash.value, Sha256Hash::HASH_LEN);
+	// The padding block of a 64-byte message
+	for (int i = 0; i < 16; i++) {
+		uint32_t word = i == 0 ? UINT32_C(0x80000000) : (i == 15 ? 512 : 0);
+		for (size_t j = 0; j < lanes; j++)
+			words[i * lanes + j] = word;
 	}
+	compressLanes(states, words);
 	
-	// Compute inner hash
-	for (int i = 0; i < BLOCK_LEN; i++)
-		tempKey[i] ^= 0x36;
-	const Sha256Hash innerHash = Sha256()
-		.append(tempKey, BLOCK_LEN)
-		.append(msg, msgLen)
-		.getHash();
+	// The 32-byte first hash and its padding
+	for (int i = 0; i < 16; i++) {
+		for (size_t j = 0; j < lanes; j++) {
+			if (i < 8)
+				words[i * lanes + j] = states[i * lanes + j];
+			else
+				words[i * lanes + j] = i == 8 ? UINT32_C(0x80000000) : (i == 15 ? 256 : 0);
+		}
+	}
+	for (int i = 0; i < 8; i++) {
+		for (size_t j = 0; j < lanes; j++)
+			states[i * lanes + j] = INITIAL_STATE[i];
+	}
+	compressLanes(states, words);
 	
-	// Compute outer hash
-	for (int i = 0; i < BLOCK_LEN; i++)
-		tempKey[i] ^= 0x36 ^ 0x5C;
-	return Sha256()
-		.append(tempKey, BLOCK_LEN)
-		.append(innerHash.value, Sha256Hash::HASH_LEN)
-		.getHash();
+	for (size_t j = 0; j < count; j++) {
+		uint32_t state[8];
+		for (int i = 0; i < 8; i++)
+			state[i] = states[i * lanes + j];
+		out[j] = stateToHash(state);
+	}
 }
 
 
 void Sha256::compress(uint32_t state[8], const uint8_t block[BLOCK_LEN]) {
+	compressBlocks(state, block, 1);
+}
+
+
+void Sha256::compressBlocks(uint32_t state[8], const uint8_t blocks[], size_t numBlocks) {
+	assert(state != nullptr && blocks != nullptr);
+#if defined(BCL_X86)
+	if (CpuFeatures::hasShaNi()) {
+		compressShaNi(state, blocks, numBlocks);
+		return;
+	}
+#endif
+	for (size_t i = 0; i < numBlocks; i++)
+		compressPortable(state, &blocks[i * BLOCK_LEN]);
+}
+
+
+void Sha256::compressPortable(uint32_t state[8], const uint8_t block[BLOCK_LEN]) {
 	assert(state != nullptr && block != nullptr);
-	
-	// Message schedule
-	uint32_t schedule[NUM_ROUNDS] = {};
-	for (int i = 0; i < 64; i++)
-		schedule[i >> 2] |= static_cast<uint32_t>(block[i]) << ((3 - (i & 3)) << 3);
-	
+	uint32_t schedule[NUM_ROUNDS];
+	for (int i = 0; i < 16; i++)
+		schedule[i] = Utils::loadBigUint32(&block[i * 4]);
+	expandSchedule(schedule);
+	compressRounds(state, schedule);
+}
+
+
+void Sha256::expandSchedule(uint32_t schedule[]) {
 	for (int i = 16; i < NUM_ROUNDS; i++) {
 		schedule[i] = 0U + schedule[i - 16] + schedule[i - 7]
 			+ (rotr32(schedule[i - 15],  7) ^ rotr32(schedule[i - 15], 18) ^ (schedule[i - 15] >>  3))
 			+ (rotr32(schedule[i -  2], 17) ^ rotr32(schedule[i -  2], 19) ^ (schedule[i -  2] >> 10));
 	}
-	
-	// The 64 rounds
+}
+
+
+void Sha256::compressRounds(uint32_t state[8], const uint32_t schedule[]) {
 	uint32_t a = state[0];
 	uint32_t b = state[1];
 	uint32_t c = state[2];
@@ -144,11 +350,229 @@ void Sha256::compress(uint32_t state[8], const uint8_t block[BLOCK_LEN]) {
 }
 
 
+void Sha256::compressPadding64(uint32_t state[8]) {
+#if defined(BCL_X86)
+	if (CpuFeatures::hasShaNi()) {
+		uint8_t block[BLOCK_LEN] = {0x80};
+		block[BLOCK_LEN - 2] = 0x02;  // 512 bits
+		compressShaNi(state, block, 1);
+		return;
+	}
+#endif
+	compressRounds(state, getPadding64Schedule());
+}
+
+
+void Sha256::hashWords32(uint32_t words[8]) {
+	uint32_t state[8];
+	std::memcpy(state, INITIAL_STATE, sizeof(state));
+#if defined(BCL_X86)
+	if (CpuFeatures::hasShaNi()) {
+		uint8_t block[BLOCK_LEN] = {};
+		for (int i = 0; i < 8; i++)
+			Utils::storeBigUint32(words[i], &block[i * 4]);
+		block[32] = 0x80;
+		block[BLOCK_LEN - 2] = 0x01;  // 256 bits
+		compressShaNi(state, block, 1);
+		std::memcpy(words, state, sizeof(state));
+		return;
+	}
+#endif
+	uint32_t schedule[NUM_ROUNDS] = {};
+	std::memcpy(schedule, words, 8 * sizeof(words[0]));
+	schedule[8] = UINT32_C(0x80000000);
+	schedule[15] = 256;
+	expandSchedule(schedule);
+	compressRounds(state, schedule);
+	std::memcpy(words, state, sizeof(state));
+}
+
+
+Sha256Hash Sha256::stateToHash(const uint32_t state[8]) {
+	uint8_t result[Sha256Hash::HASH_LEN];
+	for (int i = 0; i < 8; i++)
+		Utils::storeBigUint32(state[i], &result[i * 4]);
+	return Sha256Hash(result, Sha256Hash::HASH_LEN);
+}
+
+
+const uint32_t *Sha256::getPadding64Schedule() {
+	struct Schedule final {
+		uint32_t words[NUM_ROUNDS];
+	};
+	static const Schedule result = []() {
+		Schedule sch = {};
+		sch.words[0] = UINT32_C(0x80000000);
+		sch.words[15] = 512;
+		expandSchedule(sch.words);
+		return sch;
+	}();
+	return result.words;
+}
+
+
+#if defined(BCL_X86)
+BCL_TARGET("sha,sse4.1")
+void Sha256::compressShaNi(uint32_t state[8], const uint8_t blocks[], size_t numBlocks) {
+	// Each SHA256RNDS2 instruction does 2 rounds, with the state split into the registers {A,B,E,F} and {C,D,G,H}
+	const __m128i byteSwap = _mm_set_epi64x(INT64_C(0x0C0D0E0F08090A0B), INT64_C(0x0405060700010203));
+	__m128i temp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&state[0])), 0xB1);  // CDAB
+	__m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&state[4])), 0x1B);  // EFGH
+	__m128i state0 = _mm_alignr_epi8(temp, state1, 8);  // ABEF
+	state1 = _mm_blend_epi16(state1, temp, 0xF0);  // CDGH
+	
+	for (size_t i = 0; i < numBlocks; i++, blocks += BLOCK_LEN) {
+		const __m128i saved0 = state0;
+		const __m128i saved1 = state1;
+		__m128i msgs[4];
+		for (int j = 0; j < 4; j++)
+			msgs[j] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&blocks[j * 16])), byteSwap);
+		
+		// 16 groups of 4 rounds, computing the message schedule 3 groups ahead
+		for (int j = 0; j < NUM_ROUNDS / 4; j++) {
+			__m128i &msg = msgs[j & 3];
+			__m128i msg2 = _mm_add_epi32(msg, _mm_loadu_si128(reinterpret_cast<const __m128i *>(&ROUND_CONSTANTS[j * 4])));
+			state1 = _mm_sha256rnds2_epu32(state1, state0, msg2);
+			if (3 <= j && j <= 14) {
+				__m128i &next = msgs[(j + 1) & 3];
+				next = _mm_add_epi32(next, _mm_alignr_epi8(msg, msgs[(j + 3) & 3], 4));
+				next = _mm_sha256msg2_epu32(next, msg);
+			}
+			msg2 = _mm_shuffle_epi32(msg2, 0x0E);
+			state0 = _mm_sha256rnds2_epu32(state0, state1, msg2);
+			if (1 <= j && j <= 12)
+				msgs[(j + 3) & 3] = _mm_sha256msg1_epu32(msgs[(j + 3) & 3], msg);
+		}
+		state0 = _mm_add_epi32(state0, saved0);
+		state1 = _mm_add_epi32(state1, saved1);
+	}
+	
+	temp = _mm_shuffle_epi32(state0, 0x1B);  // FEBA
+	state1 = _mm_shuffle_epi32(state1, 0xB1);  // DCHG
+	state0 = _mm_blend_epi16(temp, state1, 0xF0);  // DCBA
+	state1 = _mm_alignr_epi8(state1, temp, 8);  // HGFE
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(&state[0]), state0);
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(&state[4]), state1);
+}
+#endif
+
+
+#if defined(BCL_X86)
+
+// Rotates each 32-bit lane of x right by the constant n, for 1 <= n <= 31
+#define BCL_ROTR256(x, n)  _mm256_or_si256(_mm256_srli_epi32((x), (n)), _mm256_slli_epi32((x), 32 - (n)))
+
+BCL_TARGET("avx2")
+void Sha256::compressAvx2(uint32_t states[8 * 8], const uint32_t words[16 * 8]) {
+	// The same rounds as compressPortable(), with a rolling 16-word schedule
+	__m256i schedule[16];
+	for (int i = 0; i < 16; i++)
+		schedule[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&words[i * 8]));
+	__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&states[0 * 8]));
+	__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&states[1 * 8]));
+	__m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&states[2 * 8]));
+	__m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&states[3 * 8]));
+	__m256i e = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&states[4 * 8]));
+	__m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&states[5 * 8]));
+	__m256i g = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&states[6 * 8]));
+	__m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&states[7 * 8]));
+	for (int i = 0; i < NUM_ROUNDS; i++) {
+		__m256i &w = schedule[i & 15];
+		if (i >= 16) {
+			const __m256i w15 = schedule[(i + 1) & 15];
+			const __m256i w2 = schedule[(i + 14) & 15];
+			__m256i s0 = _mm256_xor_si256(_mm256_xor_si256(BCL_ROTR256(w15, 7), BCL_ROTR256(w15, 18)), _mm256_srli_epi32(w15, 3));
+			__m256i s1 = _mm256_xor_si256(_mm256_xor_si256(BCL_ROTR256(w2, 17), BCL_ROTR256(w2, 19)), _mm256_srli_epi32(w2, 10));
+			w = _mm256_add_epi32(_mm256_add_epi32(w, s0), _mm256_add_epi32(schedule[(i + 9) & 15], s1));
+		}
+		__m256i s1 = _mm256_xor_si256(_mm256_xor_si256(BCL_ROTR256(e, 6), BCL_ROTR256(e, 11)), BCL_ROTR256(e, 25));
+		__m256i ch = _mm256_xor_si256(g, _mm256_and_si256(e, _mm256_xor_si256(f, g)));
+		__m256i t1 = _mm256_add_epi32(_mm256_add_epi32(_mm256_add_epi32(h, s1), _mm256_add_epi32(ch, w)),
+			_mm256_set1_epi32(static_cast<int>(ROUND_CONSTANTS[i])));
+		__m256i s0 = _mm256_xor_si256(_mm256_xor_si256(BCL_ROTR256(a, 2), BCL_ROTR256(a, 13)), BCL_ROTR256(a, 22));
+		__m256i maj = _mm256_or_si256(_mm256_and_si256(a, _mm256_or_si256(b, c)), _mm256_and_si256(b, c));
+		__m256i t2 = _mm256_add_epi32(s0, maj);
+		h = g;
+		g = f;
+		f = e;
+		e = _mm256_add_epi32(d, t1);
+		d = c;
+		c = b;
+		b = a;
+		a = _mm256_add_epi32(t1, t2);
+	}
+	const __m256i vars[8] = {a, b, c, d, e, f, g, h};
+	for (int i = 0; i < 8; i++) {
+		__m256i *p = reinterpret_cast<__m256i *>(&states[i * 8]);
+		_mm256_storeu_si256(p, _mm256_add_epi32(_mm256_loadu_si256(p), vars[i]));
+	}
+}
+
+#undef BCL_ROTR256
+
+
+BCL_AVX512_WARNINGS_BEGIN
+
+BCL_TARGET("avx512f")
+void Sha256::compressAvx512(uint32_t states[8 * 16], const uint32_t words[16 * 16]) {
+	// Like compressAvx2(), but with native rotations and ternary logic (0x96 = x ^ y ^ z, 0xCA = x ? y : z, 0xE8 = majority)
+	__m512i schedule[16];
+	for (int i = 0; i < 16; i++)
+		schedule[i] = _mm512_loadu_si512(&words[i * 16]);
+	__m512i a = _mm512_loadu_si512(&states[0 * 16]);
+	__m512i b = _mm512_loadu_si512(&states[1 * 16]);
+	__m512i c = _mm512_loadu_si512(&states[2 * 16]);
+	__m512i d = _mm512_loadu_si512(&states[3 * 16]);
+	__m512i e = _mm512_loadu_si512(&states[4 * 16]);
+	__m512i f = _mm512_loadu_si512(&states[5 * 16]);
+	__m512i g = _mm512_loadu_si512(&states[6 * 16]);
+	__m512i h = _mm512_loadu_si512(&states[7 * 16]);
+	for (int i = 0; i < NUM_ROUNDS; i++) {
+		__m512i &w = schedule[i & 15];
+		if (i >= 16) {
+			const __m512i w15 = schedule[(i + 1) & 15];
+			const __m512i w2 = schedule[(i + 14) & 15];
+			__m512i s0 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(w15, 7), _mm512_ror_epi32(w15, 18), _mm512_srli_epi32(w15, 3), 0x96);
+			__m512i s1 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(w2, 17), _mm512_ror_epi32(w2, 19), _mm512_srli_epi32(w2, 10), 0x96);
+			w = _mm512_add_epi32(_mm512_add_epi32(w, s0), _mm512_add_epi32(schedule[(i + 9) & 15], s1));
+		}
+		__m512i s1 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(e, 6), _mm512_ror_epi32(e, 11), _mm512_ror_epi32(e, 25), 0x96);
+		__m512i ch = _mm512_ternarylogic_epi32(e, f, g, 0xCA);
+		__m512i t1 = _mm512_add_epi32(_mm512_add_epi32(_mm512_add_epi32(h, s1), _mm512_add_epi32(ch, w)),
+			_mm512_set1_epi32(static_cast<int>(ROUND_CONSTANTS[i])));
+		__m512i s0 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(a, 2), _mm512_ror_epi32(a, 13), _mm512_ror_epi32(a, 22), 0x96);
+		__m512i maj = _mm512_ternarylogic_epi32(a, b, c, 0xE8);
+		__m512i t2 = _mm512_add_epi32(s0, maj);
+		h = g;
+		g = f;
+		f = e;
+		e = _mm512_add_epi32(d, t1);
+		d = c;
+		c = b;
+		b = a;
+		a = _mm512_add_epi32(t1, t2);
+	}
+	const __m512i vars[8] = {a, b, c, d, e, f, g, h};
+	for (int i = 0; i < 8; i++)
+		_mm512_storeu_si512(&states[i * 16], _mm512_add_epi32(_mm512_loadu_si512(&states[i * 16]), vars[i]));
+}
+
+BCL_AVX512_WARNINGS_END
+
+#endif
+
+
 uint32_t Sha256::rotr32(uint32_t x, int i) {
 	return ((0U + x) << (32 - i)) | (x >> i);
 }
 
 
+const uint32_t Sha256::INITIAL_STATE[8] = {
+	UINT32_C(0x6A09E667), UINT32_C(0xBB67AE85), UINT32_C(0x3C6EF372), UINT32_C(0xA54FF53A),
+	UINT32_C(0x510E527F), UINT32_C(0x9B05688C), UINT32_C(0x1F83D9AB), UINT32_C(0x5BE0CD19),
+};
+
+
 const uint32_t Sha256::ROUND_CONSTANTS[NUM_ROUNDS] = {
 	UINT32_C(0x428A2F98), UINT32_C(0x71374491), UINT32_C(0xB5C0FBCF), UINT32_C(0xE9B5DBA5),
 	UINT32_C(0x3956C25B), UINT32_C(0x59F111F1), UINT32_C(0x923F82A4), UINT32_C(0xAB1C5ED5),
@@ -10,6 +10,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include "CpuFeatures.hpp"
 #include "Sha256Hash.hpp"
 
 namespace bcl {
@@ -17,7 +18,8 @@ namespace bcl {
 
 /* 
  * Computes the SHA-256 hash of a sequence of bytes, returning a Sha256Hash object.
- * Provides three static methods, and an instantiable stateful hasher.
+ * Provides three static methods, and an instantiable stateful hasher. A hasher can be checkpointed
+ * by copying it, or exported and restored as a midstate after a whole number of blocks.
  */
 class Sha256 final {
 	
@@ -29,10 +31,7 @@ class Sha256 final {
 	
 	/*---- Instance members ----*/
 	
-	private: std::uint32_t state[8] = {
-		UINT32_C(0x6A09E667), UINT32_C(0xBB67AE85), UINT32_C(0x3C6EF372), UINT32_C(0xA54FF53A),
-		UINT32_C(0x510E527F), UINT32_C(0x9B05688C), UINT32_C(0x1F83D9AB), UINT32_C(0x5BE0CD19),
-	};
+	private: std::uint32_t state[8];
 	private: std::uint64_t length;
 	private: std::uint8_t buffer[BLOCK_LEN];
 	private: int bufferLen;
@@ -42,6 +41,11 @@ class Sha256 final {
 	public: explicit Sha256();
 	
 	
+	// Constructs a hasher that continues from the given midstate, which is the state after hashing
+	// a prefix of the given length in bytes. The length must be a multiple of BLOCK_LEN.
+	public: explicit Sha256(const std::uint32_t midstate[8], std::uint64_t length);
+	
+	
 	// Appends message bytes to this ongoing hasher, and returns this object itself.
 	public: Sha256 &append(const std::uint8_t bytes[], std::size_t len);
 	
@@ -50,6 +54,12 @@ class Sha256 final {
 	public: Sha256Hash getHash();
 	
 	
+	// If the number of bytes appended so far is a multiple of BLOCK_LEN (i.e. nothing is buffered), then this
+	// sets outMidstate to the state words and outLength to that number, and returns true. Otherwise this
+	// returns false and leaves the outputs unchanged.
+	public: bool getMidstate(std::uint32_t outMidstate[8], std::uint64_t &outLength) const;
+	
+	
 	
 	/*---- Static functions ----*/
 	
@@ -59,12 +69,118 @@ class Sha256 final {
 	public: static Sha256Hash getDoubleHash(const std::uint8_t msg[], std::size_t len);
 	
 	
+	// Returns getHash(msg, 32), for example the second hash of a double hash. Skips the buffering and
+	// the padding logic of the general case, since the second half of the only block is constant.
+	public: static Sha256Hash getHash32(const std::uint8_t msg[32]);
+	
+	
+	// Returns getDoubleHash(msg, 64), e.g. for a Merkle tree node. The padding block of the first hash is constant,
+	// so its message schedule is precomputed (for the portable code), and the second hash is done by getHash32().
+	public: static Sha256Hash getDoubleHash64(const std::uint8_t msg[64]);
+	
+	
 	public: static Sha256Hash getHmac(const std::uint8_t key[], std::size_t keyLen, const std::uint8_t msg[], std::size_t msgLen);
 	
 	
+	// Sets out[i] = getHash(msgs[i], lens[i]) for 0 <= i < n. When the CPU has AVX-512, or AVX2 but not SHA-NI
+	// (see CpuFeatures), groups of 16 or 8 messages are hashed in parallel in the SIMD lanes, for many short messages
+	// of similar lengths (e.g. public keys). With SHA-NI, only groups of messages under 56 bytes (one padded block)
+	// use the lanes, since longer ones are no faster than one at a time. Not constant-time with respect to the lengths.
+	public: static void getHashes(const std::uint8_t *const msgs[], const std::size_t lens[], std::size_t n, Sha256Hash out[]);
+	
+	
+	// Same as getHashes(), but always with the SIMD kernel of the given number of lanes (16 for AVX-512, 8 for AVX2),
+	// even where getHashes() would choose another one. Returns false and leaves the output unchanged if the CPU lacks
+	// that kernel. For testing and benchmarking each kernel on a CPU that has several.
+	public: static bool getHashesInLanes(const std::uint8_t *const msgs[], const std::size_t lens[], std::size_t n, Sha256Hash out[], std::size_t lanes);
+	
+	
+	// Sets out[i] = getDoubleHash64(&msgs[i * 64]) for 0 <= i < n, hashing groups of messages in SIMD lanes like getHashes().
+	// The output may overlap the input at the same or a lower address (e.g. out == msgs for a Merkle tree level in place).
+	public: static void getDoubleHashes64(const std::uint8_t msgs[], std::size_t n, Sha256Hash out[]);
+	
+	
+	// Compresses the given block into the given state, with SHA-NI instructions if the CPU has them
+	// (see CpuFeatures::hasShaNi()) and otherwise with compressPortable().
 	public: static void compress(std::uint32_t state[8], const std::uint8_t block[BLOCK_LEN]);
 	
 	
+	// Compresses the given number of consecutive blocks into the given state, like calling compress() on each one.
+	private: static void compressBlocks(std::uint32_t state[8], const std::uint8_t blocks[], std::size_t numBlocks);
+	
+	
+	// The portable implementation of compress(), which builds the full message schedule in an array.
+	public: static void compressPortable(std::uint32_t state[8], const std::uint8_t block[BLOCK_LEN]);
+	
+	
+	// Computes schedule[i] for 16 <= i < NUM_ROUNDS from the first 16 words, which are the message block.
+	private: static void expandSchedule(std::uint32_t schedule[]);
+	
+	
+	// Runs the 64 rounds on the given state with the given full message schedule, and adds the result to the state.
+	private: static void compressRounds(std::uint32_t state[8], const std::uint32_t schedule[]);
+	
+	
+	// Compresses the padding block of a 64-byte message into the given state.
+	private: static void compressPadding64(std::uint32_t state[8]);
+	
+	
+	// Replaces the given words, taken as a 32-byte big-endian message, with the state after hashing the message.
+	private: static void hashWords32(std::uint32_t words[8]);
+	
+	
+	// Returns the hash value of the given final state.
+	private: static Sha256Hash stateToHash(const std::uint32_t state[8]);
+	
+	
+	// Returns the message schedule of the padding block of a 64-byte message, computed once.
+	private: static const std::uint32_t *getPadding64Schedule();
+	
+	
+#if defined(BCL_X86)
+	// Compresses the given consecutive blocks into the given state using SHA-NI. The CPU must support it.
+	private: static void compressShaNi(std::uint32_t state[8], const std::uint8_t blocks[], std::size_t numBlocks);
+#endif
+	
+	
+	// The signature of compressAvx2() and compressAvx512().
+	private: typedef void (*CompressLanes)(std::uint32_t states[], const std::uint32_t words[]);
+	
+	
+	// Returns the fastest multi-lane compression function and sets outLanes to its number of lanes,
+	// or returns null if one message at a time is faster on this CPU.
+	private: static CompressLanes getCompressLanes(std::size_t &outLanes);
+	
+	
+	// Sets out[i] = getHash(msgs[i], lens[i]) for 0 <= i < n, in groups with the given function of the given
+	// number of lanes, and one at a time for the remainder. The function may be null if lanes is 0. If oneBlockOnly
+	// is true, a group that has a message longer than one padded block is also hashed one message at a time.
+	private: static void getHashes(const std::uint8_t *const msgs[], const std::size_t lens[], std::size_t n, Sha256Hash out[],
+		std::size_t lanes, CompressLanes compressLanes, bool oneBlockOnly);
+	
+	
+	// Hashes the given count <= lanes messages at once with the given function, which compresses one block
+	// for each of the given number of lanes. The blocks are scheduled by MultiBuffer.
+	private: static void getHashesLanes(const std::uint8_t *const msgs[], const std::size_t lens[], std::size_t count, Sha256Hash out[],
+		std::size_t lanes, CompressLanes compressLanes);
+	
+	
+	// Double-hashes the given count <= lanes 64-byte messages at once with the given function.
+	private: static void getDoubleHashes64Lanes(const std::uint8_t msgs[], std::size_t count, Sha256Hash out[],
+		std::size_t lanes, CompressLanes compressLanes);
+	
+	
+#if defined(BCL_X86)
+	// Compresses one block into each of 8 states. Word i of lane j's state is at states[i * 8 + j],
+	// and word i of lane j's block (decoded as big endian) is at words[i * 8 + j]. The CPU must support AVX2.
+	private: static void compressAvx2(std::uint32_t states[8 * 8], const std::uint32_t words[16 * 8]);
+	
+	
+	// Compresses one block into each of 16 states, like compressAvx2(). The CPU must support AVX-512F.
+	private: static void compressAvx512(std::uint32_t states[8 * 16], const std::uint32_t words[16 * 16]);
+#endif
+	
+	
 	// Requires 1 <= i <= 31
 	private: static std::uint32_t rotr32(std::uint32_t x, int i);
 	
@@ -73,6 +189,8 @@ class Sha256 final {
 	/*---- Private constants ----*/
 	
 	private: static constexpr int NUM_ROUNDS = 64;
+	private: static constexpr std::size_t MAX_LANES = 16;
+	private: static const std::uint32_t INITIAL_STATE[8];
 	private: static const std::uint32_t ROUND_CONSTANTS[NUM_ROUNDS];
 	
 };
@@ -7,12 +7,20 @@
  */
 
 #include <cassert>
+#include <cstring>
+#include "HmacSha512.hpp"
+#include "MultiBuffer.hpp"
 #include "Sha512.hpp"
 #include "Utils.hpp"
 
+#if defined(BCL_X86)
+	#include <immintrin.h>
+#endif
+
 namespace bcl {
 
 using std::uint8_t;
+using std::uint32_t;
 using std::uint64_t;
 using std::size_t;
 
@@ -22,117 +30,317 @@ Sha512::Sha512() :
 	bufferLen(0) {}
 
 
+Sha512::Sha512(const uint64_t midstate[8], uint64_t len) :
+		length(len),
+		bufferLen(0) {
+	assert(midstate != nullptr && len % BLOCK_LEN == 0);
+	std::memcpy(state, midstate, sizeof(state));
+}
+
+
 Sha512 &Sha512::append(const uint8_t bytes[], size_t len) {
 	assert(bytes != nullptr || len == 0);
-	for (size_t i = 0; i < len; i++) {
-		buffer[bufferLen] = bytes[i];
-		bufferLen++;
-		if (bufferLen == BLOCK_LEN) {
-			compress();
-			bufferLen = 0;
-		}
-	}
 	length += len;
+	
+	// Top up a partially filled buffer
+	if (bufferLen > 0) {
+		size_t n = static_cast<size_t>(BLOCK_LEN - bufferLen);
+		if (n > len)
+			n = len;
+		Utils::copyBytes(&buffer[bufferLen], bytes, n);
+		bufferLen += static_cast<int>(n);
+		bytes += n;
+		len -= n;
+		if (bufferLen < BLOCK_LEN)
+			return *this;
+		compress(state, buffer, 1);
+		bufferLen = 0;
+	}
+	
+	// Compress whole blocks straight from the input, and keep the rest
+	size_t numBlocks = len / BLOCK_LEN;
+	if (numBlocks > 0) {
+		compress(state, bytes, numBlocks);
+		bytes += numBlocks * BLOCK_LEN;
+		len -= numBlocks * BLOCK_LEN;
+	}
+	Utils::copyBytes(buffer, bytes, len);
+	bufferLen = static_cast<int>(len);
 	return *this;
 }
 
 
 void Sha512::getHash(uint8_t result[HASH_LEN]) {
 	assert(result != nullptr);
-	uint64_t bitLength = length << 3;
-	uint8_t temp = 0x80;
-	append(&temp, 1);
-	temp = 0x00;
-	while (bufferLen != 112)
-		append(&temp, 1);
-	for (int i = 0; i < 8; i++)
-		append(&temp, 1);
-	for (int i = 0; i < 8; i++) {
-		temp = static_cast<uint8_t>(bitLength >> ((7 - i) << 3));
-		append(&temp, 1);
+	
+	// Pad with the 0x80 byte, zeros, and the 128-bit length in bits, in one or two blocks
+	buffer[bufferLen] = 0x80;
+	bufferLen++;
+	if (bufferLen > BLOCK_LEN - 16) {
+		std::memset(&buffer[bufferLen], 0, static_cast<size_t>(BLOCK_LEN - bufferLen));
+		compress(state, buffer, 1);
+		bufferLen = 0;
 	}
+	std::memset(&buffer[bufferLen], 0, static_cast<size_t>(BLOCK_LEN - 12 - bufferLen));
+	Utils::storeBigUint32(static_cast<uint32_t>(length >> 61), &buffer[BLOCK_LEN - 12]);
+	Utils::storeBigUint32(static_cast<uint32_t>(length >> 29), &buffer[BLOCK_LEN - 8]);
+	Utils::storeBigUint32(static_cast<uint32_t>(length << 3), &buffer[BLOCK_LEN - 4]);
+	compress(state, buffer, 1);
+	
 	for (int i = 0; i < HASH_LEN; i++)
 		result[i] = static_cast<uint8_t>(state[i >> 3] >> ((7 - (i & 7)) << 3));
 }
 
 
-void Sha512::compress() {
-	// Message schedule
-	uint64_t schedule[NUM_ROUNDS] = {};
-	for (int i = 0; i < 128; i++)
-		schedule[i >> 3] |= static_cast<uint64_t>(buffer[i]) << ((7 - (i & 7)) << 3);
-	
-	for (int i = 16; i < NUM_ROUNDS; i++) {
-		schedule[i] = 0U + schedule[i - 16] + schedule[i - 7]
-			+ (rotr64(schedule[i - 15],  1) ^ rotr64(schedule[i - 15],  8) ^ (schedule[i - 15] >> 7))
-			+ (rotr64(schedule[i -  2], 19) ^ rotr64(schedule[i -  2], 61) ^ (schedule[i -  2] >> 6));
+bool Sha512::getMidstate(uint64_t outMidstate[8], uint64_t &outLength) const {
+	assert(outMidstate != nullptr);
+	if (bufferLen != 0)
+		return false;
+	std::memcpy(outMidstate, state, sizeof(state));
+	outLength = length;
+	return true;
+}
+
+
+void Sha512::compress(uint64_t state[8], const uint8_t blocks[], size_t numBlocks) {
+	assert(state != nullptr && blocks != nullptr);
+	for (size_t k = 0; k < numBlocks; k++, blocks += BLOCK_LEN) {
+		// Message schedule
+		uint64_t schedule[NUM_ROUNDS] = {};
+		for (int i = 0; i < 128; i++)
+			schedule[i >> 3] |= static_cast<uint64_t>(blocks[i]) << ((7 - (i & 7)) << 3);
+		
+		for (int i = 16; i < NUM_ROUNDS; i++) {
+			schedule[i] = 0U + schedule[i - 16] + schedule[i - 7]
+				+ (rotr64(schedule[i - 15],  1) ^ rotr64(schedule[i - 15],  8) ^ (schedule[i - 15] >> 7))
+				+ (rotr64(schedule[i -  2], 19) ^ rotr64(schedule[i -  2], 61) ^ (schedule[i -  2] >> 6));
+		}
+		
+		// The 80 rounds
+		uint64_t a = state[0];
+		uint64_t b = state[1];
+		uint64_t c = state[2];
+		uint64_t d = state[3];
+		uint64_t e = state[4];
+		uint64_t f = state[5];
+		uint64_t g = state[6];
+		uint64_t h = state[7];
+		for (int i = 0; i < NUM_ROUNDS; i++) {
+			uint64_t t1 = 0U + h + (rotr64(e, 14) ^ rotr64(e, 18) ^ rotr64(e, 41)) + (g ^ (e & (f ^ g))) + ROUND_CONSTANTS[i] + schedule[i];
+			uint64_t t2 = 0U + (rotr64(a, 28) ^ rotr64(a, 34) ^ rotr64(a, 39)) + ((a & (b | c)) | (b & c));
+			h = g;
+			g = f;
+			f = e;
+			e = 0U + d + t1;
+			d = c;
+			c = b;
+			b = a;
+			a = 0U + t1 + t2;
+		}
+		state[0] = 0U + state[0] + a;
+		state[1] = 0U + state[1] + b;
+		state[2] = 0U + state[2] + c;
+		state[3] = 0U + state[3] + d;
+		state[4] = 0U + state[4] + e;
+		state[5] = 0U + state[5] + f;
+		state[6] = 0U + state[6] + g;
+		state[7] = 0U + state[7] + h;
+	}
+}
+
+
+void Sha512::getHash(const uint8_t msg[], size_t len, uint8_t hashResult[HASH_LEN]) {
+	Sha512().append(msg, len).getHash(hashResult);
+}
+
+
+void Sha512::getHmac(const uint8_t key[], size_t keyLen, const uint8_t msg[], size_t msgLen, uint8_t result[HASH_LEN]) {
+	HmacSha512(key, keyLen).getHmac(msg, msgLen, result);
+}
+
+
+void Sha512::getHashesFromMidstates(const uint64_t *const midstates[], uint64_t prefixLen,
+		const uint8_t *const msgs[], const size_t lens[], size_t n, uint8_t out[][HASH_LEN]) {
+	size_t lanes = 0;
+	CompressLanes compressLanes = getCompressLanes(lanes);
+	getHashesFromMidstates(midstates, prefixLen, msgs, lens, n, out, lanes, compressLanes);
+}
+
+
+bool Sha512::getHashesFromMidstatesInLanes(const uint64_t *const midstates[], uint64_t prefixLen,
+		const uint8_t *const msgs[], const size_t lens[], size_t n, uint8_t out[][HASH_LEN], size_t lanes) {
+	CompressLanes compressLanes = nullptr;
+#if defined(BCL_X86)
+	if (lanes == 8 && CpuFeatures::hasAvx512())
+		compressLanes = compressAvx512;
+	else if (lanes == 4 && CpuFeatures::hasAvx2())
+		compressLanes = compressAvx2;
+#endif
+	if (compressLanes == nullptr)
+		return false;
+	getHashesFromMidstates(midstates, prefixLen, msgs, lens, n, out, lanes, compressLanes);
+	return true;
+}
+
+
+void Sha512::getHashesFromMidstates(const uint64_t *const midstates[], uint64_t prefixLen,
+		const uint8_t *const msgs[], const size_t lens[], size_t n, uint8_t out[][HASH_LEN],
+		size_t lanes, CompressLanes compressLanes) {
+	assert((midstates != nullptr && msgs != nullptr && lens != nullptr && out != nullptr) || n == 0);
+	size_t i = 0;
+	for (size_t count; (count = MultiBuffer::getGroupLen(i, n, lanes)) > 0; i += count)
+		getHashesLanes(&midstates[i], prefixLen, &msgs[i], &lens[i], count, &out[i], lanes, compressLanes);
+	for (; i < n; i++)
+		Sha512(midstates[i], prefixLen).append(msgs[i], lens[i]).getHash(out[i]);
+}
+
+
+Sha512::CompressLanes Sha512::getCompressLanes(size_t &outLanes) {
+#if defined(BCL_X86)
+	if (CpuFeatures::hasAvx512()) {
+		outLanes = 8;
+		return compressAvx512;
+	} else if (CpuFeatures::hasAvx2()) {
+		outLanes = 4;
+		return compressAvx2;
 	}
+#endif
+	outLanes = 0;
+	return nullptr;
+}
+
+
+void Sha512::getHashesLanes(const uint64_t *const midstates[], uint64_t prefixLen,
+		const uint8_t *const msgs[], const size_t lens[], size_t count, uint8_t out[][HASH_LEN],
+		size_t lanes, CompressLanes compressLanes) {
+	assert(count <= lanes && lanes <= MAX_LANES);
+	const MultiBuffer schedule(msgs, lens, count, BLOCK_LEN, MultiBuffer::Padding::MD_LENGTH_128, prefixLen);
+	uint64_t states[8 * MAX_LANES] = {};
+	for (size_t j = 0; j < count; j++) {
+		assert(midstates[j] != nullptr);
+		for (int i = 0; i < 8; i++)
+			states[i * lanes + j] = midstates[j][i];
+	}
+	uint64_t words[16 * MAX_LANES] = {};
+	schedule.absorb<8>(states, lanes,
+		[&](const uint8_t *block, size_t j) {
+			for (int i = 0; i < 16; i++)
+				words[i * lanes + j] = static_cast<uint64_t>(Utils::loadBigUint32(&block[i * 8])) << 32 | Utils::loadBigUint32(&block[i * 8 + 4]);
+		},
+		[&]() { compressLanes(states, words); });
 	
-	// The 80 rounds
-	uint64_t a = state[0];
-	uint64_t b = state[1];
-	uint64_t c = state[2];
-	uint64_t d = state[3];
-	uint64_t e = state[4];
-	uint64_t f = state[5];
-	uint64_t g = state[6];
-	uint64_t h = state[7];
+	// All the input has been read, so the output may overwrite it
+	for (size_t j = 0; j < count; j++) {
+		for (int i = 0; i < HASH_LEN; i++)
+			out[j][i] = static_cast<uint8_t>(states[(i >> 3) * lanes + j] >> ((7 - (i & 7)) << 3));
+	}
+}
+
+
+#if defined(BCL_X86)
+
+// Rotates each 64-bit lane of x right by the constant n, for 1 <= n <= 63
+#define BCL_ROTR256(x, n)  _mm256_or_si256(_mm256_srli_epi64((x), (n)), _mm256_slli_epi64((x), 64 - (n)))
+
+BCL_TARGET("avx2")
+void Sha512::compressAvx2(uint64_t states[8 * 4], const uint64_t words[16 * 4]) {
+	// The same rounds as compress(), with a rolling 16-word schedule
+	__m256i schedule[16];
+	for (int i = 0; i < 16; i++)
+		schedule[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&words[i * 4]));
+	__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&states[0 * 4]));
+	__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&states[1 * 4]));
+	__m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&states[2 * 4]));
+	__m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&states[3 * 4]));
+	__m256i e = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&states[4 * 4]));
+	__m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&states[5 * 4]));
+	__m256i g = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&states[6 * 4]));
+	__m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&states[7 * 4]));
 	for (int i = 0; i < NUM_ROUNDS; i++) {
-		uint64_t t1 = 0U + h + (rotr64(e, 14) ^ rotr64(e, 18) ^ rotr64(e, 41)) + (g ^ (e & (f ^ g))) + ROUND_CONSTANTS[i] + schedule[i];
-		uint64_t t2 = 0U + (rotr64(a, 28) ^ rotr64(a, 34) ^ rotr64(a, 39)) + ((a & (b | c)) | (b & c));
+		__m256i &w = schedule[i & 15];
+		if (i >= 16) {
+			const __m256i w15 = schedule[(i + 1) & 15];
+			const __m256i w2 = schedule[(i + 14) & 15];
+			__m256i s0 = _mm256_xor_si256(_mm256_xor_si256(BCL_ROTR256(w15, 1), BCL_ROTR256(w15, 8)), _mm256_srli_epi64(w15, 7));
+			__m256i s1 = _mm256_xor_si256(_mm256_xor_si256(BCL_ROTR256(w2, 19), BCL_ROTR256(w2, 61)), _mm256_srli_epi64(w2, 6));
+			w = _mm256_add_epi64(_mm256_add_epi64(w, s0), _mm256_add_epi64(schedule[(i + 9) & 15], s1));
+		}
+		__m256i s1 = _mm256_xor_si256(_mm256_xor_si256(BCL_ROTR256(e, 14), BCL_ROTR256(e, 18)), BCL_ROTR256(e, 41));
+		__m256i ch = _mm256_xor_si256(g, _mm256_and_si256(e, _mm256_xor_si256(f, g)));
+		__m256i t1 = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(h, s1), _mm256_add_epi64(ch, w)),
+			_mm256_set1_epi64x(static_cast<long long>(ROUND_CONSTANTS[i])));
+		__m256i s0 = _mm256_xor_si256(_mm256_xor_si256(BCL_ROTR256(a, 28), BCL_ROTR256(a, 34)), BCL_ROTR256(a, 39));
+		__m256i maj = _mm256_or_si256(_mm256_and_si256(a, _mm256_or_si256(b, c)), _mm256_and_si256(b, c));
+		__m256i t2 = _mm256_add_epi64(s0, maj);
 		h = g;
 		g = f;
 		f = e;
-		e = 0U + d + t1;
+		e = _mm256_add_epi64(d, t1);
 		d = c;
 		c = b;
 		b = a;
-		a = 0U + t1 + t2;
+		a = _mm256_add_epi64(t1, t2);
+	}
+	const __m256i vars[8] = {a, b, c, d, e, f, g, h};
+	for (int i = 0; i < 8; i++) {
+		__m256i *p = reinterpret_cast<__m256i *>(&states[i * 4]);
+		_mm256_storeu_si256(p, _mm256_add_epi64(_mm256_loadu_si256(p), vars[i]));
 	}
-	state[0] = 0U + state[0] + a;
-	state[1] = 0U + state[1] + b;
-	state[2] = 0U + state[2] + c;
-	state[3] = 0U + state[3] + d;
-	state[4] = 0U + state[4] + e;
-	state[5] = 0U + state[5] + f;
-	state[6] = 0U + state[6] + g;
-	state[7] = 0U + state[7] + h;
 }
 
+#undef BCL_ROTR256
 
-void Sha512::getHash(const uint8_t msg[], size_t len, uint8_t hashResult[HASH_LEN]) {
-	Sha512().append(msg, len).getHash(hashResult);
-}
 
+BCL_AVX512_WARNINGS_BEGIN
 
-void Sha512::getHmac(const uint8_t key[], size_t keyLen, const uint8_t msg[], size_t msgLen, uint8_t result[HASH_LEN]) {
-	assert(key != nullptr || keyLen == 0);
-	
-	// Preprocess key
-	uint8_t tempKey[BLOCK_LEN] = {};
-	if (keyLen <= BLOCK_LEN)
-		Utils::copyBytes(tempKey, key, keyLen);
-	else
-		getHash(key, keyLen, tempKey);
-	
-	// Compute inner hash
-	for (int i = 0; i < BLOCK_LEN; i++)
-		tempKey[i] ^= 0x36;
-	uint8_t innerHash[HASH_LEN] = {};
-	Sha512()
-		.append(tempKey, BLOCK_LEN)
-		.append(msg, msgLen)
-		.getHash(innerHash);
-	
-	// Compute outer hash
-	for (int i = 0; i < BLOCK_LEN; i++)
-		tempKey[i] ^= 0x36 ^ 0x5C;
-	Sha512()
-		.append(tempKey, BLOCK_LEN)
-		.append(innerHash, HASH_LEN)
-		.getHash(result);
+BCL_TARGET("avx512f")
+void Sha512::compressAvx512(uint64_t states[8 * 8], const uint64_t words[16 * 8]) {
+	// Like compressAvx2(), but with native rotations and ternary logic (0x96 = x ^ y ^ z, 0xCA = x ? y : z, 0xE8 = majority)
+	__m512i schedule[16];
+	for (int i = 0; i < 16; i++)
+		schedule[i] = _mm512_loadu_si512(&words[i * 8]);
+	__m512i a = _mm512_loadu_si512(&states[0 * 8]);
+	__m512i b = _mm512_loadu_si512(&states[1 * 8]);
+	__m512i c = _mm512_loadu_si512(&states[2 * 8]);
+	__m512i d = _mm512_loadu_si512(&states[3 * 8]);
+	__m512i e = _mm512_loadu_si512(&states[4 * 8]);
+	__m512i f = _mm512_loadu_si512(&states[5 * 8]);
+	__m512i g = _mm512_loadu_si512(&states[6 * 8]);
+	__m512i h = _mm512_loadu_si512(&states[7 * 8]);
+	for (int i = 0; i < NUM_ROUNDS; i++) {
+		__m512i &w = schedule[i & 15];
+		if (i >= 16) {
+			const __m512i w15 = schedule[(i + 1) & 15];
+			const __m512i w2 = schedule[(i + 14) & 15];
+			__m512i s0 = _mm512_ternarylogic_epi64(_mm512_ror_epi64(w15, 1), _mm512_ror_epi64(w15, 8), _mm512_srli_epi64(w15, 7), 0x96);
+			__m512i s1 = _mm512_ternarylogic_epi64(_mm512_ror_epi64(w2, 19), _mm512_ror_epi64(w2, 61), _mm512_srli_epi64(w2, 6), 0x96);
+			w = _mm512_add_epi64(_mm512_add_epi64(w, s0), _mm512_add_epi64(schedule[(i + 9) & 15], s1));
+		}
+		__m512i s1 = _mm512_ternarylogic_epi64(_mm512_ror_epi64(e, 14), _mm512_ror_epi64(e, 18), _mm512_ror_epi64(e, 41), 0x96);
+		__m512i ch = _mm512_ternarylogic_epi64(e, f, g, 0xCA);
+		__m512i t1 = _mm512_add_epi64(_mm512_add_epi64(_mm512_add_epi64(h, s1), _mm512_add_epi64(ch, w)),
+			_mm512_set1_epi64(static_cast<long long>(ROUND_CONSTANTS[i])));
+		__m512i s0 = _mm512_ternarylogic_epi64(_mm512_ror_epi64(a, 28), _mm512_ror_epi64(a, 34), _mm512_ror_epi64(a, 39), 0x96);
+		__m512i maj = _mm512_ternarylogic_epi64(a, b, c, 0xE8);
+		__m512i t2 = _mm512_add_epi64(s0, maj);
+		h = g;
+		g = f;
+		f = e;
+		e = _mm512_add_epi64(d, t1);
+		d = c;
+		c = b;
+		b = a;
+		a = _mm512_add_epi64(t1, t2);
+	}
+	const __m512i vars[8] = {a, b, c, d, e, f, g, h};
+	for (int i = 0; i < 8; i++)
+		_mm512_storeu_si512(&states[i * 8], _mm512_add_epi64(_mm512_loadu_si512(&states[i * 8]), vars[i]));
 }
 
+BCL_AVX512_WARNINGS_END
+
+#endif
+
 
 uint64_t Sha512::rotr64(uint64_t x, int i) {
 	return ((0U + x) << (64 - i)) | (x >> i);
@@ -10,21 +10,24 @@
 
 #include <cstddef>
 #include <cstdint>
+#include "CpuFeatures.hpp"
 
 namespace bcl {
 
 
 /* 
  * Computes the SHA-512 hash of a sequence of bytes. The hash value is 64 bytes long.
- * Provides two static methods, and an instantiable stateful hasher.
+ * Provides two static methods, and an instantiable stateful hasher. Like Sha256, a hasher
+ * can be exported and restored as a midstate after a whole number of blocks.
  */
 class Sha512 final {
 	
 	/*---- Scalar constants ----*/
 	
 	public: static constexpr int HASH_LEN = 64;
-	private: static constexpr int BLOCK_LEN = 128;
+	public: static constexpr int BLOCK_LEN = 128;
 	private: static constexpr int NUM_ROUNDS = 80;
+	private: static constexpr std::size_t MAX_LANES = 8;
 	
 	
 	
@@ -43,6 +46,11 @@ class Sha512 final {
 	public: explicit Sha512();
 	
 	
+	// Constructs a hasher that continues from the given midstate, which is the state after hashing
+	// a prefix of the given length in bytes. The length must be a multiple of BLOCK_LEN.
+	public: explicit Sha512(const std::uint64_t midstate[8], std::uint64_t length);
+	
+	
 	// Appends message bytes to this ongoing hasher, and returns this object itself.
 	public: Sha512 &append(const std::uint8_t bytes[], std::size_t len);
 	
@@ -51,7 +59,13 @@ class Sha512 final {
 	public: void getHash(std::uint8_t result[HASH_LEN]);
 	
 	
-	private: void compress();
+	// If nothing is buffered (see Sha256::getMidstate()), then this sets outMidstate to the state words and
+	// outLength to the number of bytes appended, and returns true. Otherwise this returns false.
+	public: bool getMidstate(std::uint64_t outMidstate[8], std::uint64_t &outLength) const;
+	
+	
+	// Compresses the given number of consecutive blocks into the given state.
+	public: static void compress(std::uint64_t state[8], const std::uint8_t blocks[], std::size_t numBlocks);
 	
 	
 	
@@ -63,6 +77,55 @@ class Sha512 final {
 	public: static void getHmac(const std::uint8_t key[], std::size_t keyLen, const std::uint8_t msg[], std::size_t msgLen, std::uint8_t result[HASH_LEN]);
 	
 	
+	// For 0 <= i < n, sets out[i] to the hash of a prefix of prefixLen bytes whose midstate is midstates[i], followed by
+	// msgs[i], i.e. Sha512(midstates[i], prefixLen).append(msgs[i], lens[i]).getHash(out[i]). When the CPU has AVX-512 or
+	// AVX2 (see CpuFeatures), groups of 8 or 4 messages are hashed in parallel in the SIMD lanes. Each out[i] may be the
+	// same array as msgs[i] (e.g. for iterating a hash), but must not overlap any other message. Not constant-time with
+	// respect to the lengths.
+	public: static void getHashesFromMidstates(const std::uint64_t *const midstates[], std::uint64_t prefixLen,
+		const std::uint8_t *const msgs[], const std::size_t lens[], std::size_t n, std::uint8_t out[][HASH_LEN]);
+	
+	
+	// Same as getHashesFromMidstates(), but always with the SIMD kernel of the given number of lanes (8 for AVX-512,
+	// 4 for AVX2). Returns false and leaves the output unchanged if the CPU lacks that kernel. For testing and
+	// benchmarking each kernel on a CPU that has several.
+	public: static bool getHashesFromMidstatesInLanes(const std::uint64_t *const midstates[], std::uint64_t prefixLen,
+		const std::uint8_t *const msgs[], const std::size_t lens[], std::size_t n, std::uint8_t out[][HASH_LEN], std::size_t lanes);
+	
+	
+	// The signature of compressAvx2() and compressAvx512().
+	private: typedef void (*CompressLanes)(std::uint64_t states[], const std::uint64_t words[]);
+	
+	
+	// Returns the fastest multi-lane compression function and sets outLanes to its number of lanes,
+	// or returns null if one message at a time is faster on this CPU.
+	private: static CompressLanes getCompressLanes(std::size_t &outLanes);
+	
+	
+	// Computes getHashesFromMidstates() in groups with the given function of the given number of lanes,
+	// and one at a time for the remainder. The function may be null if lanes is 0.
+	private: static void getHashesFromMidstates(const std::uint64_t *const midstates[], std::uint64_t prefixLen,
+		const std::uint8_t *const msgs[], const std::size_t lens[], std::size_t n, std::uint8_t out[][HASH_LEN],
+		std::size_t lanes, CompressLanes compressLanes);
+	
+	
+	// Hashes the given count <= lanes messages at once with the given function, with the blocks scheduled by MultiBuffer.
+	private: static void getHashesLanes(const std::uint64_t *const midstates[], std::uint64_t prefixLen,
+		const std::uint8_t *const msgs[], const std::size_t lens[], std::size_t count, std::uint8_t out[][HASH_LEN],
+		std::size_t lanes, CompressLanes compressLanes);
+	
+	
+#if defined(BCL_X86)
+	// Compresses one block into each of 4 states. Word i of lane j's state is at states[i * 4 + j],
+	// and word i of lane j's block (decoded as big endian) is at words[i * 4 + j]. The CPU must support AVX2.
+	private: static void compressAvx2(std::uint64_t states[8 * 4], const std::uint64_t words[16 * 4]);
+	
+	
+	// Compresses one block into each of 8 states, like compressAvx2(). The CPU must support AVX-512F.
+	private: static void compressAvx512(std::uint64_t states[8 * 8], const std::uint64_t words[16 * 8]);
+#endif
+	
+	
 	// Requires 1 <= i <= 63
 	private: static std::uint64_t rotr64(std::uint64_t x, int i);
 	
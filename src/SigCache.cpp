@@ -0,0 +1,149 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include <cassert>
+#include <cstring>
+#include "Ecdsa.hpp"
+#include "Sha256.hpp"
+#include "SigCache.hpp"
+
+namespace bcl {
+
+using std::uint8_t;
+using std::uint32_t;
+using std::uint64_t;
+using std::size_t;
+
+
+// The vector value-initializes its entries, which zeros all the atomics (i.e. every entry is empty)
+SigCache::SigCache(size_t capacity, const uint8_t salt[32]) :
+		entries(((capacity + BUCKET_LEN - 1) / BUCKET_LEN + (capacity == 0)) * BUCKET_LEN),
+		numBuckets(entries.size() / BUCKET_LEN),
+		hits(0),
+		misses(0) {
+	assert(salt != nullptr);
+	std::memcpy(this->salt, salt, sizeof(this->salt));
+}
+
+
+bool SigCache::verify(const CurvePoint &publicKey, const Sha256Hash &msgHash, const Uint256 &r, const Uint256 &s) {
+	uint32_t key[8];
+	getKey(publicKey, msgHash, r, s, key);
+	if (containsKey(key)) {
+		hits.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+	misses.fetch_add(1, std::memory_order_relaxed);
+	if (!Ecdsa::verify(publicKey, msgHash, r, s))
+		return false;
+	insertKey(key);
+	return true;
+}
+
+
+bool SigCache::contains(const CurvePoint &publicKey, const Sha256Hash &msgHash, const Uint256 &r, const Uint256 &s) const {
+	uint32_t key[8];
+	getKey(publicKey, msgHash, r, s, key);
+	return containsKey(key);
+}
+
+
+void SigCache::insert(const CurvePoint &publicKey, const Sha256Hash &msgHash, const Uint256 &r, const Uint256 &s) {
+	uint32_t key[8];
+	getKey(publicKey, msgHash, r, s, key);
+	insertKey(key);
+}
+
+
+uint64_t SigCache::getHits() const {
+	return hits.load(std::memory_order_relaxed);
+}
+
+
+uint64_t SigCache::getMisses() const {
+	return misses.load(std::memory_order_relaxed);
+}
+
+
+size_t SigCache::getCapacity() const {
+	return entries.size();
+}
+
+
+void SigCache::getKey(const CurvePoint &publicKey, const Sha256Hash &msgHash, const Uint256 &r, const Uint256 &s, uint32_t key[8]) const {
+	uint8_t temp[32];
+	Sha256 hasher;
+	hasher.append(salt, sizeof(salt));
+	publicKey.x.getBigEndianBytes(temp);
+	hasher.append(temp, sizeof(temp));
+	publicKey.y.getBigEndianBytes(temp);
+	hasher.append(temp, sizeof(temp));
+	hasher.append(msgHash.value, Sha256Hash::HASH_LEN);
+	r.getBigEndianBytes(temp);
+	hasher.append(temp, sizeof(temp));
+	s.getBigEndianBytes(temp);
+	hasher.append(temp, sizeof(temp));
+	const Sha256Hash hash = hasher.getHash();
+	for (int i = 0; i < 8; i++)
+		std::memcpy(&key[i], &hash.value[i * 4], 4);  // Any fixed byte order works, since the hash is uniform
+}
+
+
+bool SigCache::containsKey(const uint32_t key[8]) const {
+	for (int which = 0; which < 2; which++) {
+		size_t bucket = getBucket(key, which);
+		for (size_t i = 0; i < BUCKET_LEN; i++) {
+			const Entry &entry = entries[bucket + i];
+			uint32_t seq = entry.seq.load(std::memory_order_acquire);
+			if (seq == 0 || (seq & 1) != 0)
+				continue;  // Empty or being written
+			bool equal = true;
+			for (int j = 0; j < 8; j++)
+				equal &= entry.key[j].load(std::memory_order_relaxed) == key[j];
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (equal && entry.seq.load(std::memory_order_relaxed) == seq)
+				return true;
+		}
+	}
+	return false;
+}
+
+
+void SigCache::insertKey(const uint32_t key[8]) {
+	// Take an empty entry in either bucket if there is one, otherwise
+	// evict the entry chosen by some bits of the key that were not used for the buckets
+	if (containsKey(key))
+		return;
+	Entry *target = nullptr;
+	for (int which = 0; which < 2 && target == nullptr; which++) {
+		size_t bucket = getBucket(key, which);
+		for (size_t i = 0; i < BUCKET_LEN && target == nullptr; i++) {
+			if (entries[bucket + i].seq.load(std::memory_order_relaxed) == 0)
+				target = &entries[bucket + i];
+		}
+	}
+	if (target == nullptr)
+		target = &entries[getBucket(key, key[2] & 1) + key[3] % BUCKET_LEN];
+	
+	uint32_t seq = target->seq.load(std::memory_order_relaxed);
+	if ((seq & 1) != 0 || !target->seq.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire))
+		return;  // Another thread is writing this entry
+	std::atomic_thread_fence(std::memory_order_release);
+	for (int i = 0; i < 8; i++)
+		target->key[i].store(key[i], std::memory_order_relaxed);
+	target->seq.store(seq + 2, std::memory_order_release);
+}
+
+
+size_t SigCache::getBucket(const uint32_t key[8], int which) const {
+	assert(which == 0 || which == 1);
+	return static_cast<size_t>(key[which] % numBuckets) * BUCKET_LEN;
+}
+
+
+}  // namespace bcl
@@ -0,0 +1,110 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "CurvePoint.hpp"
+#include "Sha256Hash.hpp"
+#include "Uint256.hpp"
+
+namespace bcl {
+
+
+/* 
+ * A bounded cache of valid ECDSA signatures, so that a signature seen again (e.g. at mempool
+ * admission and then in a block) is not verified twice. Entries are keyed by the SHA-256 hash of
+ * a secret salt and the (public key, message hash, r, s) tuple, so an attacker cannot choose inputs
+ * that collide in the table. Each key may be stored in one of two buckets of BUCKET_LEN entries.
+ * Lookups and insertions are lock-free and may be called from any number of threads; an insertion
+ * that races with another writer on the same entry is simply dropped. Not constant-time.
+ */
+class SigCache final {
+	
+	/*---- Fields ----*/
+	
+	// An entry is empty iff seq is 0, and is being written iff seq is odd (a sequence lock).
+	private: struct Entry final {
+		std::atomic<std::uint32_t> seq;
+		std::atomic<std::uint32_t> key[8];
+	};
+	private: std::vector<Entry> entries;
+	
+	private: std::size_t numBuckets;
+	
+	private: std::uint8_t salt[32];
+	
+	private: std::atomic<std::uint64_t> hits;
+	private: std::atomic<std::uint64_t> misses;
+	
+	
+	
+	/*---- Constructors ----*/
+	
+	// Creates an empty cache with room for at least the given number of signatures (and at least one bucket).
+	// The salt should be 32 random bytes that are kept secret.
+	public: explicit SigCache(std::size_t capacity, const std::uint8_t salt[32]);
+	
+	
+	SigCache(const SigCache &) = delete;
+	SigCache &operator=(const SigCache &) = delete;
+	
+	
+	
+	/*---- Methods ----*/
+	
+	// Returns the same value as Ecdsa::verify(), but returns true immediately if the tuple is in the cache.
+	// Otherwise this verifies the signature, and inserts the tuple into the cache if it is valid.
+	public: bool verify(const CurvePoint &publicKey, const Sha256Hash &msgHash, const Uint256 &r, const Uint256 &s);
+	
+	
+	// Tests whether the tuple is in the cache, without verifying it or changing the counters.
+	public: bool contains(const CurvePoint &publicKey, const Sha256Hash &msgHash, const Uint256 &r, const Uint256 &s) const;
+	
+	
+	// Adds the tuple to the cache, evicting another entry if both of its buckets are full. The caller must
+	// have verified the signature.
+	public: void insert(const CurvePoint &publicKey, const Sha256Hash &msgHash, const Uint256 &r, const Uint256 &s);
+	
+	
+	// Returns the number of calls to verify() that were answered from the cache.
+	public: std::uint64_t getHits() const;
+	
+	
+	// Returns the number of calls to verify() that were not answered from the cache.
+	public: std::uint64_t getMisses() const;
+	
+	
+	public: std::size_t getCapacity() const;
+	
+	
+	// Returns the salted hash of the tuple as 8 words.
+	private: void getKey(const CurvePoint &publicKey, const Sha256Hash &msgHash, const Uint256 &r, const Uint256 &s, std::uint32_t key[8]) const;
+	
+	
+	private: bool containsKey(const std::uint32_t key[8]) const;
+	
+	
+	private: void insertKey(const std::uint32_t key[8]);
+	
+	
+	// Returns the index of the first entry of the key's first (which = 0) or second (which = 1) bucket.
+	private: std::size_t getBucket(const std::uint32_t key[8], int which) const;
+	
+	
+	/*---- Class constants ----*/
+	
+	public: static constexpr std::size_t BUCKET_LEN = 4;
+	
+};
+
+
+}  // namespace bcl
@@ -0,0 +1,91 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include <cassert>
+#include "Ecdsa.hpp"
+#include "SigningKey.hpp"
+#include "Utils.hpp"
+
+namespace bcl {
+
+using std::uint8_t;
+using std::size_t;
+
+
+SigningKey::SigningKey(const Uint256 &privKey) :
+		privateKey(privKey),
+		publicKey(CurvePoint::privateExponentToPublicPoint(privKey)),
+		hmac(getKeyedHmac(privKey)) {
+	assert(isValid(privKey));
+	publicKey.toCompressedPoint(compressedPublicKey);
+}
+
+
+SigningKey::~SigningKey() {
+	Utils::clearBytes(&privateKey, sizeof(privateKey));
+}
+
+
+bool SigningKey::signWithHmacNonce(const Sha256Hash &msgHash, Uint256 &outR, Uint256 &outS, uint8_t &outRecId) const {
+	// nonce = HMAC-SHA-256(key = privateKey, message = msgHash), as in Ecdsa::signWithHmacNonce()
+	const Sha256Hash hash = hmac.getHmac(msgHash.value, Sha256Hash::HASH_LEN);
+	Uint256 nonce(hash.value);
+	bool result = Ecdsa::sign(privateKey, msgHash, nonce, outR, outS, outRecId);
+	Utils::clearBytes(&nonce, sizeof(nonce));
+	return result;
+}
+
+
+bool SigningKey::signWithRfc6979(const Sha256Hash &msgHash, const uint8_t extraEntropy[], size_t extraLen, Uint256 &outR, Uint256 &outS, uint8_t &outRecId) const {
+	return Ecdsa::signWithRfc6979(privateKey, msgHash, extraEntropy, extraLen, outR, outS, outRecId);
+}
+
+
+bool SigningKey::signRecoverable(const Sha256Hash &msgHash, uint8_t outSig[65]) const {
+	assert(outSig != nullptr);
+	Uint256 r, s;
+	uint8_t recId;
+	if (!signWithHmacNonce(msgHash, r, s, recId))
+		return false;
+	r.getBigEndianBytes(&outSig[0]);
+	s.getBigEndianBytes(&outSig[32]);
+	outSig[64] = recId;
+	return true;
+}
+
+
+const Uint256 &SigningKey::getPrivateKey() const {
+	return privateKey;
+}
+
+
+const CurvePoint &SigningKey::getPublicKey() const {
+	return publicKey;
+}
+
+
+const uint8_t *SigningKey::getCompressedPublicKey() const {
+	return compressedPublicKey;
+}
+
+
+bool SigningKey::isValid(const Uint256 &privateKey) {
+	return privateKey != Uint256::ZERO && privateKey < CurvePoint::ORDER;
+}
+
+
+HmacSha256 SigningKey::getKeyedHmac(const Uint256 &privateKey) {
+	uint8_t keyBytes[32];
+	privateKey.getBigEndianBytes(keyBytes);
+	HmacSha256 result(keyBytes, sizeof(keyBytes));
+	Utils::clearBytes(keyBytes, sizeof(keyBytes));
+	return result;
+}
+
+
+}  // namespace bcl
@@ -0,0 +1,86 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "CurvePoint.hpp"
+#include "HmacSha256.hpp"
+#include "Sha256Hash.hpp"
+#include "Uint256.hpp"
+
+namespace bcl {
+
+
+/* 
+ * A private key prepared for repeated ECDSA signing. It holds the private key, its normalized public key and
+ * compressed serialization, and the HMAC-SHA-256 context keyed by the private key, so each signWithHmacNonce()
+ * only hashes the message hash. The signatures are identical to those of the Ecdsa functions of the same names.
+ * The private key and HMAC states are wiped by the destructor.
+ */
+class SigningKey final {
+	
+	/*---- Fields ----*/
+	
+	private: Uint256 privateKey;
+	private: CurvePoint publicKey;
+	private: std::uint8_t compressedPublicKey[33];
+	
+	private: HmacSha256 hmac;  // Keyed by the 32-byte big-endian private key
+	
+	
+	
+	/*---- Constructors ----*/
+	
+	// Prepares the given private key, which must be in the range [1, CurvePoint::ORDER) (see isValid()).
+	// Constant-time with respect to the private key.
+	public: explicit SigningKey(const Uint256 &privateKey);
+	
+	
+	// Wipes the private key and the HMAC states.
+	public: ~SigningKey();
+	
+	
+	
+	/*---- Methods ----*/
+	
+	// Same as Ecdsa::signWithHmacNonce() with this private key, including the constant-time behavior.
+	public: bool signWithHmacNonce(const Sha256Hash &msgHash, Uint256 &outR, Uint256 &outS, std::uint8_t &outRecId) const;
+	
+	
+	// Same as Ecdsa::signWithRfc6979() with this private key, including the constant-time behavior.
+	public: bool signWithRfc6979(const Sha256Hash &msgHash, const std::uint8_t extraEntropy[], std::size_t extraLen, Uint256 &outR, Uint256 &outS, std::uint8_t &outRecId) const;
+	
+	
+	// Same as Ecdsa::signRecoverable() with this private key, including the constant-time behavior.
+	public: bool signRecoverable(const Sha256Hash &msgHash, std::uint8_t outSig[65]) const;
+	
+	
+	public: const Uint256 &getPrivateKey() const;
+	
+	
+	// Returns the normalized public key.
+	public: const CurvePoint &getPublicKey() const;
+	
+	
+	// Returns the 33-byte compressed public key (see CurvePoint::toCompressedPoint()).
+	public: const std::uint8_t *getCompressedPublicKey() const;
+	
+	
+	// Tests whether the given value is in the range [1, CurvePoint::ORDER), as required by the constructor.
+	public: static bool isValid(const Uint256 &privateKey);
+	
+	
+	// Returns an HMAC-SHA-256 context keyed by the 32-byte big-endian form of the given private key.
+	private: static HmacSha256 getKeyedHmac(const Uint256 &privateKey);
+	
+};
+
+
+}  // namespace bcl
@@ -46,6 +46,11 @@ Uint256::Uint256(const FieldInt &val) {
 }
 
 
+Uint256::Uint256(const ScalarInt &val) {
+	std::memcpy(this->value, val.value, sizeof(value));
+}
+
+
 uint32_t Uint256::add(const Uint256 &other, uint32_t enable) {
 	assert(&other != this && (enable >> 1) == 0);
 	uint32_t mask = -enable;
@@ -12,7 +12,8 @@
 
 namespace bcl {
 
-class FieldInt;  // Forward declaration
+class FieldInt;   // Forward declaration
+class ScalarInt;  // Forward declaration
 
 
 /* 
@@ -59,6 +60,11 @@ class Uint256 {
 	public: explicit Uint256(const FieldInt &val);
 	
 	
+	// Constructs a Uint256 from the given ScalarInt. Constant-time with respect to the given value.
+	// All possible ScalarInt values are valid.
+	public: explicit Uint256(const ScalarInt &val);
+	
+	
 	
 	/*---- Arithmetic methods ----*/
 	
@@ -142,3 +148,4 @@ class Uint256 {
 }  // namespace bcl
 
 #include "FieldInt.hpp"
+#include "ScalarInt.hpp"
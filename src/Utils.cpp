@@ -6,6 +6,7 @@
  * https://github.com/nayuki/Bitcoin-Cryptography-Library
  */
 
+#include <cassert>
 #include <cstring>
 #include "Utils.hpp"
 
@@ -40,6 +41,22 @@ void Utils::storeBigUint32(std::uint32_t x, uint8_t arr[4]) {
 }
 
 
+std::uint32_t Utils::loadBigUint32(const uint8_t arr[4]) {
+	return static_cast<std::uint32_t>(arr[0]) << 24
+	     | static_cast<std::uint32_t>(arr[1]) << 16
+	     | static_cast<std::uint32_t>(arr[2]) <<  8
+	     | static_cast<std::uint32_t>(arr[3]) <<  0;
+}
+
+
+void Utils::clearBytes(void *dest, std::size_t count) {
+	assert(dest != nullptr || count == 0);
+	volatile uint8_t *p = static_cast<volatile uint8_t *>(dest);
+	for (std::size_t i = 0; i < count; i++)
+		p[i] = 0;
+}
+
+
 const char *Utils::HEX_DIGITS = "0123456789abcdef";
 
 
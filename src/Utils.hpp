@@ -39,6 +39,14 @@ class Utils final {
 	public: static void storeBigUint32(std::uint32_t x, std::uint8_t arr[4]);
 	
 	
+	public: static std::uint32_t loadBigUint32(const std::uint8_t arr[4]);
+	
+	
+	// Sets the given bytes to zero through a volatile pointer, so that the compiler cannot remove the writes
+	// even if the memory is not read afterward. Used for wiping secret values. Does nothing if count is 0.
+	public: static void clearBytes(void *dest, std::size_t count);
+	
+	
 	Utils() = delete;  // Not instantiable
 	
 };
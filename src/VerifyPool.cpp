@@ -0,0 +1,147 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#if defined(BCL_USE_THREADS)
+
+#include <cassert>
+#include "Ecdsa.hpp"
+#include "VerifyPool.hpp"
+
+namespace bcl {
+
+using std::size_t;
+
+
+VerifyPool::VerifyPool(size_t threads) :
+		numThreads(threads != 0 ? threads : (std::thread::hardware_concurrency() != 0 ? std::thread::hardware_concurrency() : 1)),
+		deques(numThreads),
+		generation(0),
+		numBusy(0),
+		stopping(false),
+		jobs(nullptr),
+		results(nullptr),
+		allValid(true) {
+	for (size_t i = 1; i < numThreads; i++)
+		workers.emplace_back(&VerifyPool::workerLoop, this, i);
+}
+
+
+VerifyPool::~VerifyPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	batchStarted.notify_all();
+	for (std::thread &worker : workers)
+		worker.join();
+}
+
+
+bool VerifyPool::verify(const Job jobs[], bool results[], size_t len) {
+	assert((jobs != nullptr && results != nullptr) || len == 0);
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		this->jobs = jobs;
+		this->results = results;
+		allValid = true;
+		for (size_t i = 0; i < numThreads; i++) {
+			std::lock_guard<std::mutex> dequeLock(deques[i].mutex);
+			deques[i].begin = len * i / numThreads;
+			deques[i].end = len * (i + 1) / numThreads;
+		}
+		numBusy = numThreads;
+		generation++;
+	}
+	batchStarted.notify_all();
+	
+	bool valid = runJobs(0);
+	std::unique_lock<std::mutex> lock(mutex);
+	allValid = allValid && valid;
+	numBusy--;
+	batchFinished.wait(lock, [this]() { return numBusy == 0; });
+	return allValid;
+}
+
+
+size_t VerifyPool::getNumThreads() const {
+	return numThreads;
+}
+
+
+void VerifyPool::workerLoop(size_t index) {
+	unsigned long lastGeneration = 0;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			batchStarted.wait(lock, [&]() { return stopping || generation != lastGeneration; });
+			if (stopping)
+				return;
+			lastGeneration = generation;
+		}
+		bool valid = runJobs(index);
+		std::lock_guard<std::mutex> lock(mutex);
+		allValid = allValid && valid;
+		numBusy--;
+		if (numBusy == 0)
+			batchFinished.notify_all();
+	}
+}
+
+
+bool VerifyPool::runJobs(size_t index) {
+	bool valid = true;
+	while (true) {
+		size_t i;
+		if (popFront(index, i)) {
+			const Job &job = jobs[i];
+			results[i] = Ecdsa::verify(job.publicKey, job.msgHash, job.r, job.s);
+			valid = valid && results[i];
+		} else if (!steal(index))
+			return valid;
+	}
+}
+
+
+bool VerifyPool::popFront(size_t index, size_t &outJob) {
+	Deque &deque = deques[index];
+	std::lock_guard<std::mutex> lock(deque.mutex);
+	if (deque.begin == deque.end)
+		return false;
+	outJob = deque.begin;
+	deque.begin++;
+	return true;
+}
+
+
+bool VerifyPool::steal(size_t index) {
+	// Only the owner adds jobs to its deque, and this is called only when it is empty,
+	// so the stolen range can be installed after releasing the victim's lock
+	for (size_t i = 1; i < numThreads; i++) {
+		Deque &victim = deques[(index + i) % numThreads];
+		size_t begin, end;
+		{
+			std::lock_guard<std::mutex> lock(victim.mutex);
+			if (victim.begin == victim.end)
+				continue;
+			end = victim.end;
+			begin = victim.begin + (end - victim.begin) / 2;
+			victim.end = begin;
+		}
+		Deque &deque = deques[index];
+		std::lock_guard<std::mutex> lock(deque.mutex);
+		deque.begin = begin;
+		deque.end = end;
+		return true;
+	}
+	return false;
+}
+
+
+}  // namespace bcl
+
+#endif  // BCL_USE_THREADS
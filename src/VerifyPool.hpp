@@ -0,0 +1,120 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#pragma once
+
+#if defined(BCL_USE_THREADS)
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "CurvePoint.hpp"
+#include "Sha256Hash.hpp"
+#include "Uint256.hpp"
+
+namespace bcl {
+
+
+/* 
+ * A fixed set of worker threads that verify batches of ECDSA signatures in parallel.
+ * Each thread starts with an equal share of a batch, and a thread that runs out of work steals
+ * half of the remaining jobs of another thread. Instances are not copyable, and verify() must
+ * not be called from more than one thread at a time. Not constant-time (all inputs are public).
+ */
+class VerifyPool final {
+	
+	/*---- Helper structure ----*/
+	
+	// The inputs of one call to Ecdsa::verify().
+	public: struct Job final {
+		CurvePoint publicKey;
+		Sha256Hash msgHash;
+		Uint256 r;
+		Uint256 s;
+	};
+	
+	
+	/*---- Fields ----*/
+	
+	private: std::size_t numThreads;
+	
+	private: std::vector<std::thread> workers;
+	
+	// Each thread owns the range of job indices [begin, end) in its deque, taking jobs from the front;
+	// thieves take from the back. The ranges of different threads never overlap.
+	private: struct Deque final {
+		std::mutex mutex;
+		std::size_t begin;
+		std::size_t end;
+	};
+	private: std::vector<Deque> deques;
+	
+	// Guards the batch state below, which workers wait on
+	private: std::mutex mutex;
+	private: std::condition_variable batchStarted;
+	private: std::condition_variable batchFinished;
+	private: unsigned long generation;  // Incremented for each batch
+	private: std::size_t numBusy;       // Threads still working on the current batch
+	private: bool stopping;
+	
+	private: const Job *jobs;
+	private: bool *results;
+	private: bool allValid;
+	
+	
+	
+	/*---- Constructors ----*/
+	
+	// Starts a pool of the given number of threads, which includes the thread that calls verify().
+	// A value of 0 means std::thread::hardware_concurrency() (or 1 if that is unknown).
+	public: explicit VerifyPool(std::size_t numThreads = 0);
+	
+	
+	// Stops and joins all the worker threads.
+	public: ~VerifyPool();
+	
+	
+	VerifyPool(const VerifyPool &) = delete;
+	VerifyPool &operator=(const VerifyPool &) = delete;
+	
+	
+	
+	/*---- Methods ----*/
+	
+	// Verifies jobs[i] for 0 <= i < len, setting results[i] to the value of Ecdsa::verify(). Blocks until all
+	// jobs are done, and returns true iff all signatures are valid. The calling thread takes part in the work.
+	public: bool verify(const Job jobs[], bool results[], std::size_t len);
+	
+	
+	public: std::size_t getNumThreads() const;
+	
+	
+	// The loop of each background thread, which runs batches until the pool is stopped.
+	private: void workerLoop(std::size_t index);
+	
+	
+	// Runs and steals jobs until none are left in any deque, starting from the thread's own deque.
+	// Returns true iff all the signatures that this thread verified are valid.
+	private: bool runJobs(std::size_t index);
+	
+	
+	// Takes the next job index from the front of the given thread's deque, returning false if it is empty.
+	private: bool popFront(std::size_t index, std::size_t &outJob);
+	
+	
+	// Moves the back half of another thread's jobs to the given thread's deque, returning false if all are empty.
+	private: bool steal(std::size_t index);
+	
+};
+
+
+}  // namespace bcl
+
+#endif  // BCL_USE_THREADS
@@ -0,0 +1,133 @@
+/* 
+ * A runnable main program that tests the functionality of class AffinePoint.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "gtest/gtest.h"
+
+#include "TestHelper.hpp"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include "AffinePoint.hpp"
+#include "CurvePoint.hpp"
+#include "FieldInt.hpp"
+#include "Uint256.hpp"
+
+
+using namespace bcl;
+
+
+/*---- Helper functions ----*/
+
+static CurvePoint multiplyG(const char *n) {
+	CurvePoint p = CurvePoint::G;
+	p.multiply(Uint256(n));
+	return p;  // Not normalized
+}
+
+
+/*---- Test suite ----*/
+
+TEST(affine_point, conversion) {
+	AffinePoint g(CurvePoint::G);
+	assert(g.x == CurvePoint::G.x && g.y == CurvePoint::G.y);
+	assert(g.toCurvePoint() == CurvePoint::G);
+	assert(g.isOnCurve() && !g.isZero());
+	
+	AffinePoint zero(CurvePoint::ZERO);
+	assert(zero == AffinePoint::ZERO && zero.isZero() && !zero.isOnCurve());
+	assert(zero.toCurvePoint() == CurvePoint::ZERO);
+	
+	CurvePoint p = multiplyG("406DC83D14DE5D2D272C480C42F5988AD6154ADCDBA66F1D03E7AA36693FF7D3");
+	p.normalize();
+	AffinePoint q(p);
+	assert(q.isOnCurve() && q.toCurvePoint() == p);
+	
+	AffinePoint r = g;
+	r.replace(q, 0);
+	assert(r == g);
+	r.replace(q, 1);
+	assert(r == q && r != g);
+}
+
+
+TEST(affine_point, mixed_add) {
+	const size_t CASE_SIZE = 9U;
+	const array<array<const char *, 2>, CASE_SIZE> cases{{
+		{{"0000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000000000"}},
+		{{"0000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000000007"}},
+		{{"0000000000000000000000000000000000000000000000000000000000000003", "0000000000000000000000000000000000000000000000000000000000000000"}},
+		{{"0000000000000000000000000000000000000000000000000000000000000001", "0000000000000000000000000000000000000000000000000000000000000001"}},
+		{{"0000000000000000000000000000000000000000000000000000000000000005", "0000000000000000000000000000000000000000000000000000000000000005"}},
+		{{"0000000000000000000000000000000000000000000000000000000000000001", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140"}},
+		{{"0000000000000000000000000000000000000000000000000000000000000002", "0000000000000000000000000000000000000000000000000000000000000003"}},
+		{{"B9199737B6E6C3126BB68D37E938ECCE04F6ECBEEDA1E9CBF10AA6138B5C842F", "4263B3E7A22922C05FFCE2E922CEEBC583B7E5C537C8A4F3572DA96BBA8813CB"}},
+		{{"F750484A92E6ED351C6D5CC9738085F62C5389C11E7C6BDFA292EFAF20D0AC1C", "6E139E20DAF5E0F98D0F21B7648016579809019F9022DA7334EDD864E7916B3D"}},
+	}};
+	for (const array<const char *, 2> &tc : cases) {
+		CurvePoint a = multiplyG(tc[0]);  // Projective, usually with z != 1
+		CurvePoint b = multiplyG(tc[1]);
+		b.normalize();
+		
+		CurvePoint expect = a;
+		expect.add(b);
+		expect.normalize();
+		
+		CurvePoint actual = a;
+		actual.add(AffinePoint(b));
+		actual.normalize();
+		assert(actual == expect);
+		
+		// Same sum with a normalized left operand
+		a.normalize();
+		actual = a;
+		actual.add(AffinePoint(b));
+		actual.normalize();
+		assert(actual == expect);
+	}
+}
+
+
+TEST(affine_point, from_curve_points) {
+	CurvePoint points[4] = {
+		multiplyG("F563BBA48829799D3D60E66AC9C0537D1DBDD32A1C2D893153A8384FEB0062D8"),
+		CurvePoint::ZERO,
+		multiplyG("0000000000000000000000000000000000000000000000000000000000000003"),
+		CurvePoint::G,
+	};
+	AffinePoint actual[4];
+	AffinePoint::fromCurvePoints(points, actual, 4);
+	for (int i = 0; i < 4; i++) {
+		CurvePoint p = points[i];
+		p.normalize();
+		assert(actual[i] == AffinePoint(p));
+		assert(actual[i].toCurvePoint() == p);
+	}
+	assert(actual[1].isZero());
+}
+
+TEST(affine_point, serialization) {
+	CurvePoint p = multiplyG("F563BBA48829799D3D60E66AC9C0537D1DBDD32A1C2D893153A8384FEB0062D8");
+	p.normalize();
+	AffinePoint q(p);
+	
+	std::uint8_t expect[33];
+	std::uint8_t actual[33];
+	p.toCompressedPoint(expect);
+	q.toCompressedPoint(actual);
+	assert(std::memcmp(expect, actual, sizeof(expect)) == 0);
+	
+	std::uint8_t xOnly[32];
+	q.toXOnly(xOnly);
+	assert(std::memcmp(xOnly, &expect[1], sizeof(xOnly)) == 0);
+	
+	Bytes gx = hexBytes("79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798");
+	AffinePoint(CurvePoint::G).toXOnly(xOnly);
+	assert(std::memcmp(xOnly, gx.data(), sizeof(xOnly)) == 0);
+}
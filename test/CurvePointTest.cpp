@@ -365,6 +365,146 @@ TEST(curve_point, multiply) {
 }
 
 
+TEST(curve_point, multiply_window_bits) {
+	const size_t CASE_SIZE = 4U;
+	const array<const char *, CASE_SIZE> cases{{
+		"0000000000000000000000000000000000000000000000000000000000000000",
+		"8000000000000000000000000000000000000000000000000000000000000001",
+		"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF",
+		"F563BBA48829799D3D60E66AC9C0537D1DBDD32A1C2D893153A8384FEB0062D8",
+	}};
+	for (const char *tc : cases) {
+		const Uint256 n(tc);
+		CurvePoint expect = CurvePoint::G;
+		expect.multiply(n);
+		expect.normalize();
+		CurvePoint p[6] = {CurvePoint::G, CurvePoint::G, CurvePoint::G, CurvePoint::G, CurvePoint::G, CurvePoint::G};
+		p[0].multiply<2>(n);
+		p[1].multiply<3>(n);
+		p[2].multiply<4>(n);
+		p[3].multiply<5>(n);
+		p[4].multiply<6>(n);
+		p[5].multiply<7>(n);
+		for (CurvePoint &q : p) {
+			q.normalize();
+			assert(q == expect);
+		}
+	}
+}
+
+
+TEST(curve_point, multiply_vartime) {
+	const size_t CASE_SIZE = 5U;
+	const array<const char *, CASE_SIZE> cases{{
+		"0000000000000000000000000000000000000000000000000000000000000000",
+		"0000000000000000000000000000000000000000000000000000000000000001",
+		"8000000000000000000000000000000000000000000000000000000000000001",
+		"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF",
+		"F563BBA48829799D3D60E66AC9C0537D1DBDD32A1C2D893153A8384FEB0062D8",
+	}};
+	for (const char *tc : cases) {
+		const Uint256 n(tc);
+		CurvePoint expect = CurvePoint::G;
+		expect.multiply(n);
+		expect.normalize();
+		CurvePoint actual = CurvePoint::G;
+		actual.multiplyVartime(n);
+		actual.normalize();
+		assert(actual == expect);
+	}
+	
+	CurvePoint p = CurvePoint::G;
+	p.multiplyVartime(CurvePoint::ORDER);
+	assert(p == CurvePoint::ZERO);
+	p = CurvePoint::ZERO;
+	p.multiplyVartime(Uint256("F563BBA48829799D3D60E66AC9C0537D1DBDD32A1C2D893153A8384FEB0062D8"));
+	assert(p == CurvePoint::ZERO);
+}
+
+TEST(curve_point, multiply_endomorphism) {
+	const size_t CASE_SIZE = 8U;
+	const array<const char *, CASE_SIZE> cases{{
+		"0000000000000000000000000000000000000000000000000000000000000000",
+		"0000000000000000000000000000000000000000000000000000000000000001",
+		"5363AD4CC05C30E0A5261C028812645A122E22EA20816678DF02967C1B23BD72",  // Lambda
+		"8000000000000000000000000000000000000000000000000000000000000001",
+		"C7D9B8F8E1A2E98A1B28E76F2B6D2F5A9B6D1F0E3C2B4A59687766554433221F",
+		"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140",
+		"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141",  // Order
+		"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF",
+	}};
+	const CurvePoint p = CurvePoint::privateExponentToPublicPoint(Uint256("F563BBA48829799D3D60E66AC9C0537D1DBDD32A1C2D893153A8384FEB0062D8"));
+	for (const char *tc : cases) {
+		const Uint256 n(tc);
+		for (const CurvePoint &base : {CurvePoint::G, p}) {
+			CurvePoint expect = base;
+			expect.multiply(n);
+			expect.normalize();
+			CurvePoint actual = base;
+			actual.multiplyEndomorphism(n);
+			actual.normalize();
+			assert(actual == expect);
+		}
+	}
+	CurvePoint zero = CurvePoint::ZERO;
+	zero.multiplyEndomorphism(Uint256("C7D9B8F8E1A2E98A1B28E76F2B6D2F5A9B6D1F0E3C2B4A59687766554433221F"));
+	assert(zero.isZero());
+}
+
+TEST(curve_point, multiply_dual_vartime) {
+	const size_t CASE_SIZE = 4U;
+	const array<array<const char *, 3>, CASE_SIZE> cases{{
+		{"0000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000000001", "0000000000000000000000000000000000000000000000000000000000000000"},
+		{"0000000000000000000000000000000000000000000000000000000000000001", "0000000000000000000000000000000000000000000000000000000000000001", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140"},
+		{"8000000000000000000000000000000000000000000000000000000000000001", "F563BBA48829799D3D60E66AC9C0537D1DBDD32A1C2D893153A8384FEB0062D8", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"},
+		{"406DC83D14DE5D2D272C480C42F5988AD6154ADCDBA66F1D03E7AA36693FF7D3", "0000000000000000000000000000000000000000000000000000000000000003", "C7D9B8F8E1A2E98A1B28E76F2B6D2F5A9B6D1F0E3C2B4A59687766554433221F"},
+	}};
+	for (const array<const char *, 3> &tc : cases) {
+		// Checks that u1*G + u2*(k*G) equals the sum of the separate products
+		const Uint256 u1(tc[0]);
+		const CurvePoint p = CurvePoint::privateExponentToPublicPoint(Uint256(tc[1]));
+		const Uint256 u2(tc[2]);
+		CurvePoint expect = CurvePoint::G;
+		expect.multiply(u1);
+		CurvePoint q = p;
+		q.multiply(u2);
+		expect.add(q);
+		expect.normalize();
+		CurvePoint actual = CurvePoint::multiplyDualVartime(u1, p, u2);
+		actual.normalize();
+		assert(actual == expect);
+	}
+}
+
+
+TEST(curve_point, from_compressed_point) {
+	const size_t CASE_SIZE = 4U;
+	const array<const char *, CASE_SIZE> cases{{
+		"0000000000000000000000000000000000000000000000000000000000000001",
+		"0000000000000000000000000000000000000000000000000000000000000002",
+		"F563BBA48829799D3D60E66AC9C0537D1DBDD32A1C2D893153A8384FEB0062D8",
+		"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140",
+	}};
+	for (const char *tc : cases) {
+		const CurvePoint p = CurvePoint::privateExponentToPublicPoint(Uint256(tc));
+		uint8_t bytes[33];
+		p.toCompressedPoint(bytes);
+		CurvePoint q = CurvePoint::ZERO;
+		assert(CurvePoint::fromCompressedPoint(bytes, q));
+		assert(q == p);
+	}
+	
+	uint8_t bytes[33] = {0x02};
+	CurvePoint q = CurvePoint::ZERO;
+	bytes[32] = 5;  // x^3 + 7 is not a square
+	assert(!CurvePoint::fromCompressedPoint(bytes, q));
+	bytes[32] = 1;
+	assert(CurvePoint::fromCompressedPoint(bytes, q) && q.isOnCurve());
+	bytes[0] = 0x04;  // Invalid header
+	assert(!CurvePoint::fromCompressedPoint(bytes, q));
+	assert(!CurvePoint::fromX(Uint256("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC30"), 0, q));  // Field modulus + 1
+}
+
 TEST(curve_point, multiply_mod_order) {
 	#ifdef USE_EMBEDDED
 	const size_t CASE_SIZE = 25U;
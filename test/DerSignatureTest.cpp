@@ -0,0 +1,111 @@
+/* 
+ * A runnable main program that tests the functionality of class DerSignature.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "gtest/gtest.h"
+
+#include "TestHelper.hpp"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include "DerSignature.hpp"
+#include "Uint256.hpp"
+
+
+using namespace bcl;
+using std::uint8_t;
+
+
+/*---- Test cases ----*/
+
+TEST(der_signature, encode_and_decode) {
+	struct DerCase {
+		const char *der;
+		const char *r;
+		const char *s;
+	};
+	const size_t CASE_SIZE = 6U;
+	const array<DerCase, CASE_SIZE> cases{{
+		{"3006020101020101", "0000000000000000000000000000000000000000000000000000000000000001", "0000000000000000000000000000000000000000000000000000000000000001"},
+		{"30070202008002017F", "0000000000000000000000000000000000000000000000000000000000000080", "000000000000000000000000000000000000000000000000000000000000007F"},
+		{"3046022100FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF0221008000000000000000000000000000000000000000000000000000000000000000", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF", "8000000000000000000000000000000000000000000000000000000000000000"},
+		{"300702010002021234", "0000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000001234"},
+		{"303E0220276FBC83DD7398F15728E6BEBF4F7E6021B8C26BC02373AB55DACB8F8C773FE6021A00BF0FD2DCEC9115DFE4408CCEC5F72FC1DD6E858F374931300E", "276FBC83DD7398F15728E6BEBF4F7E6021B8C26BC02373AB55DACB8F8C773FE6", "00000000000000BF0FD2DCEC9115DFE4408CCEC5F72FC1DD6E858F374931300E"},
+		{"302702020086022100CE2F7ECC5DDAED5BA7244DD0462C37F3CCCA9F1FEDE003F4DCE05DE7C1410414", "0000000000000000000000000000000000000000000000000000000000000086", "CE2F7ECC5DDAED5BA7244DD0462C37F3CCCA9F1FEDE003F4DCE05DE7C1410414"},
+	}};
+	
+	Bytes batch;
+	for (const DerCase &tc : cases) {
+		const Bytes der = hexBytes(tc.der);
+		const Uint256 r(tc.r);
+		const Uint256 s(tc.s);
+		uint8_t buf[DerSignature::MAX_LEN];
+		assert(DerSignature::encode(r, s, buf) == der.size());
+		assert(std::memcmp(buf, der.data(), der.size()) == 0);
+		
+		Uint256 actualR = Uint256::ONE;
+		Uint256 actualS = Uint256::ONE;
+		assert(DerSignature::decode(der.data(), der.size(), actualR, actualS));
+		assert(actualR == r && actualS == s);
+		batch.insert(batch.end(), der.begin(), der.end());
+	}
+	
+	// Batch decoding, including stopping early at maxCount and at a truncated signature
+	Uint256 rs[CASE_SIZE + 1], ss[CASE_SIZE + 1];
+	size_t consumed = 1;
+	assert(DerSignature::decodeBatch(batch.data(), batch.size(), rs, ss, CASE_SIZE + 1, consumed) == CASE_SIZE);
+	assert(consumed == batch.size());
+	for (size_t i = 0; i < CASE_SIZE; i++)
+		assert(rs[i] == Uint256(cases[i].r) && ss[i] == Uint256(cases[i].s));
+	assert(DerSignature::decodeBatch(batch.data(), batch.size(), rs, ss, 2, consumed) == 2);
+	assert(consumed == 8 + 9);
+	assert(DerSignature::decodeBatch(batch.data(), batch.size() - 1, rs, ss, CASE_SIZE, consumed) == CASE_SIZE - 1);
+	assert(consumed == batch.size() - 41);
+	assert(DerSignature::decodeBatch(nullptr, 0, nullptr, nullptr, 0, consumed) == 0 && consumed == 0);
+}
+
+
+TEST(der_signature, decode_invalid) {
+	const char *CASES[] = {
+		"",
+		"3106020101020101",       // Not a sequence
+		"3007020101020101",       // Total length too long
+		"3006030101020101",       // R is not an integer
+		"3006020101030101",       // S is not an integer
+		"300602000201010101",     // Empty R
+		"3006020101020001",       // Empty S
+		"3006020180020101",       // Negative R
+		"3006020101020180",       // Negative S
+		"30070202000102017F",     // Excess padding in R
+		"300702017F02020001",     // Excess padding in S
+		"3006020201020101",       // R length overruns
+		"3005020101020101",       // S length overruns the total length
+		"3007020101020201",       // S length overruns the data
+		"3046022101FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF0221008000000000000000000000000000000000000000000000000000000000000000",  // R is 2^256 or more
+		"30470222000080FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF0221008000000000000000000000000000000000000000000000000000000000000000",  // Longer than MAX_LEN
+	};
+	for (const char *tc : CASES) {
+		const Bytes der = hexBytes(tc);
+		Uint256 r = Uint256::ONE;
+		Uint256 s = Uint256::ONE;
+		assert(!DerSignature::decode(der.data(), der.size(), r, s));
+		assert(r == Uint256::ONE && s == Uint256::ONE);
+		size_t consumed = 1;
+		assert(DerSignature::decodeBatch(der.data(), der.size(), &r, &s, 1, consumed) == 0 && consumed == 0);
+	}
+	
+	// A trailing byte is invalid for decode(), but starts the next signature for decodeBatch()
+	const Bytes der = hexBytes("3006020101020101" "00");
+	Uint256 r = Uint256::ZERO;
+	Uint256 s = Uint256::ZERO;
+	assert(!DerSignature::decode(der.data(), der.size(), r, s));
+	size_t consumed = 0;
+	assert(DerSignature::decodeBatch(der.data(), der.size(), &r, &s, 1, consumed) == 1 && consumed == 8);
+	assert(r == Uint256::ONE && s == Uint256::ONE);
+}
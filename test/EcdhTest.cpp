@@ -0,0 +1,74 @@
+/* 
+ * A runnable main program that tests the functionality of class Ecdh.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "gtest/gtest.h"
+
+#include "TestHelper.hpp"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include "CurvePoint.hpp"
+#include "Ecdh.hpp"
+#include "Uint256.hpp"
+
+
+using namespace bcl;
+using std::uint8_t;
+
+
+/*---- Test cases ----*/
+
+TEST(ecdh, shared_secret) {
+	struct SecretCase {
+		const char *privateKey;
+		const char *publicKey;  // Compressed
+		const char *secret;
+	};
+	const size_t CASE_SIZE = 4U;
+	const array<SecretCase, CASE_SIZE> cases{{
+		{"0B13A023AF11BAB1240F16A76490FD4AC393FD0E1CC62BE5783646BF0324AAC4", "03B0896C3B025C71BAF69FEB280CBD9DE518D212077B3DF1BDB0CCFFD32ADBC52B", "E27FD005FABB80DDD0D1687F83A46ADF3DE4F77299FB2C1A12FAC1DFFB2D287B"},
+		{"3B2DE7DE22F6CF670F849D97A983C108087A442CBD9B945EFB51A50925BC1605", "03A5276E59431568A9D6B9C0E4A70B73C2A0C0523DE1F591AC5F07DC458F402829", "B499570549CC6FFE918BD107B5B48ACDD0BAE3B48AF1797EF97D3BCBC1C8ED55"},
+		{"576EB8E4672774F3E33E474AF096DBB7C52EF7610536BC6C1E3EF5DA17D625F9", "03B95910ED19C5D5F8E793A0B936197529197B9EF615098DE8B455100E9C142600", "4943CA9D94CA2DB510AB06B4A6F1D71509E46BD3671C1559FC9AE64015131CA5"},
+		{"0F5FA1A48C213116A9A8430F95BC11766A951CAD378876E6B956629F35D85603", "02BF3B9207DAE44289A1452C68A07CCDC7AB69FB11262F05F39E439EDF9C9B238B", "DC42CA904940059BEFF6C496F879E06DE4F5298CF7D33A440A9ABFB068089A36"},
+	}};
+	for (const SecretCase &tc : cases) {
+		uint8_t secret[32];
+		assert(Ecdh::sharedSecret(Uint256(tc.privateKey), hexBytes(tc.publicKey).data(), secret));
+		assert(Bytes(secret, secret + 32) == hexBytes(tc.secret));
+	}
+}
+
+
+TEST(ecdh, symmetry) {
+	const Uint256 a("C7D9B8F8E1A2E98A1B28E76F2B6D2F5A9B6D1F0E3C2B4A59687766554433221F");
+	const Uint256 b("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140");
+	uint8_t secretA[32];
+	uint8_t secretB[32];
+	assert(Ecdh::sharedSecret(a, CurvePoint::privateExponentToPublicPoint(b), secretA));
+	assert(Ecdh::sharedSecret(b, CurvePoint::privateExponentToPublicPoint(a), secretB));
+	assert(std::memcmp(secretA, secretB, sizeof(secretA)) == 0);
+}
+
+
+TEST(ecdh, invalid_inputs) {
+	uint8_t secret[32];
+	const Uint256 privateKey("0000000000000000000000000000000000000000000000000000000000000001");
+	assert(!Ecdh::sharedSecret(Uint256::ZERO, CurvePoint::G, secret));
+	assert(!Ecdh::sharedSecret(CurvePoint::ORDER, CurvePoint::G, secret));
+	assert(!Ecdh::sharedSecret(privateKey, CurvePoint::ZERO, secret));
+	assert(!Ecdh::sharedSecret(privateKey, CurvePoint(CurvePoint::FI_ONE, CurvePoint::FI_ONE), secret));  // Not on curve
+	
+	Bytes publicKey = hexBytes("0279BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798");
+	assert(Ecdh::sharedSecret(privateKey, publicKey.data(), secret));
+	publicKey[0] = 0x04;
+	assert(!Ecdh::sharedSecret(privateKey, publicKey.data(), secret));
+	publicKey = hexBytes("020000000000000000000000000000000000000000000000000000000000000005");  // No point with this x
+	assert(!Ecdh::sharedSecret(privateKey, publicKey.data(), secret));
+}
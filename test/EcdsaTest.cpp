@@ -14,7 +14,10 @@
 #include <array>
 #include <cstdio>
 #include <cstdlib>
+#include <vector>
+#include "CurvePoint.hpp"
 #include "Ecdsa.hpp"
+#include "Sha256.hpp"
 #include "Sha256Hash.hpp"
 #include "Uint256.hpp"
 
@@ -728,6 +731,122 @@ TEST(ecdsa, sign_and_verify) {
 }
 
 
+TEST(ecdsa, recover_public_key) {
+	struct RecoverCase {
+		const char *privateKey;
+		const char *msgHash;  // Byte-reversed
+		const char *nonce;
+		const char *expectedR;
+		const char *expectedS;
+		uint8_t expectedRecId;
+		const char *pubPointX;
+		const char *pubPointY;
+	};
+	const size_t CASE_SIZE = 4U;
+	const array<RecoverCase, CASE_SIZE> cases{{
+		{"117ABB82E9DA82EF5135F375205A243DF7137C5FC7891799602E4FE31AF35DE1", "42A98F3D3EE09518C8E23699AF60FA6D97BB457436A68142B342D2395ECFE405", "648F8E193A06C30767E71FB32A4AB2ABEE2DC640DA96782B93E82E3DB5A8F016", "3F264A873D551FC758E7937965B5FF440EEE0B7182265240DBA111DD0B49BF77", "0A28F1FDAE26AACEA9363740B516A9E2018874FF9B335CE07A1FB8BD361CC1D4", 0, "60B95668E898B5DCC57A37DE9B4D4C3635A2BA64C9D3D38AF3938A371E6AB305", "B66D063E12F17569708B061C74F88E21BC87006CE17B3726CE000507010B38CC"},
+		{"B930962DBD208ACF4046E736E7755749BE70DF8AA4B440D1B7C53EAC659F2780", "289E5175E02C788C2D442CFE81D6BE0533D8C13E253EF763FDA45D37ACCFE4D4", "0A78009591722CC84825CA95EE7FFA52428047ED12C9076044EBFE8665F9657F", "2D20E27338EB006035F047B9EF7270CCFEB5E1ED641EA5D4838BA43CB7268A6E", "58FC64866B77512E301E07D4648D2C818FE77C161FCE397A07B331B9B30643E5", 0, "1E852AE5B5588006A3C14CFE6B379D5E8A2DDF16BC17EED3EEB149CC2362D33B", "66FDFB0E8B2E109DA550EFE88E0DB910D63A6450CDB8B597C3A3B6E29F4B504C"},
+		{"5136A630D30F6E9E98B6315CA5FC8ACE220381CB9239794A7660F03B7DCC8D96", "51B5DF22EAEAF7A6101B57CFB45084CB98864B1502C6ED1A692DA604366A13A4", "6970041381069BFEB059842158D5B779445816BB6EB90A5F342DBA43AD7F1369", "0175B576A6E665E196FF042867C20511369DE623A1CB1E9A633FD1B50BBEA91E", "7925A3E0DCA19E43F48A48CAFA57CBE749C9E169EF88DB62D5A18181654EF817", 1, "1F1E454E95D42D2A68724809C8B880D97C51D5B5D6BD4BB195C74184D6768DFA", "4A9C3EDB61AA401046C68CB09A529DD2AF4098C650D8D440D737705EC6BE44FF"},
+		{"BAFE6D67817400E438DEF41EE8FB668B77FA39229314C02E2DE4E592A7F67BE0", "92253243F3471651D425293DFE382CB9017FE15FC46B1DEB79E561F5A38F7242", "0A99CDF5244FF16A73F4DA6273A8E3D2728F433AA3FEAF387262B8532E972E15", "6E5722C521514DBF630DC0B184BB37C48438D9E97681313EF907BDD04B3C0746", "4E51759EB5F1EFD6602B526AAD1FE5471A2D531F3AAAD84F1CA1610B41417EF8", 1, "6F73CE58BFB50084219C8C38FBA32F379A012C90D6052ABD59D416BCAC9A28F1", "809C991E064346208DC9F690020A743D19148742C687316603CAA31E633DDE81"},
+	}};
+	
+	for (const RecoverCase &tc : cases) {
+		const Uint256 privateKey(tc.privateKey);
+		const Sha256Hash msgHash(tc.msgHash);
+		const CurvePoint expectedKey(tc.pubPointX, tc.pubPointY);
+		Uint256 r, s;
+		uint8_t recId;
+		assert(Ecdsa::sign(privateKey, msgHash, Uint256(tc.nonce), r, s, recId));
+		assert(r == Uint256(tc.expectedR) && s == Uint256(tc.expectedS) && recId == tc.expectedRecId);
+		
+		CurvePoint actualKey = CurvePoint::ZERO;
+		assert(Ecdsa::recoverPublicKey(msgHash, r, s, recId, actualKey));
+		assert(actualKey == expectedKey);
+		// The other parity gives a different key (or none)
+		assert(!Ecdsa::recoverPublicKey(msgHash, r, s, recId ^ 1, actualKey) || actualKey != expectedKey);
+		
+		// Round trip through the compact form
+		uint8_t sig[65];
+		assert(Ecdsa::signRecoverable(privateKey, msgHash, sig));
+		actualKey = CurvePoint::ZERO;
+		assert(Ecdsa::recoverPublicKey(msgHash, sig, actualKey));
+		assert(actualKey == expectedKey);
+		sig[64] ^= 1;
+		assert(!Ecdsa::recoverPublicKey(msgHash, sig, actualKey) || actualKey != expectedKey);
+		sig[64] = 4;
+		assert(!Ecdsa::recoverPublicKey(msgHash, sig, actualKey));
+	}
+	
+	// Invalid r values
+	const Sha256Hash msgHash(cases[0].msgHash);
+	const Uint256 s(cases[0].expectedS);
+	CurvePoint key = CurvePoint::ZERO;
+	assert(!Ecdsa::recoverPublicKey(msgHash, Uint256::ZERO, s, 0, key));
+	assert(!Ecdsa::recoverPublicKey(msgHash, CurvePoint::ORDER, s, 0, key));
+	assert(!Ecdsa::recoverPublicKey(msgHash, Uint256("0000000000000000000000000000000000000000000000000000000000000005"), s, 0, key));  // Not an x-coordinate
+	assert(!Ecdsa::recoverPublicKey(msgHash, Uint256(cases[0].expectedR), s, 2, key));  // r + order is past the field modulus
+}
+
+
+TEST(ecdsa, sign_with_rfc6979) {
+	struct SignCase {
+		const char *privateKey;
+		const char *message;  // ASCII, hashed with SHA-256
+		const char *expectedR;
+		const char *expectedS;
+	};
+	const size_t CASE_SIZE = 5U;
+	const array<SignCase, CASE_SIZE> cases{{
+		{"0000000000000000000000000000000000000000000000000000000000000001", "Satoshi Nakamoto", "934B1EA10A4B3C1757E2B0C017D0B6143CE3C9A7E6A4A49860D7A6AB210EE3D8", "2442CE9D2B916064108014783E923EC36B49743E2FFA1C4496F01A512AAFD9E5"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "Satoshi Nakamoto", "FD567D121DB66E382991534ADA77A6BD3106F0A1098C231E47993447CD6AF2D0", "6B39CD0EB1BC8603E159EF5C20A5C8AD685A45B06CE9BEBED3F153D10D93BED5"},
+		{"0000000000000000000000000000000000000000000000000000000000000001", "All those moments will be lost in time, like tears in rain. Time to die...", "8600DBD41E348FE5C9465AB92D23E3DB8B98B873BEECD930736488696438CB6B", "547FE64427496DB33BF66019DACBF0039C04199ABB0122918601DB38A72CFC21"},
+		{"F8B8AF8CE3C7CCA5E300D33939540C10D45CE001B8F252BFBC57BA0342904181", "Alan Turing", "7063AE83E7F62BBB171798131B4A0564B956930092B33B07B395615D9EC7E15C", "58DFCC1E00A35E1572F366FFE34BA0FC47DB1E7189759B9FB233C5B05AB388EA"},
+		{"E91671C46231F833A6406CCBEA0E3E392C76C167BAC1CB013F6F1013980455C2", "There is a computer disease that anybody who works with computers knows about. It's a very serious disease and it interferes completely with the work. The trouble with computers is that you 'play' with them!", "B552EDD27580141F3B2A5463048CB7CD3E047B97C9F98076C32DBDF85A68718B", "279FA72DD19BFAE05577E06C7C0C1900C371FCD5893F7E1D56A37D30174671F6"},
+	}};
+	
+	for (const SignCase &tc : cases) {
+		const Bytes msg = asciiBytes(tc.message);
+		const Sha256Hash msgHash = Sha256::getHash(msg.data(), msg.size());
+		Uint256 r, s;
+		assert(Ecdsa::signWithRfc6979(Uint256(tc.privateKey), msgHash, r, s));
+		assert(r == Uint256(tc.expectedR) && s == Uint256(tc.expectedS));
+	}
+	
+	const Bytes msg = asciiBytes("Satoshi Nakamoto");
+	const Sha256Hash msgHash = Sha256::getHash(msg.data(), msg.size());
+	uint8_t extra[32];
+	for (int i = 0; i < 32; i++)
+		extra[i] = static_cast<uint8_t>(i);
+	Uint256 r, s;
+	uint8_t recId;
+	assert(Ecdsa::signWithRfc6979(Uint256::ONE, msgHash, extra, sizeof(extra), r, s, recId));
+	assert(r == Uint256("75AB07749EE08AAEC97B52AC3E73C3B76CF0E5EED03929D64AFECF6405799CAC"));
+	assert(s == Uint256("53F78C086ACF03F16DD417F94B453DDBAA9CB47B5AFD524E8AD1352E9116C05D"));
+	assert(!Ecdsa::signWithRfc6979(Uint256::ZERO, msgHash, r, s));
+	assert(!Ecdsa::signWithRfc6979(CurvePoint::ORDER, msgHash, r, s));
+}
+
+
+TEST(ecdsa, sign_batch) {
+	// Spans several chunks, with a partial last chunk
+	const size_t LEN = Ecdsa::SIGN_BATCH_CHUNK_LEN * 2 + 5;
+	const vector<TestSignature> sigs = makeTestSignatures(LEN);
+	Uint256 privateKeys[LEN];
+	vector<Sha256Hash> msgHashes;
+	for (size_t i = 0; i < LEN; i++) {
+		privateKeys[i] = sigs[i].privateKey;
+		msgHashes.push_back(sigs[i].msgHash);
+	}
+	
+	Uint256 r[LEN], s[LEN];
+	assert(Ecdsa::signBatch(privateKeys, msgHashes.data(), r, s, LEN));
+	for (size_t i = 0; i < LEN; i++)
+		assert(r[i] == sigs[i].r && s[i] == sigs[i].s);
+	assert(Ecdsa::signBatch(privateKeys, msgHashes.data(), r, s, 1));
+	assert(Ecdsa::signBatch(nullptr, nullptr, nullptr, nullptr, 0));
+}
+
+
 TEST(ecdsa, verify) {
 	struct VerifyCase {
 		bool answer;
@@ -13,9 +13,11 @@
 #include "gtest/gtest.h"
 
 #include "TestHelper.hpp"
+#include <cstddef>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include "ExtendedPrivateKey.hpp"
 #include "Uint256.hpp"
 
@@ -73,4 +75,26 @@ TEST(extended_private_key, child_keys) {
 	ASSERT_TRUE(child.privateKey == Uint256("A03A015E0936119558D022514AC8326B340FC69C3266442603A3C212004054E3"));
 }
 
+
+TEST(extended_private_key, batch_child_keys) {
+	const std::uint32_t HARDEN = ExtendedPrivateKey::HARDEN;
+	Uint256 priv("000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F");
+	Bytes chain = hexBytes("202122232425262728292A2B2C2D2E2F303132333435363738393A3B3C3D3E3F");
+	uint8_t ppkh[4] = {};
+	const ExtendedPrivateKey master(priv, chain.data(), 0, 0, ppkh);
+	
+	const std::uint32_t indices[] = {0, 1, 2, 1000, HARDEN | 0, HARDEN | 44, HARDEN | UINT32_C(0x7FFFFFFF)};
+	const std::size_t n = sizeof(indices) / sizeof(indices[0]);
+	ExtendedPrivateKey children[n];
+	master.getChildKeys(indices, n, children);
+	for (std::size_t i = 0; i < n; i++) {
+		const ExtendedPrivateKey expected = master.getChildKey(indices[i]);
+		ASSERT_TRUE(children[i].privateKey == expected.privateKey);
+		ASSERT_TRUE(std::memcmp(children[i].chainCode, expected.chainCode, sizeof(expected.chainCode)) == 0);
+		ASSERT_TRUE(std::memcmp(children[i].parentPubkeyHash, expected.parentPubkeyHash, sizeof(expected.parentPubkeyHash)) == 0);
+		ASSERT_TRUE(children[i].depth == 1 && children[i].index == indices[i]);
+	}
+	ASSERT_TRUE(children[5].privateKey == Uint256("EE1E0BD16BE7A49942867FB5E48470E25255F2E2AD0373D2D25DAE444786F096"));
+}
+
 #endif  // BCL_USE_EXTENDED_PRIVATEKEY
@@ -273,6 +273,41 @@ TEST(field_int, reciprocal) {
 }
 
 
+TEST(field_int, sqrt) {
+	const size_t CASE_SIZE = 6U;
+	const array<const char *, CASE_SIZE> squareCases{{
+		"0000000000000000000000000000000000000000000000000000000000000000",
+		"0000000000000000000000000000000000000000000000000000000000000001",
+		"0000000000000000000000000000000000000000000000000000000000000002",
+		"79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798",
+		"8000000000000000000000000000000000000000000000000000000000000000",
+		"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2E",
+	}};
+	const FieldInt zero("0000000000000000000000000000000000000000000000000000000000000000");
+	for (const char *tc : squareCases) {
+		// Square a number, then check that the root is that number or its negation
+		const FieldInt x(tc);
+		FieldInt negX = zero;
+		negX.subtract(x);
+		FieldInt y = x;
+		y.square();
+		assert(y.sqrt());
+		assert(y == x || y == negX);
+	}
+	
+	const array<const char *, 4> nonSquareCases{{
+		"0000000000000000000000000000000000000000000000000000000000000003",
+		"0000000000000000000000000000000000000000000000000000000000000005",
+		"0000000000000000000000000000000000000000000000000000000000000007",
+		"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2E",
+	}};
+	for (const char *tc : nonSquareCases) {
+		FieldInt x(tc);
+		assert(!x.sqrt());
+	}
+}
+
+
 TEST(field_int, constructor_uint256) {
 	const size_t CASE_SIZE = 7U;
 	const array<BinaryCase, CASE_SIZE> cases{{
@@ -11,11 +11,13 @@
 #include "gtest/gtest.h"
 
 #include "TestHelper.hpp"
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <vector>
 #include "Keccak256.hpp"
 
 
@@ -57,3 +59,127 @@ TEST(keccak, tests) {
 		assert((std::memcmp(actualHash, expectHash.data(), Keccak256::HASH_LEN) == 0) == tc.matches);
 	}
 }
+
+
+TEST(keccak, chunked_append) {
+	// Appending in pieces of any size, which may or may not fill a block, must give the one-shot hash
+	std::vector<std::uint8_t> data(600);
+	for (size_t i = 0; i < data.size(); i++)
+		data[i] = static_cast<std::uint8_t>(i * 13 + 5);
+	const size_t chunkLens[] = {1, 3, 7, 135, 136, 137, 272, 300};
+	for (size_t len = 0; len <= data.size(); len++) {
+		std::uint8_t expected[Keccak256::HASH_LEN];
+		Keccak256::getHash(data.data(), len, expected);
+		for (size_t chunkLen : chunkLens) {
+			Keccak256 hasher;
+			for (size_t off = 0; off < len; off += chunkLen)
+				hasher.append(&data[off], std::min(chunkLen, len - off));
+			std::uint8_t actual[Keccak256::HASH_LEN];
+			hasher.getHash(actual);
+			assert(std::memcmp(actual, expected, sizeof(expected)) == 0);
+		}
+	}
+}
+
+
+TEST(keccak, midstate) {
+	// A common prefix is absorbed once, then each suffix continues from a copy or from the exported midstate
+	std::vector<std::uint8_t> data(500);
+	for (size_t i = 0; i < data.size(); i++)
+		data[i] = static_cast<std::uint8_t>(i * 29 + 7);
+	for (size_t prefixLen : {0, 136, 272}) {
+		Keccak256 prefix;
+		prefix.append(data.data(), prefixLen);
+		std::uint64_t midstate[25];
+		assert(prefix.getMidstate(midstate));
+		for (size_t suffixLen : {0, 1, 135, 136, 200}) {
+			std::uint8_t expected[Keccak256::HASH_LEN];
+			Keccak256::getHash(data.data(), prefixLen + suffixLen, expected);
+			std::uint8_t actual[Keccak256::HASH_LEN];
+			Keccak256(midstate).append(&data[prefixLen], suffixLen).getHash(actual);
+			assert(std::memcmp(actual, expected, sizeof(expected)) == 0);
+			Keccak256 copy = prefix;
+			copy.append(&data[prefixLen], suffixLen).getHash(actual);
+			assert(std::memcmp(actual, expected, sizeof(expected)) == 0);
+		}
+	}
+	
+	// Part of a block is buffered in the state, so there is no midstate to export
+	Keccak256 partial;
+	partial.append(data.data(), 100);
+	std::uint64_t midstate[25] = {};
+	assert(!partial.getMidstate(midstate));
+	assert(midstate[0] == 0);
+}
+
+
+TEST(keccak, permutation) {
+	// Absorbing a block of zeros into the zero state applies Keccak-f[1600] to the zero state
+	const std::uint64_t expected[2][4] = {
+		{UINT64_C(0xF1258F7940E1DDE7), UINT64_C(0x84D5CCF933C0478A), UINT64_C(0xD598261EA65AA9EE), UINT64_C(0xBD1547306F80494D)},
+		{UINT64_C(0x2D5C954DF96ECB3C), UINT64_C(0x6A332CD07057B56D), UINT64_C(0x093D8D1270D76B6C), UINT64_C(0x8A20D9B25569D094)},
+	};
+	const std::uint8_t zeros[Keccak256::BLOCK_SIZE] = {};
+	Keccak256 hasher;
+	for (const std::uint64_t (&lanes)[4] : expected) {
+		hasher.append(zeros, sizeof(zeros));
+		std::uint64_t midstate[25];
+		assert(hasher.getMidstate(midstate));
+		for (int i = 0; i < 4; i++)
+			assert(midstate[i] == lanes[i]);
+	}
+}
+
+
+TEST(keccak, get_hashes) {
+	forEachMixedBatch(40, 300, [](const std::uint8_t *const msgs[], const size_t lens[], size_t n) {
+		Bytes hashes(n * Keccak256::HASH_LEN);
+		std::uint8_t (*out)[Keccak256::HASH_LEN] = reinterpret_cast<std::uint8_t (*)[Keccak256::HASH_LEN]>(hashes.data());
+		Keccak256::getHashes(msgs, lens, n, out);
+		for (size_t i = 0; i < n; i++) {
+			std::uint8_t expected[Keccak256::HASH_LEN];
+			Keccak256::getHash(msgs[i], lens[i], expected);
+			assert(std::memcmp(out[i], expected, sizeof(expected)) == 0);
+		}
+	});
+	
+	// Each output may overwrite its own message, e.g. for iterating a hash
+	std::uint8_t chains[8][Keccak256::HASH_LEN] = {};
+	std::uint8_t expected[8][Keccak256::HASH_LEN] = {};
+	const std::uint8_t *msgs[8];
+	size_t lens[8];
+	for (int i = 0; i < 8; i++) {
+		chains[i][0] = static_cast<std::uint8_t>(i);
+		expected[i][0] = static_cast<std::uint8_t>(i);
+		msgs[i] = chains[i];
+		lens[i] = sizeof(chains[i]);
+	}
+	for (int k = 0; k < 3; k++) {
+		Keccak256::getHashes(msgs, lens, 8, chains);
+		for (int i = 0; i < 8; i++)
+			Keccak256::getHash(expected[i], sizeof(expected[i]), expected[i]);
+	}
+	assert(std::memcmp(chains, expected, sizeof(chains)) == 0);
+}
+
+
+TEST(keccak, get_hashes_in_lanes) {
+	// Each kernel that this CPU has, even where getHashes() prefers another one
+	for (size_t lanes : {8, 4}) {
+		forEachMixedBatch(40, 300, [lanes](const std::uint8_t *const msgs[], const size_t lens[], size_t n) {
+			Bytes hashes(n * Keccak256::HASH_LEN);
+			std::uint8_t (*out)[Keccak256::HASH_LEN] = reinterpret_cast<std::uint8_t (*)[Keccak256::HASH_LEN]>(hashes.data());
+			if (!Keccak256::getHashesInLanes(msgs, lens, n, out, lanes))
+				return;
+			for (size_t i = 0; i < n; i++) {
+				std::uint8_t expected[Keccak256::HASH_LEN];
+				Keccak256::getHash(msgs[i], lens[i], expected);
+				assert(std::memcmp(out[i], expected, sizeof(expected)) == 0);
+			}
+		});
+	}
+	std::uint8_t out[1][Keccak256::HASH_LEN];
+	const std::uint8_t *msgs[1] = {out[0]};
+	const size_t lens[1] = {0};
+	assert(!Keccak256::getHashesInLanes(msgs, lens, 1, out, 3));
+}
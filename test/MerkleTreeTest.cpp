@@ -0,0 +1,121 @@
+/* 
+ * A runnable main program that tests the functionality of class MerkleTree.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "gtest/gtest.h"
+
+#include "TestHelper.hpp"
+#include <cstdint>
+#include <cstring>
+#include "MerkleTree.hpp"
+#include "Sha256.hpp"
+#include "Sha256Hash.hpp"
+
+
+using namespace bcl;
+using std::uint8_t;
+
+
+/*---- Helper functions ----*/
+
+// Leaf i is SHA256 of i as 4 little-endian bytes. The benchmark uses the same leaves.
+static vector<Sha256Hash> makeLeaves(size_t len) {
+	vector<Sha256Hash> result;
+	for (size_t i = 0; i < len; i++) {
+		const uint8_t seed[4] = {static_cast<uint8_t>(i), static_cast<uint8_t>(i >> 8), static_cast<uint8_t>(i >> 16), static_cast<uint8_t>(i >> 24)};
+		result.push_back(Sha256::getHash(seed, sizeof(seed)));
+	}
+	return result;
+}
+
+
+// The straightforward definition, using getDoubleHash() and a copy of each level.
+static Sha256Hash naiveRoot(vector<Sha256Hash> level) {
+	while (level.size() > 1) {
+		if (level.size() % 2 == 1)
+			level.push_back(level.back());
+		vector<Sha256Hash> next;
+		for (size_t i = 0; i < level.size(); i += 2) {
+			uint8_t pair[64];
+			std::memcpy(&pair[0], level[i].value, 32);
+			std::memcpy(&pair[32], level[i + 1].value, 32);
+			next.push_back(Sha256::getDoubleHash(pair, sizeof(pair)));
+		}
+		level = next;
+	}
+	return level[0];
+}
+
+
+/*---- Test cases ----*/
+
+TEST(merkle_tree, block_100000) {
+	vector<Sha256Hash> txids{
+		Sha256Hash("8C14F0DB3DF150123E6F3DBBF30F8B955A8249B62AC1D1FF16284AEFA3D06D87"),
+		Sha256Hash("FFF2525B8931402DD09222C50775608F75787BD2B87E56995A7BDD30F79702C4"),
+		Sha256Hash("6359F0868171B1D194CBEE1AF2F16EA598AE8FAD666D9B012C8ED2B79A236EC4"),
+		Sha256Hash("E9A66845E05D5ABC0AD04EC80F774A7E585C6E8DB975962D069A522137B80C1D"),
+	};
+	assert(MerkleTree::computeRoot(txids.data(), txids.size()) == Sha256Hash("F3E94742ACA4B5EF85488DC37C06C3282295FFEC960994B2C0D5AC2A25A95766"));
+}
+
+
+TEST(merkle_tree, compute_root) {
+	for (size_t len = 1; len <= 70; len++) {
+		vector<Sha256Hash> leaves = makeLeaves(len);
+		const Sha256Hash expected = naiveRoot(leaves);
+		assert(MerkleTree::computeRoot(leaves.data(), len) == expected);
+	}
+
+#if defined(BCL_USE_THREADS)
+	// Large enough that the lowest levels are split among threads, with odd lengths along the way
+	const size_t len = MerkleTree::MIN_PAIRS_PER_THREAD * 6 + 5;
+	const vector<Sha256Hash> leaves = makeLeaves(len);
+	const Sha256Hash expected = naiveRoot(leaves);
+	for (size_t threads : {1, 2, 3, 4}) {
+		vector<Sha256Hash> temp = leaves;
+		assert(MerkleTree::computeRoot(temp.data(), len, threads) == expected);
+	}
+#endif
+}
+
+
+TEST(merkle_tree, branches) {
+	assert(MerkleTree::getBranchLen(1) == 0);
+	assert(MerkleTree::getBranchLen(2) == 1);
+	assert(MerkleTree::getBranchLen(3) == 2);
+	assert(MerkleTree::getBranchLen(4) == 2);
+	assert(MerkleTree::getBranchLen(5) == 3);
+	
+	for (size_t len = 1; len <= 40; len++) {
+		const vector<Sha256Hash> leaves = makeLeaves(len);
+		const size_t branchLen = MerkleTree::getBranchLen(len);
+		vector<size_t> indices;
+		for (size_t i = 0; i < len; i++)
+			indices.push_back(i);
+		vector<Sha256Hash> branches(len * branchLen, leaves[0]);
+		vector<Sha256Hash> temp = leaves;
+		const Sha256Hash root = MerkleTree::computeBranches(temp.data(), len, indices.data(), len, branches.data());
+		assert(root == naiveRoot(leaves));
+		
+		for (size_t i = 0; i < len; i++)
+			assert(MerkleTree::computeRootFromBranch(leaves[i], i, branches.data() + i * branchLen, branchLen) == root);
+		bool results[40];
+		assert(MerkleTree::verifyBranches(leaves.data(), indices.data(), branches.data(), branchLen, len, root, results));
+		
+		// Corrupt one branch hash, and claim a wrong index for another leaf
+		if (len >= 3) {
+			branches[1 * branchLen].value[0] ^= 1;
+			indices[2] = 0;
+			assert(!MerkleTree::verifyBranches(leaves.data(), indices.data(), branches.data(), branchLen, len, root, results));
+			for (size_t i = 0; i < len; i++)
+				assert(results[i] == (i != 1 && i != 2));
+		}
+	}
+}
@@ -0,0 +1,93 @@
+/* 
+ * A runnable main program that tests the functionality of class NoncePool.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#if defined(BCL_USE_THREADS)
+
+#include "gtest/gtest.h"
+
+#include "TestHelper.hpp"
+#include <cstdint>
+#include <thread>
+#include "CurvePoint.hpp"
+#include "Ecdsa.hpp"
+#include "NoncePool.hpp"
+#include "Sha256Hash.hpp"
+#include "Uint256.hpp"
+
+
+using namespace bcl;
+using std::uint8_t;
+
+
+static const uint8_t SEED[32] = {0x37, 0x4E, 0x91};
+static const char *PRIVATE_KEY = "8B46893E711C8948B28E7637BFBED61666E0118ED4D361BED1F18058214C69B8";
+static const char *MSG_HASH = "B8EF4E4640FBBD526166FF260EB65EC2B3B60064CCE2DA9747201BA201E90F7F";
+
+
+/*---- Test cases ----*/
+
+TEST(nonce_pool, sign) {
+	const Uint256 privateKey(PRIVATE_KEY);
+	const Sha256Hash msgHash(MSG_HASH);
+	const CurvePoint publicKey = CurvePoint::privateExponentToPublicPoint(privateKey);
+	
+	for (size_t threads : {0, 1, 3}) {
+		NoncePool pool(4, threads, SEED);
+		if (threads > 0) {
+			pool.waitUntilFull();
+			assert(pool.getSize() == 4);
+		}
+		// Each signature uses a new nonce, whether precomputed or not
+		vector<Uint256> rs;
+		for (int i = 0; i < 10; i++) {
+			Uint256 r, s;
+			uint8_t recId;
+			assert(pool.sign(privateKey, msgHash, r, s, recId));
+			assert(Ecdsa::verify(publicKey, msgHash, r, s));
+			CurvePoint recovered = CurvePoint::ZERO;
+			assert(Ecdsa::recoverPublicKey(msgHash, r, s, recId, recovered) && recovered == publicKey);
+			for (const Uint256 &other : rs)
+				assert(r != other);
+			rs.push_back(r);
+		}
+		Uint256 r, s;
+		uint8_t recId;
+		assert(!pool.sign(Uint256::ZERO, msgHash, r, s, recId));
+		assert(!pool.sign(CurvePoint::ORDER, msgHash, r, s, recId));
+	}
+}
+
+
+TEST(nonce_pool, concurrent) {
+	const Uint256 privateKey(PRIVATE_KEY);
+	const Sha256Hash msgHash(MSG_HASH);
+	const CurvePoint publicKey = CurvePoint::privateExponentToPublicPoint(privateKey);
+	NoncePool pool(3, 2, SEED);
+	vector<Uint256> rs(4 * 5);
+	vector<std::thread> threads;
+	for (size_t i = 0; i < 4; i++) {
+		threads.emplace_back([&, i]() {
+			for (size_t j = 0; j < 5; j++) {
+				Uint256 s;
+				uint8_t recId;
+				assert(pool.sign(privateKey, msgHash, rs[i * 5 + j], s, recId));
+				assert(Ecdsa::verify(publicKey, msgHash, rs[i * 5 + j], s));
+			}
+		});
+	}
+	for (std::thread &th : threads)
+		th.join();
+	for (size_t i = 0; i < rs.size(); i++) {
+		for (size_t j = 0; j < i; j++)
+			assert(rs[i] != rs[j]);
+	}
+}
+
+#endif  // BCL_USE_THREADS
@@ -0,0 +1,66 @@
+/* 
+ * A runnable main program that tests the functionality of class Rfc6979.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "gtest/gtest.h"
+
+#include "TestHelper.hpp"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include "Rfc6979.hpp"
+#include "Sha256.hpp"
+#include "Sha256Hash.hpp"
+#include "Uint256.hpp"
+
+
+using namespace bcl;
+using std::uint8_t;
+
+
+/*---- Test cases ----*/
+
+TEST(rfc6979, next) {
+	struct NonceCase {
+		const char *privateKey;
+		const char *message;  // ASCII, hashed with SHA-256
+		const char *nonce;
+		const char *retryNonce;
+	};
+	const size_t CASE_SIZE = 5U;
+	const array<NonceCase, CASE_SIZE> cases{{
+		{"0000000000000000000000000000000000000000000000000000000000000001", "Satoshi Nakamoto", "8F8A276C19F4149656B280621E358CCE24F5F52542772691EE69063B74F15D15", "F15FB763A6BCBBACBDE0A6A9AE2A02482BD92F3E75A50B357BD551DDD771045E"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "Satoshi Nakamoto", "33A19B60E25FB6F4435AF53A3D42D493644827367E6453928554F43E49AA6F90", "635653806D2B851EDB5EB4A3E0098AD6DF9CF16447DC19530C33854E78A5C964"},
+		{"0000000000000000000000000000000000000000000000000000000000000001", "All those moments will be lost in time, like tears in rain. Time to die...", "38AA22D72376B4DBC472E06C3BA403EE0A394DA63FC58D88686C611ABA98D6B3", "DC5417A2ADA98871B9EE7DB9E12E62E7283F6FC0E18A1C1B161E7E75A64034BA"},
+		{"F8B8AF8CE3C7CCA5E300D33939540C10D45CE001B8F252BFBC57BA0342904181", "Alan Turing", "525A82B70E67874398067543FD84C83D30C175FDC45FDEEE082FE13B1D7CFDF1", "7FD11AA3DB66AD20C832D3DF288D33982ACA50B1CD436880B44D839819087A84"},
+		{"E91671C46231F833A6406CCBEA0E3E392C76C167BAC1CB013F6F1013980455C2", "There is a computer disease that anybody who works with computers knows about. It's a very serious disease and it interferes completely with the work. The trouble with computers is that you 'play' with them!", "1F4B84C23A86A221D233F2521BE018D9318639D5B8BBD6374A8A59232D16AD3D", "612AEDE6745CF5DD1CCB89DA21665A8A7CFDF086CF724654A095701EB5C6C4AF"},
+	}};
+	
+	for (const NonceCase &tc : cases) {
+		const Bytes msg = asciiBytes(tc.message);
+		Rfc6979 generator(Uint256(tc.privateKey), Sha256::getHash(msg.data(), msg.size()));
+		assert(generator.next() == Uint256(tc.nonce));
+		assert(generator.next() == Uint256(tc.retryNonce));
+	}
+}
+
+
+TEST(rfc6979, extra_entropy) {
+	const Bytes msg = asciiBytes("Satoshi Nakamoto");
+	const Sha256Hash msgHash = Sha256::getHash(msg.data(), msg.size());
+	uint8_t extra[32];
+	for (int i = 0; i < 32; i++)
+		extra[i] = static_cast<uint8_t>(i);
+	Rfc6979 generator(Uint256::ONE, msgHash, extra, sizeof(extra));
+	assert(generator.next() == Uint256("3262BA5FEAF7C959D799F4CB84BD85935DE97B31D77309647A4232E07E2BECDB"));
+	
+	// No extra entropy is the same as an empty array
+	Rfc6979 plain(Uint256::ONE, msgHash, extra, 0);
+	assert(plain.next() == Uint256("8F8A276C19F4149656B280621E358CCE24F5F52542772691EE69063B74F15D15"));
+}
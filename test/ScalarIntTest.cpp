@@ -0,0 +1,144 @@
+/* 
+ * A runnable main program that tests the functionality of class ScalarInt.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "gtest/gtest.h"
+
+#include "TestHelper.hpp"
+#include <array>
+#include "ScalarInt.hpp"
+#include "Uint256.hpp"
+
+
+using namespace bcl;
+
+
+/*---- Structures ----*/
+
+struct BinaryCase {
+	const char *x;
+	const char *y;
+};
+
+struct TernaryCase {
+	const char *x;
+	const char *y;
+	const char *z;
+};
+
+
+/*---- Test cases ----*/
+
+TEST(scalar_int, constructor_uint256) {
+	const size_t CASE_SIZE = 5U;
+	const array<BinaryCase, CASE_SIZE> cases{{
+		{"0000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000000000"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141", "0000000000000000000000000000000000000000000000000000000000000000"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364143", "0000000000000000000000000000000000000000000000000000000000000002"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF", "000000000000000000000000000000014551231950B75FC4402DA1732FC9BEBE"},
+	}};
+	for (const BinaryCase &tc : cases) {
+		assert(ScalarInt(Uint256(tc.x)) == ScalarInt(tc.y));
+	}
+}
+
+
+TEST(scalar_int, add_subtract_negate) {
+	const ScalarInt zero("0000000000000000000000000000000000000000000000000000000000000000");
+	const ScalarInt one ("0000000000000000000000000000000000000000000000000000000000000001");
+	const ScalarInt max ("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140");
+	ScalarInt x = max;
+	x.add(one);
+	assert(x == zero);
+	x.subtract(one);
+	assert(x == max);
+	x.add(max);
+	assert(x == ScalarInt("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD036413F"));
+	
+	x = one;
+	x.negate();
+	assert(x == max);
+	x = zero;
+	x.negate();
+	assert(x == zero);
+}
+
+
+TEST(scalar_int, multiply) {
+	const size_t CASE_SIZE = 11U;
+	const array<TernaryCase, CASE_SIZE> cases{{
+		{"0000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000000000"},
+		{"0000000000000000000000000000000000000000000000000000000000000001", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "0000000000000000000000000000000000000000000000000000000000000001"},
+		{"8000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000000002", "000000000000000000000000000000014551231950B75FC4402DA1732FC9BEBF"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD036413F", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD036413F", "0000000000000000000000000000000000000000000000000000000000000004"},
+		{"3A448D5241AAC64231D6BC8B2207EF8952F513567D19495C2A1A87620B271710", "D10E39886D684E61E1026DF428B78DF842D3B0354D2752E525C93FA57AF9D7A3", "8CCA1570634348BDFFD730F2FB368EFE3E3E705BC29446F1980BA98DF3674E5B"},
+		{"24F6D0B831DDE35191CDB2828AF0351DF50752B62632A1EF94064E85A7A3083E", "968BB1B0021C5CC7288F465CBFCE60143E018ACEE5880AF2CBFBD74B0EFB1F3D", "8C51B2F2B6E194CE2437979327EE31E2ABF951970D247A3F3C5E3D443E1B0C1A"},
+		{"2CE8FE421AA4E91A449A5D838592A8E36D1CFBCC274F14857C5E7116341DCF5C", "6BBFBE4DDE3AA1ECFAFF6AAAF8608FD3F28A92FAD403715500953F0D79341AA2", "652BB5000633975EC5406270150FE3EA348EBE444554D29D757C03C6E637A817"},
+		{"3E251BAC7486BE9F590FC0B02663CD08D4A355DF11F045F3E4D9E89A57C4F9B0", "DD65A8F1D9E8FDF58925CF22EA71EBDFA417555BF841A09CE70A31F7F453A916", "95A04FB9C75D35426A558CEC4120FB6B135537EDC119EE5428D376D854FDE4CE"},
+		{"DE1C4E740E170E7FEBE26D2ECC57C1906C49A9DCF4F047C80CF4A6A75F2EB001", "721EEEE265A84B57783C21DBC86B4A9614E427A97EC62CD7B1668BCBB373651E", "BDBE982A8F54967B085200646B2176C57F1615646C994CEFFC1AFDF4D3E05D11"},
+		{"BCE787476A97F78C2E901F8A6914593E225A80E522C38C3C0B11FECC1DD492E0", "3E9E470E8866FE2D983020D9F65A370B34672936672297B0AC137EF355E8CCF8", "4AB98B8592504D12BE7ABF3B49ECEA6C3E18D04415CB0DCE5F3A7BEE457BE568"},
+	}};
+	for (const TernaryCase &tc : cases) {
+		ScalarInt x(tc.x);
+		x.multiply(ScalarInt(tc.y));
+		assert(x == ScalarInt(tc.z));
+	}
+}
+
+
+TEST(scalar_int, reciprocal) {
+	const size_t CASE_SIZE = 7U;
+	const array<BinaryCase, CASE_SIZE> cases{{
+		{"0000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000000000"},  // Special value
+		{"0000000000000000000000000000000000000000000000000000000000000001", "0000000000000000000000000000000000000000000000000000000000000001"},
+		{"0000000000000000000000000000000000000000000000000000000000000002", "7FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF5D576E7357A4501DDFE92F46681B20A1"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140"},
+		{"CC3EC0C64B37D054278E5A2853447293D469F71C424103F911F199FBE897EF79", "565FA3D4F298C933477BF01F0A0499591795844E4F02052E41297C9C3508111A"},
+		{"2E7CAAF8FB65E0F808EE061906192DE0E5272D916357A26906901505C4107F1D", "20C3AD3F099725AB8ACE28859518CD2BC8092675CAF59C71872004613C0A0973"},
+		{"A64222311E3FBF5636771B6374ED8F181714D8680A99609EDE1C57456DFA320F", "10EE380A13336CF07F3FB326265B277F198C10BC7B339A93BB3A5C1422EB675C"},
+	}};
+	for (const BinaryCase &tc : cases) {
+		ScalarInt x(tc.x);
+		x.reciprocal();
+		assert(x == ScalarInt(tc.y));
+	}
+}
+
+
+TEST(scalar_int, split_lambda) {
+	const size_t CASE_SIZE = 6U;
+	const array<const char *, CASE_SIZE> cases{{
+		"0000000000000000000000000000000000000000000000000000000000000000",
+		"0000000000000000000000000000000000000000000000000000000000000001",
+		"5363AD4CC05C30E0A5261C028812645A122E22EA20816678DF02967C1B23BD72",
+		"7FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF5D576E7357A4501DDFE92F46681B20A0",
+		"C7D9B8F8E1A2E98A1B28E76F2B6D2F5A9B6D1F0E3C2B4A59687766554433221F",
+		"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140",
+	}};
+	const ScalarInt lambda("5363AD4CC05C30E0A5261C028812645A122E22EA20816678DF02967C1B23BD72");
+	const Uint256 bound("0000000000000000000000000000000100000000000000000000000000000000");  // 2^128
+	for (const char *tc : cases) {
+		const ScalarInt k(tc);
+		ScalarInt r1(Uint256::ZERO);
+		ScalarInt r2(Uint256::ZERO);
+		k.splitLambda(r1, r2);
+		
+		ScalarInt sum = r2;
+		sum.multiply(lambda);
+		sum.add(r1);
+		assert(sum == k);
+		for (ScalarInt r : {r1, r2}) {
+			ScalarInt negR = r;
+			negR.negate();
+			assert(Uint256(r) < bound || Uint256(negR) < bound);
+		}
+	}
+}
@@ -0,0 +1,139 @@
+/* 
+ * A runnable main program that tests the functionality of class Schnorr.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "gtest/gtest.h"
+
+#include "TestHelper.hpp"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include "AffinePoint.hpp"
+#include "CurvePoint.hpp"
+#include "Schnorr.hpp"
+#include "Uint256.hpp"
+
+
+using namespace bcl;
+using std::uint8_t;
+
+
+/*---- Structures ----*/
+
+// One row of the BIP 340 test vectors. The private key and auxiliary data are null for verification-only rows.
+struct TestVector {
+	const char *privateKey;
+	const char *publicKey;
+	const char *auxRand;
+	const char *msg;
+	const char *sig;
+	bool valid;
+};
+
+
+/*---- Test vectors ----*/
+
+// Vectors 0 to 3 of BIP 340 (test-vectors.csv), which have a private key for signing
+static const array<TestVector, 4> SIGN_VECTORS{{
+	{"0000000000000000000000000000000000000000000000000000000000000003", "F9308A019258C31049344F85F89D5229B531C845836F99B08601F113BCE036F9", "0000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000000000", "E907831F80848D1069A5371B402410364BDF1C5F8307B0084C55F1CE2DCA821525F66A4A85EA8B71E482A74F382D2CE5EBEEE8FDB2172F477DF4900D310536C0", true},
+	{"B7E151628AED2A6ABF7158809CF4F3C762E7160F38B4DA56A784D9045190CFEF", "DFF1D77F2A671C5F36183726DB2341BE58FEAE1DA2DECED843240F7B502BA659", "0000000000000000000000000000000000000000000000000000000000000001", "243F6A8885A308D313198A2E03707344A4093822299F31D0082EFA98EC4E6C89", "6896BD60EEAE296DB48A229FF71DFE071BDE413E6D43F917DC8DCF8C78DE33418906D11AC976ABCCB20B091292BFF4EA897EFCB639EA871CFA95F6DE339E4B0A", true},
+	{"C90FDAA22168C234C4C6628B80DC1CD129024E088A67CC74020BBEA63B14E5C9", "DD308AFEC5777E13121FA72B9CC1B7CC0139715309B086C960E18FD969774EB8", "C87AA53824B4D7AE2EB035A2B5BBBCCC080E76CDC6D1692C4B0B62D798E6D906", "7E2D58D8B3BCDF1ABADEC7829054F90DDA9805AAB56C77333024B9D0A508B75C", "5831AAEED7B44BB74E5EAB94BA9D4294C49BCF2A60728D8B4C200F50DD313C1BAB745879A5AD954A72C45A91C3A51D3C7ADEA98D82F8481E0E1E03674A6F3FB7", true},
+	{"0B432B2677937381AEF05BB02A66ECD012773062CF3FA2549E44F58ED2401710", "25D1DFF95105F5253C4022F628A996AD3A0D95FBF21D468A1B33F8C160D8F517", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF", "7EB0509757E246F19449885651611CB965ECC1A187DD51B64FDA1EDC9637D5EC97582B9CB13DB3933705B32BA982AF5AF25FD78881EBB32771FC5922EFC66EA3", true},  // Fails if msg is reduced modulo p or n
+}};
+
+// Vectors 4 to 14 of BIP 340, which only have a public key and the expected verification result
+static const array<TestVector, 11> VERIFY_VECTORS{{
+	{nullptr, "D69C3509BB99E412E68B0FE8544E72837DFA30746D8BE2AA65975F29D22DC7B9", nullptr, "4DF3C3F68FCC83B27E9D42C90431A72499F17875C81A599B566C9889B9696703", "00000000000000000000003B78CE563F89A0ED9414F5AA28AD0D96D6795F9C6376AFB1548AF603B3EB45C9F8207DEE1060CB71C04E80F593060B07D28308D7F4", true},
+	{nullptr, "EEFDEA4CDB677750A420FEE807EACF21EB9898AE79B9768766E4FAA04A2D4A34", nullptr, "243F6A8885A308D313198A2E03707344A4093822299F31D0082EFA98EC4E6C89", "6CFF5C3BA86C69EA4B7376F31A9BCB4F74C1976089B2D9963DA2E5543E17776969E89B4C5564D00349106B8497785DD7D1D713A8AE82B32FA79D5F7FC407D39B", false},  // Public key not on the curve
+	{nullptr, "DFF1D77F2A671C5F36183726DB2341BE58FEAE1DA2DECED843240F7B502BA659", nullptr, "243F6A8885A308D313198A2E03707344A4093822299F31D0082EFA98EC4E6C89", "FFF97BD5755EEEA420453A14355235D382F6472F8568A18B2F057A14602975563CC27944640AC607CD107AE10923D9EF7A73C643E166BE5EBEAFA34B1AC553E2", false},  // has_even_y(R) is false
+	{nullptr, "DFF1D77F2A671C5F36183726DB2341BE58FEAE1DA2DECED843240F7B502BA659", nullptr, "243F6A8885A308D313198A2E03707344A4093822299F31D0082EFA98EC4E6C89", "1FA62E331EDBC21C394792D2AB1100A7B432B013DF3F6FF4F99FCB33E0E1515F28890B3EDB6E7189B630448B515CE4F8622A954CFE545735AAEA5134FCCDB2BD", false},  // Negated message
+	{nullptr, "DFF1D77F2A671C5F36183726DB2341BE58FEAE1DA2DECED843240F7B502BA659", nullptr, "243F6A8885A308D313198A2E03707344A4093822299F31D0082EFA98EC4E6C89", "6CFF5C3BA86C69EA4B7376F31A9BCB4F74C1976089B2D9963DA2E5543E177769961764B3AA9B2FFCB6EF947B6887A226E8D7C93E00C5ED0C1834FF0D0C2E6DA6", false},  // Negated s value
+	{nullptr, "DFF1D77F2A671C5F36183726DB2341BE58FEAE1DA2DECED843240F7B502BA659", nullptr, "243F6A8885A308D313198A2E03707344A4093822299F31D0082EFA98EC4E6C89", "0000000000000000000000000000000000000000000000000000000000000000123DDA8328AF9C23A94C1FEECFD123BA4FB73476F0D594DCB65C6425BD186051", false},  // s * G - e * P is infinite, with x(inf) taken as 0
+	{nullptr, "DFF1D77F2A671C5F36183726DB2341BE58FEAE1DA2DECED843240F7B502BA659", nullptr, "243F6A8885A308D313198A2E03707344A4093822299F31D0082EFA98EC4E6C89", "00000000000000000000000000000000000000000000000000000000000000017615FBAF5AE28864013C099742DEADB4DBA87F11AC6754F93780D5A1837CF197", false},  // s * G - e * P is infinite, with x(inf) taken as 1
+	{nullptr, "DFF1D77F2A671C5F36183726DB2341BE58FEAE1DA2DECED843240F7B502BA659", nullptr, "243F6A8885A308D313198A2E03707344A4093822299F31D0082EFA98EC4E6C89", "4A298DACAE57395A15D0795DDBFD1DCB564DA82B0F269BC70A74F8220429BA1D69E89B4C5564D00349106B8497785DD7D1D713A8AE82B32FA79D5F7FC407D39B", false},  // r is not an x-coordinate on the curve
+	{nullptr, "DFF1D77F2A671C5F36183726DB2341BE58FEAE1DA2DECED843240F7B502BA659", nullptr, "243F6A8885A308D313198A2E03707344A4093822299F31D0082EFA98EC4E6C89", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F69E89B4C5564D00349106B8497785DD7D1D713A8AE82B32FA79D5F7FC407D39B", false},  // r is equal to the field size
+	{nullptr, "DFF1D77F2A671C5F36183726DB2341BE58FEAE1DA2DECED843240F7B502BA659", nullptr, "243F6A8885A308D313198A2E03707344A4093822299F31D0082EFA98EC4E6C89", "6CFF5C3BA86C69EA4B7376F31A9BCB4F74C1976089B2D9963DA2E5543E177769FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141", false},  // s is equal to the curve order
+	{nullptr, "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC30", nullptr, "243F6A8885A308D313198A2E03707344A4093822299F31D0082EFA98EC4E6C89", "6CFF5C3BA86C69EA4B7376F31A9BCB4F74C1976089B2D9963DA2E5543E17776969E89B4C5564D00349106B8497785DD7D1D713A8AE82B32FA79D5F7FC407D39B", false},  // Public key exceeds the field size
+}};
+
+
+/*---- Test cases ----*/
+
+TEST(schnorr, sign) {
+	for (const TestVector &tc : SIGN_VECTORS) {
+		const Uint256 privateKey(tc.privateKey);
+		AffinePoint publicKey(CurvePoint::privateExponentToPublicPoint(privateKey));
+		uint8_t xOnly[32];
+		publicKey.toXOnly(xOnly);
+		assert(Bytes(xOnly, xOnly + 32) == hexBytes(tc.publicKey));
+		
+		uint8_t sig[64];
+		assert(Schnorr::sign(privateKey, hexBytes(tc.msg).data(), hexBytes(tc.auxRand).data(), sig));
+		assert(Bytes(sig, sig + 64) == hexBytes(tc.sig));
+	}
+	
+	uint8_t sig[64];
+	const Bytes zeros(32, 0);
+	assert(!Schnorr::sign(Uint256::ZERO, zeros.data(), zeros.data(), sig));
+	assert(!Schnorr::sign(CurvePoint::ORDER, zeros.data(), zeros.data(), sig));
+}
+
+
+TEST(schnorr, verify) {
+	for (const TestVector &tc : SIGN_VECTORS)
+		assert(Schnorr::verify(hexBytes(tc.publicKey).data(), hexBytes(tc.msg).data(), hexBytes(tc.sig).data()));
+	for (const TestVector &tc : VERIFY_VECTORS)
+		assert(Schnorr::verify(hexBytes(tc.publicKey).data(), hexBytes(tc.msg).data(), hexBytes(tc.sig).data()) == tc.valid);
+}
+
+
+TEST(schnorr, verify_batch) {
+	// Sign enough messages to span several chunks
+	const size_t BATCH_SIZE = 11U;
+	uint8_t publicKeys[BATCH_SIZE][32];
+	uint8_t msgs[BATCH_SIZE][32];
+	uint8_t sigs[BATCH_SIZE][64];
+	for (size_t i = 0; i < BATCH_SIZE; i++) {
+		const TestVector &tc = SIGN_VECTORS[i % SIGN_VECTORS.size()];
+		std::memcpy(publicKeys[i], hexBytes(tc.publicKey).data(), 32);
+		std::memcpy(msgs[i], hexBytes(tc.msg).data(), 32);
+		msgs[i][31] ^= static_cast<uint8_t>(i);
+		const Bytes auxRand = hexBytes(tc.auxRand);
+		assert(Schnorr::sign(Uint256(tc.privateKey), msgs[i], auxRand.data(), sigs[i]));
+	}
+	assert(Schnorr::verifyBatch(publicKeys, msgs, sigs, BATCH_SIZE));
+	assert(Schnorr::verifyBatch(publicKeys, msgs, sigs, 1));
+	assert(Schnorr::verifyBatch(publicKeys, msgs, sigs, 0));
+	
+	// Substitute each invalid vector at the start, middle, and end of the batch
+	for (const TestVector &tc : VERIFY_VECTORS) {
+		if (tc.valid)
+			continue;
+		for (size_t i : {static_cast<size_t>(0), BATCH_SIZE / 2, BATCH_SIZE - 1}) {
+			uint8_t badPublicKeys[BATCH_SIZE][32];
+			uint8_t badMsgs[BATCH_SIZE][32];
+			uint8_t badSigs[BATCH_SIZE][64];
+			std::memcpy(badPublicKeys, publicKeys, sizeof(publicKeys));
+			std::memcpy(badMsgs, msgs, sizeof(msgs));
+			std::memcpy(badSigs, sigs, sizeof(sigs));
+			std::memcpy(badPublicKeys[i], hexBytes(tc.publicKey).data(), 32);
+			std::memcpy(badMsgs[i], hexBytes(tc.msg).data(), 32);
+			std::memcpy(badSigs[i], hexBytes(tc.sig).data(), 64);
+			assert(!Schnorr::verifyBatch(badPublicKeys, badMsgs, badSigs, BATCH_SIZE));
+		}
+	}
+	
+	// Two invalid signatures whose errors would cancel out without the random coefficients
+	uint8_t swappedSigs[BATCH_SIZE][64];
+	std::memcpy(swappedSigs, sigs, sizeof(sigs));
+	std::memcpy(&swappedSigs[1][32], &sigs[2][32], 32);
+	std::memcpy(&swappedSigs[2][32], &sigs[1][32], 32);
+	assert(!Schnorr::verify(publicKeys[1], msgs[1], swappedSigs[1]));
+	assert(!Schnorr::verifyBatch(publicKeys, msgs, swappedSigs, BATCH_SIZE));
+}
@@ -11,12 +11,14 @@
 #include "gtest/gtest.h"
 
 #include "TestHelper.hpp"
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <vector>
+#include "HmacSha256.hpp"
 #include "Sha256.hpp"
 #include "Sha256Hash.hpp"
 
@@ -239,6 +241,26 @@ TEST(sha256, hmac) {
 }
 
 
+TEST(sha256, hmac_context) {
+	// One context must give the one-shot HMAC for every message and key length, including a message in pieces
+	std::vector<std::uint8_t> data(300);
+	for (size_t i = 0; i < data.size(); i++)
+		data[i] = static_cast<std::uint8_t>(i * 29 + 7);
+	for (size_t keyLen : {0, 1, 32, 64, 65, 100}) {
+		const HmacSha256 hmac(data.data(), keyLen);
+		const HmacSha256 copy = hmac;
+		for (size_t msgLen : {0, 1, 32, 55, 56, 64, 200}) {
+			const Sha256Hash expected = Sha256::getHmac(data.data(), keyLen, &data[100], msgLen);
+			assert(hmac.getHmac(&data[100], msgLen) == expected);
+			assert(copy.getHmac(&data[100], msgLen) == expected);
+			Sha256 hasher = hmac.getInnerHasher();
+			hasher.append(&data[100], msgLen / 3).append(&data[100 + msgLen / 3], msgLen - msgLen / 3);
+			assert(hmac.finish(hasher) == expected);
+		}
+	}
+}
+
+
 static void ap(Sha256 &hasher, const char *msg) {
 	std::vector<std::uint8_t> temp(msg, msg + std::strlen(msg));
 	hasher.append(temp.data(), temp.size());
@@ -253,3 +275,145 @@ TEST(sha256,  stateful_hasher) {
 	{ Sha256 h;  ap(h, "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq");              assert(h.getHash() == Sha256Hash("C106DB19D4EDECF66721FF6459E43CA339603E0C9326C0E5B83806D2616A8D24")); }
 	{ Sha256 h;  ap(h, "abcdbcdecdefde");  ap(h, "fgefghfghighijhijkijkljklmklmnlmnomnopnopq");  assert(h.getHash() == Sha256Hash("C106DB19D4EDECF66721FF6459E43CA339603E0C9326C0E5B83806D2616A8D24")); }
 }
+
+
+TEST(sha256, compress_implementations) {
+	// compress() may use SHA-NI, which must agree with the portable code on arbitrary states and blocks
+	std::uint32_t x = 1;
+	for (int trial = 0; trial < 1000; trial++) {
+		std::uint32_t state0[8], state1[8];
+		std::uint8_t block[Sha256::BLOCK_LEN];
+		for (int i = 0; i < 8; i++) {
+			x = x * UINT32_C(1664525) + UINT32_C(1013904223);
+			state0[i] = state1[i] = x;
+		}
+		for (int i = 0; i < Sha256::BLOCK_LEN; i++) {
+			x = x * UINT32_C(1664525) + UINT32_C(1013904223);
+			block[i] = static_cast<std::uint8_t>(x >> 24);
+		}
+		Sha256::compress(state0, block);
+		Sha256::compressPortable(state1, block);
+		assert(std::memcmp(state0, state1, sizeof(state0)) == 0);
+	}
+}
+
+
+TEST(sha256, get_hashes) {
+	forEachMixedBatch(40, 200, [](const std::uint8_t *const msgs[], const size_t lens[], size_t n) {
+		vector<Sha256Hash> hashes(n, Sha256::getHash(nullptr, 0));
+		Sha256::getHashes(msgs, lens, n, hashes.data());
+		for (size_t i = 0; i < n; i++)
+			assert(hashes[i] == Sha256::getHash(msgs[i], lens[i]));
+	});
+}
+
+
+TEST(sha256, get_hashes_in_lanes) {
+	// Each kernel that this CPU has, even where getHashes() prefers another one
+	for (size_t lanes : {16, 8}) {
+		forEachMixedBatch(40, 200, [lanes](const std::uint8_t *const msgs[], const size_t lens[], size_t n) {
+			vector<Sha256Hash> hashes(n, Sha256::getHash(nullptr, 0));
+			if (!Sha256::getHashesInLanes(msgs, lens, n, hashes.data(), lanes))
+				return;
+			for (size_t i = 0; i < n; i++)
+				assert(hashes[i] == Sha256::getHash(msgs[i], lens[i]));
+		});
+	}
+	const Bytes msg(10, 0);
+	const std::uint8_t *msgs[1] = {msg.data()};
+	const size_t lens[1] = {msg.size()};
+	Sha256Hash out[1] = {Sha256::getHash(nullptr, 0)};
+	assert(!Sha256::getHashesInLanes(msgs, lens, 1, out, 3));
+}
+
+
+TEST(sha256, chunked_append) {
+	// Appending in pieces of any size, which may or may not fill the buffer, must give the one-shot hash
+	std::vector<std::uint8_t> data(300);
+	for (size_t i = 0; i < data.size(); i++)
+		data[i] = static_cast<std::uint8_t>(i * 13 + 5);
+	const size_t chunkLens[] = {1, 3, 55, 63, 64, 65, 128, 200};
+	for (size_t len = 0; len <= data.size(); len++) {
+		const Sha256Hash expected = Sha256::getHash(data.data(), len);
+		for (size_t chunkLen : chunkLens) {
+			Sha256 hasher;
+			for (size_t i = 0; i < len; i += chunkLen)
+				hasher.append(&data[i], std::min(chunkLen, len - i));
+			assert(hasher.getHash() == expected);
+		}
+	}
+	
+	std::vector<std::uint8_t> million(1000000, 'a');
+	assert(Sha256::getHash(million.data(), million.size()) == Sha256Hash("D02C11C7CC396D040E2097A4489A80F1673ED784E2C7A18192FB14995C6EC7CD"));
+}
+
+
+TEST(sha256, fixed_length_hashes) {
+	std::vector<std::uint8_t> data(64 * 40);
+	for (size_t i = 0; i < data.size(); i++)
+		data[i] = static_cast<std::uint8_t>(i * 31 + 7);
+	for (size_t i = 0; i < 40; i++) {
+		const std::uint8_t *msg = &data[i * 64];
+		assert(Sha256::getHash32(msg) == Sha256::getHash(msg, 32));
+		assert(Sha256::getDoubleHash64(msg) == Sha256::getDoubleHash(msg, 64));
+	}
+	
+	// Batches of every size up to 40, with separate output and then in place
+	for (size_t n = 0; n <= 40; n++) {
+		std::vector<Sha256Hash> expected;
+		for (size_t i = 0; i < n; i++)
+			expected.push_back(Sha256::getDoubleHash(&data[i * 64], 64));
+		std::vector<Sha256Hash> actual(n, Sha256::getHash(nullptr, 0));
+		Sha256::getDoubleHashes64(data.data(), n, actual.data());
+		assert(actual == expected);
+		
+		std::vector<Sha256Hash> level;  // Consecutive hashes are the pairs of the next level
+		for (size_t i = 0; i < n * 2; i++)
+			level.push_back(Sha256Hash(&data[i * 32], Sha256Hash::HASH_LEN));
+		Sha256::getDoubleHashes64(level.empty() ? nullptr : level[0].value, n, level.data());
+		for (size_t i = 0; i < n; i++)
+			assert(level[i] == expected[i]);
+	}
+}
+
+
+TEST(sha256, midstate) {
+	std::vector<std::uint8_t> data(200);
+	for (size_t i = 0; i < data.size(); i++)
+		data[i] = static_cast<std::uint8_t>(i * 5 + 1);
+	for (size_t prefixLen : {0, 64, 128}) {
+		Sha256 hasher;
+		hasher.append(data.data(), prefixLen);
+		std::uint32_t midstate[8];
+		std::uint64_t length = 1;
+		assert(hasher.getMidstate(midstate, length));
+		assert(length == prefixLen);
+		
+		// Resuming from the midstate, or from a copy of the hasher, gives the same hash for any suffix
+		for (size_t suffixLen : {0, 1, 16, 64}) {
+			Sha256 resumed(midstate, length);
+			Sha256 copy = hasher;
+			resumed.append(&data[prefixLen], suffixLen);
+			copy.append(&data[prefixLen], suffixLen);
+			const Sha256Hash expected = Sha256::getHash(data.data(), prefixLen + suffixLen);
+			assert(resumed.getHash() == expected);
+			assert(copy.getHash() == expected);
+		}
+	}
+	
+	// Buffered bytes cannot be exported
+	Sha256 hasher;
+	hasher.append(data.data(), 65);
+	std::uint32_t midstate[8] = {};
+	std::uint64_t length = 7;
+	assert(!hasher.getMidstate(midstate, length));
+	assert(length == 7 && midstate[0] == 0);
+	
+	// The BIP 340 challenge tag prefix, whose midstate is a well-known constant
+	const char *tag = "BIP0340/challenge";
+	const Sha256Hash tagHash = Sha256::getHash(reinterpret_cast<const std::uint8_t *>(tag), std::strlen(tag));
+	hasher = Sha256();
+	hasher.append(tagHash.value, 32).append(tagHash.value, 32);
+	assert(hasher.getMidstate(midstate, length) && length == 64);
+	assert(midstate[0] == UINT32_C(0x9CECBA11) && midstate[7] == UINT32_C(0x33E9B66A));
+}
@@ -11,11 +11,14 @@
 #include "gtest/gtest.h"
 
 #include "TestHelper.hpp"
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <vector>
+#include "HmacSha512.hpp"
 #include "Sha512.hpp"
 
 
@@ -364,3 +367,156 @@ TEST(sha512, hmac) {
 		assert((std::memcmp(actualHash, expectHash.data(), Sha512::HASH_LEN) == 0) == tc.matches);
 	}
 }
+
+
+TEST(sha512, hmac_context) {
+	// One context must give the one-shot HMAC for every message and key length, including a message in pieces
+	std::vector<std::uint8_t> data(400);
+	for (size_t i = 0; i < data.size(); i++)
+		data[i] = static_cast<std::uint8_t>(i * 29 + 7);
+	for (size_t keyLen : {0, 1, 32, 128, 129, 200}) {
+		const HmacSha512 hmac(data.data(), keyLen);
+		for (size_t msgLen : {0, 1, 37, 111, 112, 128, 200}) {
+			std::uint8_t expected[Sha512::HASH_LEN];
+			Sha512::getHmac(data.data(), keyLen, &data[200], msgLen, expected);
+			std::uint8_t actual[Sha512::HASH_LEN];
+			hmac.getHmac(&data[200], msgLen, actual);
+			assert(std::memcmp(actual, expected, sizeof(expected)) == 0);
+			Sha512 hasher = hmac.getInnerHasher();
+			hasher.append(&data[200], msgLen / 3).append(&data[200 + msgLen / 3], msgLen - msgLen / 3);
+			hmac.finish(hasher, actual);
+			assert(std::memcmp(actual, expected, sizeof(expected)) == 0);
+		}
+	}
+}
+
+
+TEST(sha512, get_hashes_from_midstates) {
+	// From the initial state and from the midstate of a one-block prefix
+	const Bytes prefix(Sha512::BLOCK_LEN, 0x5C);
+	std::uint64_t midstates[2][8];
+	std::uint64_t prefixLens[2];
+	Sha512().getMidstate(midstates[0], prefixLens[0]);
+	Sha512().append(prefix.data(), prefix.size()).getMidstate(midstates[1], prefixLens[1]);
+	for (int m = 0; m < 2; m++) {
+		forEachMixedBatch(20, 300, [&](const std::uint8_t *const msgs[], const size_t lens[], size_t n) {
+			vector<const std::uint64_t *> mids(n, midstates[m]);
+			Bytes hashes(n * Sha512::HASH_LEN);
+			std::uint8_t (*out)[Sha512::HASH_LEN] = reinterpret_cast<std::uint8_t (*)[Sha512::HASH_LEN]>(hashes.data());
+			// The kernel that getHashesFromMidstates() chooses, then each kernel that this CPU has
+			for (size_t lanes : {0, 8, 4}) {
+				if (lanes == 0)
+					Sha512::getHashesFromMidstates(mids.data(), prefixLens[m], msgs, lens, n, out);
+				else if (!Sha512::getHashesFromMidstatesInLanes(mids.data(), prefixLens[m], msgs, lens, n, out, lanes))
+					continue;
+				for (size_t i = 0; i < n; i++) {
+					std::uint8_t expected[Sha512::HASH_LEN];
+					Sha512(midstates[m], prefixLens[m]).append(msgs[i], lens[i]).getHash(expected);
+					assert(std::memcmp(out[i], expected, sizeof(expected)) == 0);
+				}
+			}
+		});
+	}
+}
+
+
+TEST(sha512, hmacs) {
+	// Batched HMACs under a mix of repeated keys, in place
+	std::vector<std::uint8_t> data(300);
+	for (size_t i = 0; i < data.size(); i++)
+		data[i] = static_cast<std::uint8_t>(i * 29 + 7);
+	const HmacSha512 keyA(data.data(), 32);
+	const HmacSha512 keyB(&data[1], 200);
+	for (size_t n = 0; n <= 20; n++) {
+		std::vector<const HmacSha512 *> keys;
+		std::vector<std::uint8_t> msgData(n * Sha512::HASH_LEN);
+		std::uint8_t (*msgs)[Sha512::HASH_LEN] = reinterpret_cast<std::uint8_t (*)[Sha512::HASH_LEN]>(msgData.data());
+		std::vector<const std::uint8_t *> msgPtrs;
+		std::vector<size_t> lens;
+		for (size_t i = 0; i < n; i++) {
+			keys.push_back(i % 3 == 0 ? &keyB : &keyA);
+			std::memcpy(msgs[i], &data[i * 5], Sha512::HASH_LEN);
+			msgPtrs.push_back(msgs[i]);
+			lens.push_back(i % Sha512::HASH_LEN);
+		}
+		std::vector<std::uint8_t> expected(n * Sha512::HASH_LEN);
+		for (size_t i = 0; i < n; i++)
+			keys[i]->getHmac(msgs[i], lens[i], &expected[i * Sha512::HASH_LEN]);
+		HmacSha512::getHmacs(keys.data(), msgPtrs.data(), lens.data(), n, msgs);
+		assert(msgData == expected);
+	}
+}
+
+
+TEST(sha512, pbkdf2) {
+	struct Pbkdf2Case {
+		const char *password;
+		const char *salt;
+		std::uint32_t iterations;
+		const char *expected;
+	};
+	const array<Pbkdf2Case, 4> pbkdf2Cases{{
+		{"password", "salt", 1, "867F70CF1ADE02CFF3752599A3A53DC4AF34C7A669815AE5D513554E1C8CF252C02D470A285A0501BAD999BFE943C08F050235D7D68B1DA55E63F73B60A57FCE"},
+		{"password", "salt", 2, "E1D9C16AA681708A45F5C7C4E215CEB66E011A2E9F0040713F18AEFDB866D53CF76CAB2868A39B9F7840EDCE4FEF5A82BE67335C77A6068E04112754F27CCF4E"},
+		{"password", "salt", 4096, "D197B1B33DB0143E018B12F3D1D1479E6CDEBDCC97C5C0F87F6902E072F457B5143F30602641B3D55CD335988CB36B84376060ECD532E039B742A239434AF2D5"},
+		// BIP 39 seed of the mnemonic "abandon" x 11 + "about" with the passphrase "TREZOR"
+		{"abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about", "mnemonicTREZOR", 2048,
+			"C55257C360C07C72029AEBC1B53C05ED0362ADA38EAD3E3E9EFA3708E53495531F09A6987599D18264C1E1C92F2CF141630C7A3C4AB7C81B2F001698E7463B04"},
+	}};
+	for (const Pbkdf2Case &tc : pbkdf2Cases) {
+		Bytes password = asciiBytes(tc.password);
+		Bytes salt = asciiBytes(tc.salt);
+		std::uint8_t actual[Sha512::HASH_LEN];
+		HmacSha512::getPbkdf2(password.data(), password.size(), salt.data(), salt.size(), tc.iterations, actual);
+		assert(std::memcmp(actual, hexBytes(tc.expected).data(), Sha512::HASH_LEN) == 0);
+	}
+	
+	// A batch of different passwords must match the one-at-a-time results
+	const size_t n = 11;
+	std::vector<Bytes> passwords;
+	std::vector<const std::uint8_t *> passwordPtrs, saltPtrs;
+	std::vector<size_t> passwordLens, saltLens;
+	Bytes salt = asciiBytes("mnemonic");
+	for (size_t i = 0; i < n; i++)
+		passwords.push_back(Bytes(i * 17, static_cast<std::uint8_t>('a' + i)));
+	for (size_t i = 0; i < n; i++) {
+		passwordPtrs.push_back(passwords[i].data());
+		passwordLens.push_back(passwords[i].size());
+		saltPtrs.push_back(salt.data());
+		saltLens.push_back(salt.size());
+	}
+	std::uint8_t out[n][Sha512::HASH_LEN];
+	HmacSha512::getPbkdf2s(passwordPtrs.data(), passwordLens.data(), saltPtrs.data(), saltLens.data(), n, 100, out);
+	for (size_t i = 0; i < n; i++) {
+		std::uint8_t expected[Sha512::HASH_LEN];
+		HmacSha512::getPbkdf2(passwords[i].data(), passwords[i].size(), salt.data(), salt.size(), 100, expected);
+		assert(std::memcmp(out[i], expected, sizeof(expected)) == 0);
+	}
+}
+
+
+TEST(sha512, chunked_append) {
+	// Appending in pieces of any size, which may or may not fill the buffer, must give the one-shot hash
+	std::vector<std::uint8_t> data(400);
+	for (size_t i = 0; i < data.size(); i++)
+		data[i] = static_cast<std::uint8_t>(i * 13 + 5);
+	const size_t chunkLens[] = {1, 3, 111, 127, 128, 129, 256, 300};
+	for (size_t len = 0; len <= data.size(); len++) {
+		std::uint8_t expected[Sha512::HASH_LEN];
+		Sha512::getHash(data.data(), len, expected);
+		for (size_t chunkLen : chunkLens) {
+			Sha512 hasher;
+			for (size_t i = 0; i < len; i += chunkLen)
+				hasher.append(&data[i], std::min(chunkLen, len - i));
+			std::uint8_t actual[Sha512::HASH_LEN];
+			hasher.getHash(actual);
+			assert(std::memcmp(actual, expected, Sha512::HASH_LEN) == 0);
+		}
+	}
+	
+	std::vector<std::uint8_t> million(1000000, 'a');
+	std::uint8_t actual[Sha512::HASH_LEN];
+	Sha512::getHash(million.data(), million.size(), actual);
+	Bytes expected = hexBytes("E718483D0CE769644E2E42C7BC15B4638E1F98B13B2044285632A803AFA973EBDE0FF244877EA60A4CB0432CE577C31BEB009C5C2C49AA2E4EADB217AD8CC09B");
+	assert(std::memcmp(actual, expected.data(), Sha512::HASH_LEN) == 0);
+}
@@ -0,0 +1,105 @@
+/* 
+ * A runnable main program that tests the functionality of class SigCache.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "gtest/gtest.h"
+
+#include "TestHelper.hpp"
+#include <cstdint>
+#include "Sha256Hash.hpp"
+#include "SigCache.hpp"
+#include "Uint256.hpp"
+
+#if defined(BCL_USE_THREADS)
+	#include <thread>
+#endif
+
+
+using namespace bcl;
+using std::uint8_t;
+
+
+/*---- Helper definitions ----*/
+
+static const uint8_t SALT[32] = {0x5A, 0x17, 0xC3};
+
+
+/*---- Test cases ----*/
+
+TEST(sig_cache, verify) {
+	const vector<TestSignature> sigs = makeTestSignatures(3);
+	SigCache cache(100, SALT);
+	assert(cache.getCapacity() >= 100 && cache.getCapacity() % SigCache::BUCKET_LEN == 0);
+	
+	for (const TestSignature &t : sigs) {
+		assert(!cache.contains(t.publicKey, t.msgHash, t.r, t.s));
+		assert(cache.verify(t.publicKey, t.msgHash, t.r, t.s));
+		assert(cache.contains(t.publicKey, t.msgHash, t.r, t.s));
+		assert(cache.verify(t.publicKey, t.msgHash, t.r, t.s));
+	}
+	assert(cache.getHits() == 3 && cache.getMisses() == 3);
+	
+	// Invalid signatures are never cached
+	const TestSignature &t = sigs[0];
+	Uint256 badS = t.s;
+	badS.value[0] ^= 1;
+	for (int i = 0; i < 2; i++) {
+		assert(!cache.verify(t.publicKey, t.msgHash, t.r, badS));
+		assert(!cache.contains(t.publicKey, t.msgHash, t.r, badS));
+	}
+	assert(!cache.contains(sigs[1].publicKey, t.msgHash, t.r, t.s));
+	assert(cache.getHits() == 3 && cache.getMisses() == 5);
+	
+	// A different salt gives different keys
+	SigCache other(100, sigs[2].msgHash.value);
+	assert(!other.contains(t.publicKey, t.msgHash, t.r, t.s));
+	other.insert(t.publicKey, t.msgHash, t.r, t.s);
+	assert(other.contains(t.publicKey, t.msgHash, t.r, t.s));
+}
+
+
+TEST(sig_cache, eviction) {
+	// Twelve signatures into a cache with a single bucket
+	const vector<TestSignature> sigs = makeTestSignatures(12);
+	SigCache cache(0, SALT);
+	assert(cache.getCapacity() == SigCache::BUCKET_LEN);
+	for (const TestSignature &t : sigs) {
+		cache.insert(t.publicKey, t.msgHash, t.r, t.s);
+		assert(cache.contains(t.publicKey, t.msgHash, t.r, t.s));
+	}
+	size_t count = 0;
+	for (const TestSignature &t : sigs)
+		count += cache.contains(t.publicKey, t.msgHash, t.r, t.s);
+	assert(1 <= count && count <= SigCache::BUCKET_LEN);
+	for (const TestSignature &t : sigs)
+		assert(cache.verify(t.publicKey, t.msgHash, t.r, t.s));
+}
+
+
+#if defined(BCL_USE_THREADS)
+TEST(sig_cache, concurrent) {
+	const vector<TestSignature> sigs = makeTestSignatures(16);
+	SigCache cache(8, SALT);
+	vector<std::thread> threads;
+	for (size_t i = 0; i < 4; i++) {
+		threads.emplace_back([&sigs, &cache, i]() {
+			for (int round = 0; round < 3; round++) {
+				for (size_t j = 0; j < sigs.size(); j++) {
+					const TestSignature &t = sigs[(i * 5 + j) % sigs.size()];
+					assert(cache.verify(t.publicKey, t.msgHash, t.r, t.s));
+				}
+			}
+		});
+	}
+	for (std::thread &th : threads)
+		th.join();
+	assert(cache.getHits() + cache.getMisses() == 4 * 3 * sigs.size());
+}
+
+#endif
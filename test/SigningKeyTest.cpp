@@ -0,0 +1,62 @@
+/* 
+ * A runnable main program that tests the functionality of class SigningKey.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "gtest/gtest.h"
+
+#include "TestHelper.hpp"
+#include <cstdint>
+#include <cstring>
+#include "CurvePoint.hpp"
+#include "Ecdsa.hpp"
+#include "Sha256Hash.hpp"
+#include "SigningKey.hpp"
+#include "Uint256.hpp"
+
+
+using namespace bcl;
+using std::uint8_t;
+
+
+/*---- Test cases ----*/
+
+TEST(signing_key, matches_ecdsa) {
+	const vector<TestSignature> sigs = makeTestSignatures(8);
+	for (size_t i = 0; i < sigs.size(); i++) {
+		const Uint256 &privateKey = sigs[i].privateKey;
+		const Sha256Hash &msgHash = sigs[i].msgHash;
+		const SigningKey key(privateKey);
+		
+		const CurvePoint publicKey = CurvePoint::privateExponentToPublicPoint(privateKey);
+		assert(key.getPrivateKey() == privateKey);
+		assert(key.getPublicKey() == publicKey);
+		uint8_t compressed[33];
+		publicKey.toCompressedPoint(compressed);
+		assert(std::memcmp(key.getCompressedPublicKey(), compressed, sizeof(compressed)) == 0);
+		
+		Uint256 r0, s0, r1, s1;
+		uint8_t recId0, recId1;
+		assert(Ecdsa::signWithHmacNonce(privateKey, msgHash, r0, s0, recId0));
+		assert(key.signWithHmacNonce(msgHash, r1, s1, recId1));
+		assert(r0 == r1 && s0 == s1 && recId0 == recId1);
+		
+		const uint8_t extra[32] = {static_cast<uint8_t>(i)};
+		assert(Ecdsa::signWithRfc6979(privateKey, msgHash, extra, sizeof(extra), r0, s0, recId0));
+		assert(key.signWithRfc6979(msgHash, extra, sizeof(extra), r1, s1, recId1));
+		assert(r0 == r1 && s0 == s1 && recId0 == recId1);
+		
+		uint8_t sig0[65], sig1[65];
+		assert(Ecdsa::signRecoverable(privateKey, msgHash, sig0));
+		assert(key.signRecoverable(msgHash, sig1));
+		assert(std::memcmp(sig0, sig1, sizeof(sig0)) == 0);
+	}
+	assert(!SigningKey::isValid(Uint256::ZERO));
+	assert(!SigningKey::isValid(CurvePoint::ORDER));
+	assert(SigningKey::isValid(Uint256::ONE));
+}
@@ -18,6 +18,11 @@
 #include <cstdint>
 #include <cstring>
 #include <vector>
+#include "CurvePoint.hpp"
+#include "Ecdsa.hpp"
+#include "Sha256.hpp"
+#include "Sha256Hash.hpp"
+#include "Uint256.hpp"
 
 
 using std::size_t;
@@ -43,3 +48,50 @@ static inline Bytes hexBytes(const char *str) {
 	}
 	return result;
 }
+
+
+// Calls check(msgs, lens, n) for each batch size n from 0 to maxN. The messages point into one buffer and their lengths
+// are spread over [0, maxLen), so they fall around the block and padding boundaries, and the batches leave partial
+// groups of SIMD lanes in the multi-buffer hash functions (e.g. Sha256::getHashes()).
+template <typename Check>
+static void forEachMixedBatch(size_t maxN, size_t maxLen, Check check) {
+	Bytes data(maxN + maxLen);
+	for (size_t i = 0; i < data.size(); i++)
+		data[i] = static_cast<std::uint8_t>(i * 7 + 3);
+	for (size_t n = 0; n <= maxN; n++) {
+		vector<const std::uint8_t *> msgs;
+		vector<size_t> lens;
+		for (size_t i = 0; i < n; i++) {
+			msgs.push_back(&data[i]);
+			lens.push_back((i * 37 + n * 11) % maxLen);
+		}
+		check(msgs.data(), lens.data(), n);
+	}
+}
+
+// A private key and a valid ECDSA signature made with it.
+struct TestSignature {
+	bcl::Uint256 privateKey;
+	bcl::CurvePoint publicKey;
+	bcl::Sha256Hash msgHash;
+	bcl::Uint256 r;
+	bcl::Uint256 s;
+};
+
+
+// Returns len deterministic signatures. For each index i, the private key is SHA256({i, 0}) reduced
+// modulo the order, the message hash is SHA256({i}), and the signature comes from Ecdsa::signWithHmacNonce().
+static inline vector<TestSignature> makeTestSignatures(size_t len) {
+	vector<TestSignature> result;
+	for (size_t i = 0; i < len; i++) {
+		const std::uint8_t seed[2] = {static_cast<std::uint8_t>(i), 0};
+		bcl::Uint256 privateKey(bcl::Sha256::getHash(seed, sizeof(seed)).value);
+		if (privateKey >= bcl::CurvePoint::ORDER)
+			privateKey.subtract(bcl::CurvePoint::ORDER);
+		const bcl::Sha256Hash msgHash = bcl::Sha256::getHash(seed, 1);
+		bcl::Uint256 r, s;
+		assert(bcl::Ecdsa::signWithHmacNonce(privateKey, msgHash, r, s));
+		result.push_back(TestSignature{privateKey, bcl::CurvePoint::privateExponentToPublicPoint(privateKey), msgHash, r, s});
+	}
+	return result;
+}
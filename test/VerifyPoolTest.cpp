@@ -0,0 +1,60 @@
+/* 
+ * A runnable main program that tests the functionality of class VerifyPool.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#if defined(BCL_USE_THREADS)
+
+#include "gtest/gtest.h"
+
+#include "TestHelper.hpp"
+#include <cstdint>
+#include "Sha256Hash.hpp"
+#include "Uint256.hpp"
+#include "VerifyPool.hpp"
+
+
+using namespace bcl;
+using std::uint8_t;
+
+
+/*---- Test cases ----*/
+
+TEST(verify_pool, verify) {
+	// Every third signature is made invalid
+	const size_t LEN = 40;
+	vector<VerifyPool::Job> jobs;
+	for (const TestSignature &sig : makeTestSignatures(LEN)) {
+		Uint256 s = sig.s;
+		if (jobs.size() % 3 == 2)
+			s.value[0] ^= 1;
+		jobs.push_back(VerifyPool::Job{sig.publicKey, sig.msgHash, sig.r, s});
+	}
+	
+	for (size_t threads : {1, 2, 3, 8, 64}) {
+		VerifyPool pool(threads);
+		assert(pool.getNumThreads() == threads);
+		// Several batches on the same pool, including ones with fewer jobs than threads
+		for (size_t len : {LEN, static_cast<size_t>(5), static_cast<size_t>(0), static_cast<size_t>(2)}) {
+			bool results[LEN];
+			bool allValid = true;
+			for (size_t i = 0; i < len; i++) {
+				results[i] = i % 3 == 2;  // Opposite of the answer
+				allValid = allValid && i % 3 != 2;
+			}
+			assert(pool.verify(jobs.data(), results, len) == allValid);
+			for (size_t i = 0; i < len; i++)
+				assert(results[i] == (i % 3 != 2));
+		}
+	}
+	VerifyPool pool;
+	assert(pool.getNumThreads() >= 1);
+	assert(pool.verify(nullptr, nullptr, 0));
+}
+
+#endif  // BCL_USE_THREADS